@@ -1,6 +1,11 @@
 /*
     This is a C language source file
     When compiling we g++, we should wrap it with extern "C" to avoid name mangling
+
+    Every kernel is compiled once per instruction set level (simd_kernels.inc),
+    the level is picked at first use from cpuid (x86: SSE2 / AVX2 / AVX-512),
+    SIMD_MAX_ISA (environment variable) caps it, i.e. SIMD_MAX_ISA=avx2.
+    Build WITHOUT -march=native, the baseline level should run everywhere.
 */
 
 // include .h header
@@ -8,33 +13,42 @@
 
 // include library headers
 #include <stddef.h> // size_t
+#include <stdlib.h> // getenv(); malloc(); free()
+#include <string.h> // strcmp()
 
-// Automatically determine the maximum hardware-supported vector size
-#if defined(__AVX2__) || defined(__AVX512F__)
-    #define VECTOR_BYTES 32  // Modern Intel/AMD (AVX2 uses 256 bits)
-#elif defined(__ARM_NEON) || defined(__SSE2__)
-    #define VECTOR_BYTES 16  // ARM (Apple Silicon/Pi) or older Intel (SSE)
-#else
-    #define VECTOR_BYTES 16  // Safe fallback size
+// x86: intrinsics (streaming stores) and cpuid
+#if defined(__x86_64__) || defined(__i386__)
+    #define SIMD_X86
+    #include <immintrin.h>
+    #include <cpuid.h>
 #endif
 
-// typedef for SIMD vector types [effective only in this compilation unit]
-// we also include the unaligned versions
-// vector for ANY type (used for copying) - we use unsigned char
-typedef unsigned char vany __attribute__((vector_size(VECTOR_BYTES)));
-typedef unsigned char vany_unaligned __attribute__((vector_size(VECTOR_BYTES), aligned(1)));
-// vector for integers
-typedef int vi __attribute__((vector_size(VECTOR_BYTES)));
-typedef int vi_unaligned __attribute__((vector_size(VECTOR_BYTES), aligned(1)));
-// vector for unsigned integers
-typedef unsigned int vu __attribute__((vector_size(VECTOR_BYTES)));
-typedef unsigned int vu_unaligned __attribute__((vector_size(VECTOR_BYTES), aligned(1)));
-// vector for floats
-typedef float vf __attribute__((vector_size(VECTOR_BYTES)));
-typedef float vf_unaligned __attribute__((vector_size(VECTOR_BYTES), aligned(1)));
-// vector for doubles
-typedef double vd __attribute__((vector_size(VECTOR_BYTES)));
-typedef double vd_unaligned __attribute__((vector_size(VECTOR_BYTES), aligned(1)));
+// fixed 4-lane vectors for the transpose tiles (independent of VECTOR_BYTES)
+// the transpose only moves data, so we only care about the element width
+// (items are reinterpreted, so the memory access types may alias)
+// 32-bit items (float and int)
+typedef unsigned int u32_alias __attribute__((__may_alias__));
+typedef unsigned int v4u32 __attribute__((vector_size(16)));
+typedef unsigned int v4u32_unaligned __attribute__((vector_size(16), aligned(1), __may_alias__));
+// 64-bit items (double)
+typedef unsigned long long u64_alias __attribute__((__may_alias__));
+typedef unsigned long long v4u64 __attribute__((vector_size(32)));
+typedef unsigned long long v4u64_unaligned __attribute__((vector_size(32), aligned(1), __may_alias__));
+
+// fixed 8-lane vectors for the type conversions (independent of VECTOR_BYTES)
+// conversions change the element width, so we fix the lane count instead
+// (the compiler splits them into hardware vectors)
+// NOTE: they never cross a function boundary by value (kernels take
+//       pointers), wide vector arguments depend on the enabled ISA
+typedef float v8f __attribute__((vector_size(32)));
+typedef float v8f_unaligned __attribute__((vector_size(32), aligned(1)));
+typedef int v8i __attribute__((vector_size(32)));
+typedef int v8i_unaligned __attribute__((vector_size(32), aligned(1)));
+typedef double v8d __attribute__((vector_size(64)));
+typedef double v8d_unaligned __attribute__((vector_size(64), aligned(1)));
+typedef long long v8l __attribute__((vector_size(64)));
+typedef signed char v8c __attribute__((vector_size(8)));
+typedef signed char v8c_unaligned __attribute__((vector_size(8), aligned(1)));
 
 // define a struct for memory alignment
 typedef struct simd_memory_alignment_info
@@ -51,318 +65,1682 @@ typedef struct simd_memory_alignment_info
 } simd_memory_alignment_info;
 
 /**
- * @brief [STATIC] internal helper to calculate memory alignment
- * @param start Pointer to the start of the memory block
- * @param end Pointer to the end of the memory block
- * @note end should also points to a valid memory address (not one past the end)
- *       i.e. length = end - start + 1
- * @return simd_memory_alignment_info Struct containing alignment information
+ * @brief [STATIC inline] internal helper to determine if two ranges overlap
+ * @param ptr_1 Pointer to the first range
+ * @param ptr_2 Pointer to the second range
+ * @param length Length of both ranges (in bytes)
+ * @return int 1 if the ranges share at least one byte, 0 otherwise
  */
-static simd_memory_alignment_info
-calculate_memory_alignment(const void *start, const void *end)
+static inline int
+ranges_overlap(const void *ptr_1, const void *ptr_2, size_t length)
 {
-    // Calculate the total length of the memory block
-    size_t total_length = (const unsigned char *)end - (const unsigned char *)start + 1;
+    const unsigned char *p1 = (const unsigned char *)ptr_1;
+    const unsigned char *p2 = (const unsigned char *)ptr_2;
+    return (p1 < p2 + length && p2 < p1 + length) ? 1 : 0;
+}
 
-    // Calculate the starting offset for alignment
-    // as VECTOR_BYTES is always a power of 2 we use bitwise AND to get the remainder
-    size_t start_offset = ((size_t)start) & (VECTOR_BYTES - 1);
-    if (start_offset)
-        // Adjust to the next aligned address
-        start_offset = VECTOR_BYTES - start_offset;
-    
-    // Calculate the ending offset for alignment
-    // Calculate the number of bytes that can be processed using SIMD
-    size_t end_offset = 0;
-    size_t aligned_bytes = 0;
-    if (total_length >= start_offset)
-    {
-        // get remaining length after the start offset
-        size_t remaining_length = total_length - start_offset;
-        // calculate the number of bytes that can be processed using SIMD
-        aligned_bytes = remaining_length & ~(VECTOR_BYTES - 1);
-        // calculate the ending offset for alignment
-        end_offset = remaining_length - aligned_bytes;
-    }
-    else
-        // we set start_offset to total_length (we will not have any aligned bytes)
-        start_offset = total_length;
 
-    // Return the alignment information
-    return (simd_memory_alignment_info)
-           { .start_offset = start_offset,
-             .end_offset = end_offset,
-             .aligned_bytes = aligned_bytes };
+/**
+ * @brief [STATIC] internal macro to define a cache-blocked transpose
+ * @param NAME name of the function to define
+ * @param ITEM_T item type (aliasing unsigned type with the width of the element)
+ * @param TILE_FN 4x4 tile function for ITEM_T
+ * @note Expanded per level (simd_kernels.inc), SIMD_TARGET is the level's target
+ * @note Transposes one rows x cols matrix (source row length ld_s, destination
+ *       row length ld_d), so a block of rows of a larger matrix works too.
+ *       Each block is SIMD_TRANSPOSE_BLOCK x SIMD_TRANSPOSE_BLOCK items,
+ *       inside a block we go through 4x4 tiles and fix up the ragged
+ *       edges (rows / cols not divisible by 4) with scalar copies
+ */
+#define DEFINE_BLOCKED_TRANSPOSE(NAME, ITEM_T, TILE_FN)                                 \
+static SIMD_TARGET void                                                                 \
+NAME(ITEM_T *d, size_t ld_d, const ITEM_T *s, size_t ld_s, size_t rows, size_t cols)    \
+{                                                                                       \
+    for (size_t rb = 0; rb < rows; rb += SIMD_TRANSPOSE_BLOCK)                          \
+    {                                                                                   \
+        const size_t re = (rb + SIMD_TRANSPOSE_BLOCK < rows) ?                          \
+                          rb + SIMD_TRANSPOSE_BLOCK : rows;                             \
+        for (size_t cb = 0; cb < cols; cb += SIMD_TRANSPOSE_BLOCK)                      \
+        {                                                                               \
+            const size_t ce = (cb + SIMD_TRANSPOSE_BLOCK < cols) ?                      \
+                              cb + SIMD_TRANSPOSE_BLOCK : cols;                         \
+            size_t r = rb;                                                              \
+            /* full groups of 4 rows */                                                 \
+            for (; r + 4 <= re; r += 4)                                                 \
+            {                                                                           \
+                size_t c = cb;                                                          \
+                for (; c + 4 <= ce; c += 4)                                             \
+                    TILE_FN(d + c * ld_d + r, ld_d, s + r * ld_s + c, ld_s);            \
+                /* remaining columns */                                                 \
+                for (; c < ce; ++c)                                                     \
+                    for (size_t k = 0; k < 4; ++k)                                      \
+                        d[c * ld_d + r + k] = s[(r + k) * ld_s + c];                    \
+            }                                                                           \
+            /* remaining rows */                                                        \
+            for (; r < re; ++r)                                                         \
+                for (size_t c = cb; c < ce; ++c)                                        \
+                    d[c * ld_d + r] = s[r * ld_s + c];                                  \
+        }                                                                               \
+    }                                                                                   \
+    return;                                                                             \
 }
 
 /**
- * @brief [STATIC inline] internal helper to determine if alignment of two addresses are the same
- * @param ptr_1 Pointer to the first address
- * @param ptr_2 Pointer to the second address
- * @return int 1 if both addresses are aligned to the same boundary, 0 otherwise
+ * @brief [STATIC] internal macro to select lanes
+ * @param A lanes to keep where MASK is 0
+ * @param B lanes to take where MASK is set (all bits)
+ * @param MASK result of a vector comparison (cast to MASK_V)
+ * @param V vector type of A and B
+ * @param MASK_V integer vector type with the same lane width
  */
-static inline int
-addresses_aligned(const void *ptr_1, const void *ptr_2)
+#define SIMD_BLEND(A, B, MASK, V, MASK_V) \
+    ((V)(((MASK_V)(A) & ~(MASK)) | ((MASK_V)(B) & (MASK))))
+
+/**
+ * @brief [STATIC] internal macro to round to nearest (ties to even) in place
+ * @param X vector to round
+ * @param V vector type (float or double lanes)
+ * @param MASK_V integer vector type with the same lane width
+ * @param MAGIC 2^23 (float) or 2^52 (double)
+ * @param SIGN_BIT the sign bit of a lane
+ * @note Adding and removing MAGIC drops the fraction bits using the
+ *       current (default: nearest) rounding mode. Larger values (and
+ *       NaN / infinity) are already integers and kept as they are.
+ */
+#define SIMD_ROUND(X, V, MASK_V, MAGIC, SIGN_BIT)                                       \
+    do                                                                                  \
+    {                                                                                   \
+        const MASK_V bits_ = (MASK_V)(X);                                               \
+        const V abs_ = (V)(bits_ & ~(SIGN_BIT));                                        \
+        V r_ = (abs_ + (MAGIC)) - (MAGIC);                                              \
+        /* restore the sign (keeps -0.0) */                                             \
+        r_ = (V)((MASK_V)r_ | (bits_ & (SIGN_BIT)));                                    \
+        (X) = SIMD_BLEND((X), r_, (MASK_V)(abs_ < (MAGIC)), V, MASK_V);                 \
+    } while (0)
+
+// sign bits of 32-bit and 64-bit lanes
+#define SIMD_SIGN_32 (-2147483647 - 1)
+#define SIMD_SIGN_64 (-9223372036854775807LL - 1)
+
+/**
+ * @brief [STATIC] internal macro to define a conversion loop
+ * @param NAME name of the function to define
+ * @param DST_T destination item type
+ * @param SRC_T source item type
+ * @param KERNEL 8-item conversion kernel
+ * @note The remainder items go through the same kernel (zero padded),
+ *       so every item is converted the same way.
+ */
+#define DEFINE_CONVERSION(NAME, DST_T, SRC_T, KERNEL)                                   \
+static SIMD_TARGET void                                                                 \
+NAME(DST_T *dest, const SRC_T *src, size_t length, int mode)                            \
+{                                                                                       \
+    size_t i = 0;                                                                       \
+    for (; i + 8 <= length; i += 8)                                                     \
+        KERNEL(dest + i, src + i, mode);                                                \
+    /* remaining items */                                                               \
+    if (i < length)                                                                     \
+    {                                                                                   \
+        SRC_T s[8] = {0};                                                               \
+        DST_T d[8];                                                                     \
+        for (size_t k = 0; k < length - i; ++k)                                         \
+            s[k] = src[i + k];                                                          \
+        KERNEL(d, s, mode);                                                             \
+        for (size_t k = 0; k < length - i; ++k)                                         \
+            dest[i + k] = d[k];                                                         \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+// item operations of the element-wise kernels (int add / sub / mul go
+// through unsigned, they wrap around like the vector lanes do)
+#define SIMD_S_ADD(x, y) ((x) + (y))
+#define SIMD_S_SUB(x, y) ((x) - (y))
+#define SIMD_S_MUL(x, y) ((x) * (y))
+#define SIMD_S_MUL_ADD(x, y, z) ((x) * (y) + (z))
+#define SIMD_S_ADD_WRAP(x, y) ((int)((unsigned int)(x) + (unsigned int)(y)))
+#define SIMD_S_SUB_WRAP(x, y) ((int)((unsigned int)(x) - (unsigned int)(y)))
+#define SIMD_S_MUL_WRAP(x, y) ((int)((unsigned int)(x) * (unsigned int)(y)))
+#define SIMD_S_MUL_ADD_WRAP(x, y, z) ((int)((unsigned int)(x) * (unsigned int)(y) + (unsigned int)(z)))
+
+/**
+ * @brief [STATIC] internal macro for one element-wise loop (see DEFINE_BINARY)
+ * @param T item type
+ * @param V vector type (VU: unaligned version)
+ * @param VEXPR vector expression of x and y
+ * @param SEXPR item expression of x and y (remainder items)
+ * @note a or b may be a single value (scalars flags), it is splat once
+ *       and the loop only loads the other operand
+ */
+#define SIMD_BINARY_LOOP(T, V, VU, VEXPR, SEXPR)                                        \
+    do                                                                                  \
+    {                                                                                   \
+        const size_t lanes_ = sizeof(V) / sizeof(T);                                    \
+        size_t i_ = 0;                                                                  \
+        switch (scalars & (SIMD_SCALAR_A | SIMD_SCALAR_B))                              \
+        {                                                                               \
+        case SIMD_SCALAR_NONE:                                                          \
+            for (; i_ + lanes_ <= length; i_ += lanes_)                                 \
+            {                                                                           \
+                const V x = *(const VU *)(a + i_);                                      \
+                const V y = *(const VU *)(b + i_);                                      \
+                *(VU *)(dest + i_) = (VEXPR);                                           \
+            }                                                                           \
+            break;                                                                      \
+        case SIMD_SCALAR_A:                                                             \
+        {                                                                               \
+            const V x = (V){0} + a[0];                                                  \
+            for (; i_ + lanes_ <= length; i_ += lanes_)                                 \
+            {                                                                           \
+                const V y = *(const VU *)(b + i_);                                      \
+                *(VU *)(dest + i_) = (VEXPR);                                           \
+            }                                                                           \
+            break;                                                                      \
+        }                                                                               \
+        case SIMD_SCALAR_B:                                                             \
+        {                                                                               \
+            const V y = (V){0} + b[0];                                                  \
+            for (; i_ + lanes_ <= length; i_ += lanes_)                                 \
+            {                                                                           \
+                const V x = *(const VU *)(a + i_);                                      \
+                *(VU *)(dest + i_) = (VEXPR);                                           \
+            }                                                                           \
+            break;                                                                      \
+        }                                                                               \
+        default:                                                                        \
+        {                                                                               \
+            /* both single values, one result */                                        \
+            const T x = a[0];                                                           \
+            const T y = b[0];                                                           \
+            const T r_ = (SEXPR);                                                       \
+            for (; i_ < length; ++i_)                                                   \
+                dest[i_] = r_;                                                          \
+            break;                                                                      \
+        }                                                                               \
+        }                                                                               \
+        /* remaining items */                                                           \
+        for (; i_ < length; ++i_)                                                       \
+        {                                                                               \
+            const T x = (scalars & SIMD_SCALAR_A) ? a[0] : a[i_];                       \
+            const T y = (scalars & SIMD_SCALAR_B) ? b[0] : b[i_];                       \
+            dest[i_] = (SEXPR);                                                         \
+        }                                                                               \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro to define an element-wise binary kernel
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param MASK_V integer vector type with the same lane width
+ * @param S_ADD, S_SUB, S_MUL item add / sub / mul
+ * @note op is a simd_binary_op, scalars are simd_scalar_operand flags
+ * @note dest may be a or b (in-place), other overlaps are not allowed
+ */
+#define DEFINE_BINARY(NAME, T, V, VU, MASK_V, S_ADD, S_SUB, S_MUL)                      \
+static SIMD_TARGET void                                                                 \
+NAME(T *dest, const T *a, const T *b, size_t length, int op, int scalars)               \
+{                                                                                       \
+    switch (op)                                                                         \
+    {                                                                                   \
+    case SIMD_OP_ADD:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, x + y, S_ADD(x, y));                                 \
+        break;                                                                          \
+    case SIMD_OP_SUB:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, x - y, S_SUB(x, y));                                 \
+        break;                                                                          \
+    case SIMD_OP_MUL:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, x * y, S_MUL(x, y));                                 \
+        break;                                                                          \
+    case SIMD_OP_DIV:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, x / y, x / y);                                       \
+        break;                                                                          \
+    case SIMD_OP_MIN:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, SIMD_BLEND(x, y, (MASK_V)(y < x), V, MASK_V),        \
+                         (y < x) ? y : x);                                              \
+        break;                                                                          \
+    case SIMD_OP_MAX:                                                                   \
+        SIMD_BINARY_LOOP(T, V, VU, SIMD_BLEND(x, y, (MASK_V)(y > x), V, MASK_V),        \
+                         (y > x) ? y : x);                                              \
+        break;                                                                          \
+    default:                                                                            \
+        break;                                                                          \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+/**
+ * @brief [STATIC] internal macro to define an element-wise multiply-add
+ *        kernel (dest = a * b + c)
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param V_FMA vector multiply-add of the level
+ * @param S_FMA item multiply-add matching V_FMA (same rounding)
+ * @note Any operand may be a single value (scalars flags)
+ * @note dest may be a, b or c (in-place), other overlaps are not allowed
+ */
+#define DEFINE_FMA(NAME, T, V, VU, V_FMA, S_FMA)                                        \
+static SIMD_TARGET void                                                                 \
+NAME(T *dest, const T *a, const T *b, const T *c, size_t length, int scalars)           \
+{                                                                                       \
+    const size_t lanes = sizeof(V) / sizeof(T);                                         \
+    const size_t step_a = (scalars & SIMD_SCALAR_A) ? 0 : 1;                            \
+    const size_t step_b = (scalars & SIMD_SCALAR_B) ? 0 : 1;                            \
+    const size_t step_c = (scalars & SIMD_SCALAR_C) ? 0 : 1;                            \
+    size_t i = 0;                                                                       \
+    if (step_a && step_b && step_c)                                                     \
+        for (; i + lanes <= length; i += lanes)                                         \
+            *(VU *)(dest + i) = V_FMA((V)*(const VU *)(a + i), (V)*(const VU *)(b + i), \
+                                      (V)*(const VU *)(c + i));                         \
+    else                                                                                \
+    {                                                                                   \
+        /* single values are splat once */                                              \
+        const V sa = (V){0} + a[0];                                                     \
+        const V sb = (V){0} + b[0];                                                     \
+        const V sc = (V){0} + c[0];                                                     \
+        for (; i + lanes <= length; i += lanes)                                         \
+        {                                                                               \
+            const V x = step_a ? (V)*(const VU *)(a + i) : sa;                          \
+            const V y = step_b ? (V)*(const VU *)(b + i) : sb;                          \
+            const V z = step_c ? (V)*(const VU *)(c + i) : sc;                          \
+            *(VU *)(dest + i) = V_FMA(x, y, z);                                         \
+        }                                                                               \
+    }                                                                                   \
+    /* remaining items */                                                               \
+    for (; i < length; ++i)                                                             \
+        dest[i] = S_FMA(a[i * step_a], b[i * step_b], c[i * step_c]);                   \
+    return;                                                                             \
+}
+
+// items of a leaf of the pairwise summation tree (a multiple of every lane count)
+#define SIMD_REDUCE_BLOCK 256
+// rows of a leaf of the row-wise pairwise summation (simd_reduce_rows_*())
+#define SIMD_REDUCE_ROWS_BLOCK 64
+// columns of a tile of the row-wise reductions (in bytes, a multiple of VECTOR_BYTES)
+#define SIMD_REDUCE_ROWS_TILE 256
+// levels of the row-wise pairwise summation (up to 2^48 leaves)
+#define SIMD_REDUCE_ROWS_LEVELS 48
+
+/**
+ * @brief [STATIC] internal macro for one item of a reduction
+ * @param ACC accumulator (updated)
+ * @param X item (sum: ACC += X, sum of squares: ACC += X * X,
+ *        max / min: the greater / smaller one)
+ */
+#define SIMD_REDUCE_ITEM(ACC, X, op)                                                    \
+    do                                                                                  \
+    {                                                                                   \
+        switch (op)                                                                     \
+        {                                                                               \
+        case SIMD_REDUCE_SUM: (ACC) += (X); break;                                      \
+        case SIMD_REDUCE_SUM_SQUARES: (ACC) += (X) * (X); break;                        \
+        case SIMD_REDUCE_MAX: if ((X) > (ACC)) (ACC) = (X); break;                      \
+        default: if ((X) < (ACC)) (ACC) = (X); break;                                   \
+        }                                                                               \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro to define a reduction of contiguous items
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param MASK_V integer vector type with the same lane width
+ * @param ACC_T accumulator type of sums (unsigned for int: wraps around)
+ * @param ACC_V vector of ACC_T (same lane count as V)
+ * @note Sums are pairwise: halves (at multiples of SIMD_REDUCE_BLOCK) down
+ *       to leaves, each leaf is summed in 4 vector accumulators. The tree
+ *       only depends on the length, so is the result (for one level).
+ */
+#define DEFINE_REDUCE(NAME, T, V, VU, MASK_V, ACC_T, ACC_V)                             \
+static SIMD_TARGET T                                                                    \
+NAME(const T *src, size_t length, int op)                                               \
+{                                                                                       \
+    const size_t lanes = sizeof(V) / sizeof(T);                                         \
+    size_t i = 0;                                                                       \
+    if (length == 0)                                                                    \
+        return (T)0;                                                                    \
+    /* max / min: one pass, order does not matter */                                    \
+    if (op == SIMD_REDUCE_MAX || op == SIMD_REDUCE_MIN)                                 \
+    {                                                                                   \
+        T best = src[0];                                                                \
+        if (length >= lanes)                                                            \
+        {                                                                               \
+            V vbest = *(const VU *)src;                                                 \
+            for (i = lanes; i + lanes <= length; i += lanes)                            \
+            {                                                                           \
+                const V v = *(const VU *)(src + i);                                     \
+                const MASK_V take = (op == SIMD_REDUCE_MAX) ? (MASK_V)(v > vbest)       \
+                                                            : (MASK_V)(v < vbest);      \
+                vbest = SIMD_BLEND(vbest, v, take, V, MASK_V);                          \
+            }                                                                           \
+            best = vbest[0];                                                            \
+            for (size_t l = 1; l < lanes; ++l)                                          \
+                SIMD_REDUCE_ITEM(best, vbest[l], op);                                   \
+        }                                                                               \
+        else                                                                            \
+            i = 1;                                                                      \
+        for (; i < length; ++i)                                                         \
+            SIMD_REDUCE_ITEM(best, src[i], op);                                         \
+        return best;                                                                    \
+    }                                                                                   \
+    /* sums: split in two halves, a whole number of leaves on the left */              \
+    if (length > SIMD_REDUCE_BLOCK)                                                     \
+    {                                                                                   \
+        const size_t half = ((length / SIMD_REDUCE_BLOCK + 1) / 2) * SIMD_REDUCE_BLOCK; \
+        const ACC_T left = (ACC_T)NAME(src, half, op);                                  \
+        const ACC_T right = (ACC_T)NAME(src + half, length - half, op);                 \
+        return (T)(left + right);                                                       \
+    }                                                                                   \
+    /* leaf */                                                                          \
+    ACC_V acc0 = {0}, acc1 = {0}, acc2 = {0}, acc3 = {0};                               \
+    for (; i + 4 * lanes <= length; i += 4 * lanes)                                     \
+    {                                                                                   \
+        const ACC_V x0 = (ACC_V)(V)*(const VU *)(src + i);                              \
+        const ACC_V x1 = (ACC_V)(V)*(const VU *)(src + i + lanes);                      \
+        const ACC_V x2 = (ACC_V)(V)*(const VU *)(src + i + 2 * lanes);                  \
+        const ACC_V x3 = (ACC_V)(V)*(const VU *)(src + i + 3 * lanes);                  \
+        if (op == SIMD_REDUCE_SUM)                                                      \
+        {                                                                               \
+            acc0 += x0; acc1 += x1; acc2 += x2; acc3 += x3;                             \
+        }                                                                               \
+        else                                                                            \
+        {                                                                               \
+            acc0 += x0 * x0; acc1 += x1 * x1; acc2 += x2 * x2; acc3 += x3 * x3;         \
+        }                                                                               \
+    }                                                                                   \
+    for (; i + lanes <= length; i += lanes)                                             \
+    {                                                                                   \
+        const ACC_V x = (ACC_V)(V)*(const VU *)(src + i);                               \
+        acc0 += (op == SIMD_REDUCE_SUM) ? x : x * x;                                    \
+    }                                                                                   \
+    acc0 = (acc0 + acc1) + (acc2 + acc3);                                               \
+    ACC_T total = 0;                                                                    \
+    for (size_t l = 0; l < lanes; ++l)                                                  \
+        total += acc0[l];                                                               \
+    for (; i < length; ++i)                                                             \
+        SIMD_REDUCE_ITEM(total, (ACC_T)src[i], op);                                     \
+    return (T)total;                                                                    \
+}
+
+/**
+ * @brief [STATIC] internal macro to define an arg-max / arg-min of contiguous items
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param MASK_V integer vector type with the same lane width (holds indexes)
+ * @note Returns the index of the first greatest (SIMD_REDUCE_MAX) or smallest
+ *       (SIMD_REDUCE_MIN) item. Lane indexes are MASK_V items, the caller keeps
+ *       length below 2^31 (see simd_argreduce_float()).
+ */
+#define DEFINE_ARGREDUCE(NAME, T, V, VU, MASK_V)                                        \
+static SIMD_TARGET size_t                                                               \
+NAME(const T *src, size_t length, int op)                                               \
+{                                                                                       \
+    const size_t lanes = sizeof(V) / sizeof(T);                                         \
+    const int greater = (op == SIMD_REDUCE_MAX);                                        \
+    T best = src[0];                                                                    \
+    size_t best_index = 0;                                                              \
+    size_t i = 1;                                                                       \
+    if (length >= lanes)                                                                \
+    {                                                                                   \
+        /* every lane starts at item 0, keeps its first best */                         \
+        V vbest = (V){0} + src[0];                                                      \
+        MASK_V vindex = {0};                                                            \
+        MASK_V current;                                                                 \
+        for (size_t l = 0; l < lanes; ++l)                                              \
+            current[l] = l;                                                             \
+        const MASK_V step = (MASK_V){0} + (int)lanes;                                   \
+        for (i = 0; i + lanes <= length; i += lanes, current += step)                   \
+        {                                                                               \
+            const V v = *(const VU *)(src + i);                                         \
+            const MASK_V take = greater ? (MASK_V)(v > vbest) : (MASK_V)(v < vbest);    \
+            vbest = SIMD_BLEND(vbest, v, take, V, MASK_V);                              \
+            vindex = SIMD_BLEND(vindex, current, take, MASK_V, MASK_V);                 \
+        }                                                                               \
+        /* best lane, ties go to the first index */                                     \
+        for (size_t l = 0; l < lanes; ++l)                                              \
+        {                                                                               \
+            const size_t index = (size_t)vindex[l];                                     \
+            if ((greater ? (vbest[l] > best) : (vbest[l] < best)) ||                    \
+                (vbest[l] == best && index < best_index))                               \
+            {                                                                           \
+                best = vbest[l];                                                        \
+                best_index = index;                                                     \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+    /* remaining items (all after the vector part) */                                   \
+    for (; i < length; ++i)                                                             \
+        if (greater ? (src[i] > best) : (src[i] < best))                                \
+        {                                                                               \
+            best = src[i];                                                              \
+            best_index = i;                                                             \
+        }                                                                               \
+    return best_index;                                                                  \
+}
+
+/**
+ * @brief [STATIC] internal macro to define a row-wise reduction
+ *        (dest[j] = reduction of src[i * row_stride + j] over the rows i)
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param MASK_V integer vector type with the same lane width
+ * @param ACC_T accumulator type of sums (unsigned for int: wraps around)
+ * @param ACC_V vector of ACC_T (ACC_VU: unaligned version)
+ * @note Columns are walked in tiles of SIMD_REDUCE_ROWS_TILE bytes, every
+ *       row of a tile is one contiguous vector pass (cache friendly).
+ *       Sums are pairwise: leaves of SIMD_REDUCE_ROWS_BLOCK rows are merged
+ *       like a binary counter, the tree only depends on rows.
+ */
+#define DEFINE_REDUCE_ROWS(NAME, T, V, VU, MASK_V, ACC_T, ACC_V, ACC_VU)                \
+static SIMD_TARGET void                                                                 \
+NAME(T *dest, const T *src, size_t rows, size_t cols, size_t row_stride,                \
+     int op, int accumulate)                                                            \
+{                                                                                       \
+    const size_t lanes = sizeof(V) / sizeof(T);                                         \
+    enum { tile = SIMD_REDUCE_ROWS_TILE / sizeof(T) };                                  \
+    if (rows == 0)                                                                      \
+        return;                                                                         \
+    for (size_t c0 = 0; c0 < cols; c0 += tile)                                          \
+    {                                                                                   \
+        const size_t width = (cols - c0 < tile) ? cols - c0 : tile;                     \
+        const T *base = src + c0;                                                       \
+        T *out = dest + c0;                                                             \
+        size_t j;                                                                       \
+        /* max / min: running best of the tile */                                       \
+        if (op == SIMD_REDUCE_MAX || op == SIMD_REDUCE_MIN)                             \
+        {                                                                               \
+            T best[tile];                                                               \
+            for (j = 0; j < width; ++j)                                                 \
+                best[j] = base[j];                                                      \
+            for (size_t r = 1; r < rows; ++r)                                           \
+            {                                                                           \
+                const T *row = base + r * row_stride;                                   \
+                for (j = 0; j + lanes <= width; j += lanes)                             \
+                {                                                                       \
+                    const V v = *(const VU *)(row + j);                                 \
+                    const V b = *(VU *)(best + j);                                      \
+                    const MASK_V take = (op == SIMD_REDUCE_MAX) ? (MASK_V)(v > b)       \
+                                                                : (MASK_V)(v < b);      \
+                    *(VU *)(best + j) = SIMD_BLEND(b, v, take, V, MASK_V);              \
+                }                                                                       \
+                for (; j < width; ++j)                                                  \
+                    SIMD_REDUCE_ITEM(best[j], row[j], op);                              \
+            }                                                                           \
+            for (j = 0; j < width; ++j)                                                 \
+            {                                                                           \
+                if (accumulate)                                                         \
+                    SIMD_REDUCE_ITEM(out[j], best[j], op);                              \
+                else                                                                    \
+                    out[j] = best[j];                                                   \
+            }                                                                           \
+            continue;                                                                   \
+        }                                                                               \
+        /* sums: leaves of rows, merged pairwise (binary counter) */                    \
+        ACC_T levels[SIMD_REDUCE_ROWS_LEVELS][tile];                                    \
+        ACC_T acc[tile];                                                                \
+        size_t leaves = 0;                                                              \
+        for (size_t r0 = 0; r0 < rows; r0 += SIMD_REDUCE_ROWS_BLOCK, ++leaves)          \
+        {                                                                               \
+            const size_t r1 = (rows - r0 < SIMD_REDUCE_ROWS_BLOCK) ?                    \
+                              rows : r0 + SIMD_REDUCE_ROWS_BLOCK;                       \
+            for (j = 0; j < width; ++j)                                                 \
+                acc[j] = 0;                                                             \
+            for (size_t r = r0; r < r1; ++r)                                            \
+            {                                                                           \
+                const T *row = base + r * row_stride;                                   \
+                for (j = 0; j + lanes <= width; j += lanes)                             \
+                {                                                                       \
+                    const ACC_V x = (ACC_V)(V)*(const VU *)(row + j);                   \
+                    *(ACC_VU *)(acc + j) += (op == SIMD_REDUCE_SUM) ? x : x * x;        \
+                }                                                                       \
+                for (; j < width; ++j)                                                  \
+                    SIMD_REDUCE_ITEM(acc[j], (ACC_T)row[j], op);                        \
+            }                                                                           \
+            /* carry: merge with the leaves of equal weight */                          \
+            size_t count = leaves, level = 0;                                           \
+            for (; count & 1; count >>= 1, ++level)                                     \
+                for (j = 0; j < width; ++j)                                             \
+                    acc[j] = levels[level][j] + acc[j];                                 \
+            for (j = 0; j < width; ++j)                                                 \
+                levels[level][j] = acc[j];                                              \
+        }                                                                               \
+        /* remaining levels, lightest first */                                          \
+        int first = 1;                                                                  \
+        for (size_t level = 0; level < SIMD_REDUCE_ROWS_LEVELS; ++level)                \
+        {                                                                               \
+            if (!((leaves >> level) & 1))                                               \
+                continue;                                                               \
+            for (j = 0; j < width; ++j)                                                 \
+                acc[j] = first ? levels[level][j] : levels[level][j] + acc[j];          \
+            first = 0;                                                                  \
+        }                                                                               \
+        for (j = 0; j < width; ++j)                                                     \
+            out[j] = accumulate ? (T)((ACC_T)out[j] + acc[j]) : (T)acc[j];              \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+// GEMM blocking: rows of a micro-tile (columns are 2 vectors), rows of B
+// in a packed panel (L1), rows of A in a packed block (L2), columns of B
+// in a packed panel (L3) - all in items
+#define SIMD_GEMM_MR 6
+#define SIMD_GEMM_KC 256
+#define SIMD_GEMM_MC 144
+#define SIMD_GEMM_NC 4096
+
+/**
+ * @brief [STATIC] internal macro to define the packing of a block of A
+ * @param NAME name of the function to define
+ * @param T item type
+ * @note dest holds micro-panels of SIMD_GEMM_MR rows: item (i, p) of the
+ *       panel starting at row r goes to dest[r * kc + p * MR + i].
+ *       Missing rows of the last panel are 0.
+ */
+#define DEFINE_GEMM_PACK_A(NAME, T)                                                     \
+static SIMD_TARGET void                                                                 \
+NAME(T *dest, const T *a, size_t mc, size_t kc, size_t rs_a, size_t cs_a)               \
+{                                                                                       \
+    for (size_t r = 0; r < mc; r += SIMD_GEMM_MR)                                       \
+    {                                                                                   \
+        const size_t mr = (mc - r < SIMD_GEMM_MR) ? mc - r : SIMD_GEMM_MR;              \
+        T *panel = dest + r * kc;                                                       \
+        for (size_t i = 0; i < SIMD_GEMM_MR; ++i)                                       \
+        {                                                                               \
+            const T *row = a + (r + i) * rs_a;                                          \
+            if (i >= mr)                                                                \
+                for (size_t p = 0; p < kc; ++p)                                         \
+                    panel[p * SIMD_GEMM_MR + i] = 0;                                    \
+            else if (cs_a == 1)                                                         \
+                for (size_t p = 0; p < kc; ++p)                                         \
+                    panel[p * SIMD_GEMM_MR + i] = row[p];                               \
+            else                                                                        \
+                for (size_t p = 0; p < kc; ++p)                                         \
+                    panel[p * SIMD_GEMM_MR + i] = row[p * cs_a];                        \
+        }                                                                               \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+/**
+ * @brief [STATIC] internal macro to define the packing of a panel of B
+ * @param NAME name of the function to define
+ * @param T item type
+ * @note dest holds micro-panels of nr columns: item (p, j) of the panel
+ *       starting at column c goes to dest[c * kc + p * nr + j].
+ *       Missing columns of the last panel are 0.
+ */
+#define DEFINE_GEMM_PACK_B(NAME, T)                                                     \
+static SIMD_TARGET void                                                                 \
+NAME(T *dest, const T *b, size_t kc, size_t nc, size_t rs_b, size_t cs_b, size_t nr)    \
+{                                                                                       \
+    /* packed rows: row by row (walking down the rows of a panel would                  \
+       stride through memory, i.e. 4 kB steps for 1024 columns) */                      \
+    if (cs_b == 1)                                                                      \
+    {                                                                                   \
+        for (size_t p = 0; p < kc; ++p)                                                 \
+        {                                                                               \
+            const T *row = b + p * rs_b;                                                \
+            for (size_t c = 0; c < nc; c += nr)                                         \
+            {                                                                           \
+                const size_t width = (nc - c < nr) ? nc - c : nr;                       \
+                T *out = dest + c * kc + p * nr;                                        \
+                size_t j = 0;                                                           \
+                for (; j < width; ++j)                                                  \
+                    out[j] = row[c + j];                                                \
+                for (; j < nr; ++j)                                                     \
+                    out[j] = 0;                                                         \
+            }                                                                           \
+        }                                                                               \
+        return;                                                                         \
+    }                                                                                   \
+    /* strided rows (i.e. transposed B): panel by panel, the nr columns                 \
+       of a panel stay in the cache over the rows */                                    \
+    for (size_t c = 0; c < nc; c += nr)                                                 \
+    {                                                                                   \
+        const size_t width = (nc - c < nr) ? nc - c : nr;                               \
+        T *panel = dest + c * kc;                                                       \
+        for (size_t p = 0; p < kc; ++p)                                                 \
+        {                                                                               \
+            const T *row = b + p * rs_b + c * cs_b;                                     \
+            T *out = panel + p * nr;                                                    \
+            size_t j = 0;                                                               \
+            for (; j < width; ++j)                                                      \
+                out[j] = row[j * cs_b];                                                 \
+            for (; j < nr; ++j)                                                         \
+                out[j] = 0;                                                             \
+        }                                                                               \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+/**
+ * @brief [STATIC] internal macro for one row of a micro-tile update
+ *        (C row += alpha * accumulators, see DEFINE_GEMM_MICRO)
+ */
+#define SIMD_GEMM_ROW_UPDATE(T, VU, I, ACC0, ACC1)                                      \
+    do                                                                                  \
+    {                                                                                   \
+        T *row_ = c + (I) * rs_c;                                                       \
+        *(VU *)row_ = *(VU *)row_ + valpha * (ACC0);                                    \
+        *(VU *)(row_ + lanes) = *(VU *)(row_ + lanes) + valpha * (ACC1);                \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro for one step (P-th item of the panels) of
+ *        a micro-tile product: accumulators += A column x B row
+ *        (see DEFINE_GEMM_MICRO)
+ */
+#define SIMD_GEMM_STEP(T, V, V_FMA, P)                                                  \
+    do                                                                                  \
+    {                                                                                   \
+        const V b0_ = *(const V *)(pb + (P) * 2 * lanes);                               \
+        const V b1_ = *(const V *)(pb + (P) * 2 * lanes + lanes);                       \
+        const T *a_ = pa + (P) * SIMD_GEMM_MR;                                          \
+        V ai_;                                                                          \
+        /* x - 0 is exact (unlike x + 0 for -0): folds to a broadcast */                \
+        ai_ = a_[0] - (V){0}; c00 = V_FMA(ai_, b0_, c00); c01 = V_FMA(ai_, b1_, c01);   \
+        ai_ = a_[1] - (V){0}; c10 = V_FMA(ai_, b0_, c10); c11 = V_FMA(ai_, b1_, c11);   \
+        ai_ = a_[2] - (V){0}; c20 = V_FMA(ai_, b0_, c20); c21 = V_FMA(ai_, b1_, c21);   \
+        ai_ = a_[3] - (V){0}; c30 = V_FMA(ai_, b0_, c30); c31 = V_FMA(ai_, b1_, c31);   \
+        ai_ = a_[4] - (V){0}; c40 = V_FMA(ai_, b0_, c40); c41 = V_FMA(ai_, b1_, c41);   \
+        ai_ = a_[5] - (V){0}; c50 = V_FMA(ai_, b0_, c50); c51 = V_FMA(ai_, b1_, c51);   \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro to define the GEMM micro-kernel
+ *        (C tile += alpha * packed A panel x packed B panel)
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param V_FMA vector multiply-add of the level
+ * @note The tile is SIMD_GEMM_MR rows x 2 vectors, held in 12 vector
+ *       registers over the whole kc loop. mr / nr give the valid part of
+ *       the tile (edges go through a buffer). pb must be vector aligned.
+ */
+#define DEFINE_GEMM_MICRO(NAME, T, V, VU, V_FMA)                                        \
+static SIMD_TARGET void                                                                 \
+NAME(size_t kc, const T *pa, const T *pb, T *c, size_t rs_c, size_t cs_c,               \
+     size_t mr, size_t nr, T alpha)                                                     \
+{                                                                                       \
+    enum { lanes = sizeof(V) / sizeof(T) };                                             \
+    V c00 = {0}, c01 = {0}, c10 = {0}, c11 = {0}, c20 = {0}, c21 = {0};                 \
+    V c30 = {0}, c31 = {0}, c40 = {0}, c41 = {0}, c50 = {0}, c51 = {0};                 \
+    /* the C tile is needed after the loop: start fetching it now */                    \
+    for (size_t i = 0; i < mr; ++i)                                                     \
+        __builtin_prefetch(c + i * rs_c, 1);                                            \
+    /* unrolled by 4: the loop overhead competes with the FMAs for issue */             \
+    size_t p = 0;                                                                       \
+    for (; p + 4 <= kc; p += 4, pa += 4 * SIMD_GEMM_MR, pb += 4 * 2 * lanes)            \
+    {                                                                                   \
+        SIMD_GEMM_STEP(T, V, V_FMA, 0);                                                 \
+        SIMD_GEMM_STEP(T, V, V_FMA, 1);                                                 \
+        SIMD_GEMM_STEP(T, V, V_FMA, 2);                                                 \
+        SIMD_GEMM_STEP(T, V, V_FMA, 3);                                                 \
+    }                                                                                   \
+    for (; p < kc; ++p, pa += SIMD_GEMM_MR, pb += 2 * lanes)                            \
+        SIMD_GEMM_STEP(T, V, V_FMA, 0);                                                 \
+    const V valpha = (V){0} + alpha;                                                    \
+    /* full tile, packed rows: update C in place */                                     \
+    if (mr == SIMD_GEMM_MR && nr == 2 * lanes && cs_c == 1)                             \
+    {                                                                                   \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 0, c00, c01);                                       \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 1, c10, c11);                                       \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 2, c20, c21);                                       \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 3, c30, c31);                                       \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 4, c40, c41);                                       \
+        SIMD_GEMM_ROW_UPDATE(T, VU, 5, c50, c51);                                       \
+        return;                                                                         \
+    }                                                                                   \
+    /* edge (or strided) tile: item by item from an aligned buffer                      \
+       (whole vector stores, so the item loads are forwarded) */                        \
+    const V tile[SIMD_GEMM_MR * 2] = { c00, c01, c10, c11, c20, c21,                    \
+                                       c30, c31, c40, c41, c50, c51 };                  \
+    const T *items = (const T *)tile;                                                   \
+    for (size_t i = 0; i < mr; ++i)                                                     \
+        for (size_t j = 0; j < nr; ++j)                                                 \
+            c[i * rs_c + j * cs_c] += alpha * items[i * 2 * lanes + j];                 \
+    return;                                                                             \
+}
+
+// GEMM of small matrices: up to SIMD_GEMM_SMALL rows / columns / inner
+// items run unpacked (packing would cost about as much as the product),
+// in tiles of SIMD_GEMM_SMALL_MR rows x 2 vectors (1 vector, or a part of
+// one, at the edge)
+#define SIMD_GEMM_SMALL 32
+#define SIMD_GEMM_SMALL_MR 4
+
+/**
+ * @brief [STATIC] internal macro for one row of a small-matrix tile store
+ *        (C row = alpha * accumulators + beta * C row, see DEFINE_GEMM_SMALL)
+ * @note n0 / n1 items of the first / second vector (less than the lanes: masked)
+ */
+#define SIMD_GEMM_SMALL_STORE(T, V, VU, LOAD_PART, STORE_PART, I, ACC0, ACC1)           \
+    do                                                                                  \
+    {                                                                                   \
+        if ((I) < mr)                                                                   \
+        {                                                                               \
+            T *row_ = c + (i + (I)) * rs_c + col;                                       \
+            V x0_ = valpha * (ACC0);                                                    \
+            V x1_ = valpha * (ACC1);                                                    \
+            if (n0 == lanes)                                                            \
+            {                                                                           \
+                if (beta != (T)0)                                                       \
+                    x0_ += vbeta * *(VU *)row_;                                         \
+                *(VU *)row_ = x0_;                                                      \
+            }                                                                           \
+            else                                                                        \
+            {                                                                           \
+                if (beta != (T)0)                                                       \
+                    x0_ += vbeta * LOAD_PART(row_, n0);                                 \
+                STORE_PART(row_, x0_, n0);                                              \
+            }                                                                           \
+            if (n1 == lanes)                                                            \
+            {                                                                           \
+                if (beta != (T)0)                                                       \
+                    x1_ += vbeta * *(VU *)(row_ + lanes);                               \
+                *(VU *)(row_ + lanes) = x1_;                                            \
+            }                                                                           \
+            else if (n1)                                                                \
+            {                                                                           \
+                if (beta != (T)0)                                                       \
+                    x1_ += vbeta * LOAD_PART(row_ + lanes, n1);                         \
+                STORE_PART(row_ + lanes, x1_, n1);                                      \
+            }                                                                           \
+        }                                                                               \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro for one step of a small-matrix tile
+ *        (accumulators += A column x B row, see DEFINE_GEMM_SMALL)
+ * @note LOAD0 / LOAD1: the vectors of the B row, PAIR: use the second one
+ */
+#define SIMD_GEMM_SMALL_STEP(V, V_FMA, LOAD0, LOAD1, PAIR)                              \
+    do                                                                                  \
+    {                                                                                   \
+        const V b0_ = LOAD0;                                                            \
+        const V b1_ = LOAD1;                                                            \
+        V x_;                                                                           \
+        /* x - 0 is exact (unlike x + 0 for -0): folds to a broadcast */                \
+        x_ = a0[p * cs_a] - (V){0}; c00 = V_FMA(x_, b0_, c00);                          \
+        if (PAIR) c01 = V_FMA(x_, b1_, c01);                                            \
+        x_ = a1[p * cs_a] - (V){0}; c10 = V_FMA(x_, b0_, c10);                          \
+        if (PAIR) c11 = V_FMA(x_, b1_, c11);                                            \
+        x_ = a2[p * cs_a] - (V){0}; c20 = V_FMA(x_, b0_, c20);                          \
+        if (PAIR) c21 = V_FMA(x_, b1_, c21);                                            \
+        x_ = a3[p * cs_a] - (V){0}; c30 = V_FMA(x_, b0_, c30);                          \
+        if (PAIR) c31 = V_FMA(x_, b1_, c31);                                            \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro for the k steps of a small-matrix tile
+ * @see SIMD_GEMM_SMALL_STEP
+ */
+#define SIMD_GEMM_SMALL_LOOP(T, V, V_FMA, LOAD0, LOAD1, PAIR)                           \
+    do                                                                                  \
+    {                                                                                   \
+        const T *b_row = rows + col;                                                    \
+        for (size_t p = 0; p < k; ++p, b_row += row_stride)                             \
+            SIMD_GEMM_SMALL_STEP(V, V_FMA, LOAD0, LOAD1, PAIR);                         \
+    } while (0)
+
+/**
+ * @brief [STATIC] internal macro to define the small-matrix GEMM
+ *        (C = alpha * A x B + beta * C, every size <= SIMD_GEMM_SMALL)
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level (VU: unaligned version)
+ * @param V_FMA vector multiply-add of the level
+ * @param LOAD_PART, STORE_PART partial vector load / store of the level
+ * @note A is read in place, B too if its rows are packed (else they are
+ *       copied on the stack), row-major C is updated in place. Edge
+ *       columns use partial (masked) vectors: nothing is padded and no
+ *       item past a row is touched. No heap allocation.
+ */
+#define DEFINE_GEMM_SMALL(NAME, T, V, VU, V_FMA, LOAD_PART, STORE_PART)                 \
+static SIMD_TARGET void                                                                 \
+NAME(size_t m, size_t n, size_t k, T alpha, const T *a, size_t rs_a, size_t cs_a,       \
+     const T *b, size_t rs_b, size_t cs_b, T beta, T *c, size_t rs_c, size_t cs_c)      \
+{                                                                                       \
+    enum { lanes = sizeof(V) / sizeof(T) };                                             \
+    /* strided B: rows copied first */                                                  \
+    const T *rows = b;                                                                  \
+    size_t row_stride = rs_b;                                                           \
+    T copy[SIMD_GEMM_SMALL * SIMD_GEMM_SMALL];                                          \
+    if (cs_b != 1)                                                                      \
+    {                                                                                   \
+        for (size_t p = 0; p < k; ++p)                                                  \
+            for (size_t j = 0; j < n; ++j)                                              \
+                copy[p * n + j] = b[p * rs_b + j * cs_b];                               \
+        rows = copy;                                                                    \
+        row_stride = n;                                                                 \
+    }                                                                                   \
+    const V valpha = (V){0} + alpha;                                                    \
+    const V vbeta = (V){0} + beta;                                                      \
+    for (size_t i = 0; i < m; i += SIMD_GEMM_SMALL_MR)                                  \
+    {                                                                                   \
+        const size_t mr = (m - i < SIMD_GEMM_SMALL_MR) ? m - i : SIMD_GEMM_SMALL_MR;    \
+        /* rows past the end read the last row again (results dropped) */               \
+        const T *a0 = a + i * rs_a;                                                     \
+        const T *a1 = a + (i + ((mr > 1) ? 1 : 0)) * rs_a;                              \
+        const T *a2 = a + (i + ((mr > 2) ? 2 : 0)) * rs_a;                              \
+        const T *a3 = a + (i + ((mr > 3) ? 3 : 0)) * rs_a;                              \
+        for (size_t col = 0; col < n; col += 2 * lanes)                                 \
+        {                                                                               \
+            /* items in the first / second vector (n1 = 0: single vector) */            \
+            const size_t n0 = (n - col < lanes) ? n - col : lanes;                      \
+            const size_t n1 = (n - col < 2 * lanes) ? n - col - n0 : lanes;             \
+            V c00 = {0}, c01 = {0}, c10 = {0}, c11 = {0};                               \
+            V c20 = {0}, c21 = {0}, c30 = {0}, c31 = {0};                               \
+            if (n1 == lanes)                                                            \
+                SIMD_GEMM_SMALL_LOOP(T, V, V_FMA, *(const VU *)b_row,                   \
+                                        *(const VU *)(b_row + lanes), 1);               \
+            else if (n1)                                                                \
+                SIMD_GEMM_SMALL_LOOP(T, V, V_FMA, *(const VU *)b_row,                   \
+                                        LOAD_PART(b_row + lanes, n1), 1);               \
+            else if (n0 == lanes)                                                       \
+                SIMD_GEMM_SMALL_LOOP(T, V, V_FMA, *(const VU *)b_row, (V){0}, 0);       \
+            else                                                                        \
+                SIMD_GEMM_SMALL_LOOP(T, V, V_FMA, LOAD_PART(b_row, n0), (V){0}, 0);     \
+            /* row-major C: in place */                                                 \
+            if (cs_c == 1)                                                              \
+            {                                                                           \
+                SIMD_GEMM_SMALL_STORE(T, V, VU, LOAD_PART, STORE_PART, 0, c00, c01);    \
+                SIMD_GEMM_SMALL_STORE(T, V, VU, LOAD_PART, STORE_PART, 1, c10, c11);    \
+                SIMD_GEMM_SMALL_STORE(T, V, VU, LOAD_PART, STORE_PART, 2, c20, c21);    \
+                SIMD_GEMM_SMALL_STORE(T, V, VU, LOAD_PART, STORE_PART, 3, c30, c31);    \
+                continue;                                                               \
+            }                                                                           \
+            /* strided C: item by item from an aligned buffer */                        \
+            const V tile[SIMD_GEMM_SMALL_MR * 2] = { c00, c01, c10, c11,                \
+                                                     c20, c21, c30, c31 };              \
+            const T *items = (const T *)tile;                                           \
+            for (size_t r = 0; r < mr; ++r)                                             \
+                for (size_t j = 0; j < n0 + n1; ++j)                                    \
+                {                                                                       \
+                    T *item = c + (i + r) * rs_c + (col + j) * cs_c;                    \
+                    const T value = alpha * items[r * 2 * lanes + j];                   \
+                    *item = (beta == (T)0) ? value : value + beta * *item;              \
+                }                                                                       \
+        }                                                                               \
+    }                                                                                   \
+    return;                                                                             \
+}
+
+/**
+ * @brief [STATIC] internal macro to define a GEMM
+ *        (C = alpha * A x B + beta * C, any strides)
+ * @param NAME name of the function to define
+ * @param T item type
+ * @param V vector type of the level
+ * @param PACK_A, PACK_B, MICRO the packing and micro-kernel of the level
+ * @param SMALL the small-matrix GEMM of the level
+ * @note Small matrices (see SIMD_GEMM_SMALL) run unpacked. Others are
+ *       blocked for the caches: a KC x NC panel of B and an MC x KC block
+ *       of A are packed, then every micro-tile of the block runs the
+ *       micro-kernel. Returns 0 if the packing buffer cannot be allocated
+ *       (C is only scaled by beta then).
+ */
+#define DEFINE_GEMM(NAME, T, V, PACK_A, PACK_B, MICRO, SMALL)                           \
+static SIMD_TARGET int                                                                  \
+NAME(size_t m, size_t n, size_t k, T alpha, const T *a, size_t rs_a, size_t cs_a,       \
+     const T *b, size_t rs_b, size_t cs_b, T beta, T *c, size_t rs_c, size_t cs_c)      \
+{                                                                                       \
+    const size_t nr = 2 * (sizeof(V) / sizeof(T));                                      \
+    /* small matrices: unpacked, no allocation */                                       \
+    if (m <= SIMD_GEMM_SMALL && n <= SIMD_GEMM_SMALL && k <= SIMD_GEMM_SMALL &&         \
+        alpha != (T)0)                                                                  \
+    {                                                                                   \
+        SMALL(m, n, k, alpha, a, rs_a, cs_a, b, rs_b, cs_b, beta, c, rs_c, cs_c);       \
+        return 1;                                                                       \
+    }                                                                                   \
+    /* C = beta * C first (0 overwrites, so garbage / NaN is dropped) */                \
+    if (beta != (T)1)                                                                   \
+        for (size_t i = 0; i < m; ++i)                                                  \
+            for (size_t j = 0; j < n; ++j)                                              \
+            {                                                                           \
+                T *item = c + i * rs_c + j * cs_c;                                      \
+                *item = (beta == (T)0) ? (T)0 : beta * *item;                           \
+            }                                                                           \
+    if (m == 0 || n == 0 || k == 0 || alpha == (T)0)                                    \
+        return 1;                                                                       \
+    /* packing buffers (B panel first: vector aligned) */                               \
+    const size_t nc_max = (n < SIMD_GEMM_NC) ? (n + nr - 1) / nr * nr : SIMD_GEMM_NC;   \
+    const size_t kc_max = (k < SIMD_GEMM_KC) ? k : SIMD_GEMM_KC;                        \
+    const size_t mc_max = (m < SIMD_GEMM_MC) ?                                          \
+        (m + SIMD_GEMM_MR - 1) / SIMD_GEMM_MR * SIMD_GEMM_MR : SIMD_GEMM_MC;            \
+    unsigned char *raw = (unsigned char *)malloc((nc_max + mc_max) * kc_max * sizeof(T) \
+                                                 + VECTOR_BYTES);                       \
+    if (!raw)                                                                           \
+        return 0;                                                                       \
+    T *pb = (T *)(raw + (VECTOR_BYTES - (size_t)raw % VECTOR_BYTES));                   \
+    T *pa = pb + nc_max * kc_max;                                                       \
+    for (size_t jc = 0; jc < n; jc += SIMD_GEMM_NC)                                     \
+    {                                                                                   \
+        const size_t nc = (n - jc < SIMD_GEMM_NC) ? n - jc : SIMD_GEMM_NC;              \
+        for (size_t pc = 0; pc < k; pc += SIMD_GEMM_KC)                                 \
+        {                                                                               \
+            const size_t kc = (k - pc < SIMD_GEMM_KC) ? k - pc : SIMD_GEMM_KC;          \
+            PACK_B(pb, b + pc * rs_b + jc * cs_b, kc, nc, rs_b, cs_b, nr);              \
+            for (size_t ic = 0; ic < m; ic += SIMD_GEMM_MC)                             \
+            {                                                                           \
+                const size_t mc = (m - ic < SIMD_GEMM_MC) ? m - ic : SIMD_GEMM_MC;      \
+                PACK_A(pa, a + ic * rs_a + pc * cs_a, mc, kc, rs_a, cs_a);              \
+                for (size_t jr = 0; jr < nc; jr += nr)                                  \
+                    for (size_t ir = 0; ir < mc; ir += SIMD_GEMM_MR)                    \
+                        MICRO(kc, pa + ir * kc, pb + jr * kc,                           \
+                              c + (ic + ir) * rs_c + (jc + jr) * cs_c, rs_c, cs_c,      \
+                              (mc - ir < SIMD_GEMM_MR) ? mc - ir : SIMD_GEMM_MR,        \
+                              (nc - jr < nr) ? nc - jr : nr, alpha);                    \
+            }                                                                           \
+        }                                                                               \
+    }                                                                                   \
+    free(raw);                                                                          \
+    return 1;                                                                           \
+}
+
+/**
+ * @brief [STATIC] kernels of one instruction set level
+ * @note simd_kernels.inc defines one table per level (SIMD_NAME(kernels)),
+ *       the public functions below go through the active table
+ */
+typedef struct simd_kernel_table
+{
+    // name of the level (SIMD_MAX_ISA values)
+    const char *isa;
+    // vector size of the level (in bytes)
+    size_t vecsize;
+    // copy / fill
+    void (*copy_any)(void *, const void *, size_t);
+    void (*fill_any)(void *, const void *, size_t, size_t);
+    void (*copy_aligned)(void *, const void *, size_t);
+    void (*fill_aligned)(void *, const void *, size_t, size_t);
+    void (*copy_stream)(void *, const void *, size_t);
+    void (*fill_stream)(void *, const void *, size_t, size_t);
+    // transposes (32-bit and 64-bit items)
+    void (*transpose_32)(u32_alias *, size_t, const u32_alias *, size_t, size_t, size_t);
+    void (*transpose_64)(u64_alias *, size_t, const u64_alias *, size_t, size_t, size_t);
+    // conversions (mode is a simd_convert_mode)
+    void (*convert_int_float)(float *, const int *, size_t, int);
+    void (*convert_float_int)(int *, const float *, size_t, int);
+    void (*convert_float_double)(double *, const float *, size_t, int);
+    void (*convert_double_float)(float *, const double *, size_t, int);
+    void (*convert_int_double)(double *, const int *, size_t, int);
+    void (*convert_double_int)(int *, const double *, size_t, int);
+    void (*convert_int8_float)(float *, const signed char *, size_t, int);
+    void (*convert_float_int8)(signed char *, const float *, size_t, int);
+    // element-wise arithmetic (op: simd_binary_op, scalars: simd_scalar_operand flags)
+    void (*binary_float)(float *, const float *, const float *, size_t, int, int);
+    void (*binary_double)(double *, const double *, const double *, size_t, int, int);
+    void (*binary_int)(int *, const int *, const int *, size_t, int, int);
+    void (*fma_float)(float *, const float *, const float *, const float *, size_t, int);
+    void (*fma_double)(double *, const double *, const double *, const double *, size_t, int);
+    void (*fma_int)(int *, const int *, const int *, const int *, size_t, int);
+    // reductions (op: simd_reduce_op)
+    float (*reduce_float)(const float *, size_t, int);
+    double (*reduce_double)(const double *, size_t, int);
+    int (*reduce_int)(const int *, size_t, int);
+    size_t (*argreduce_float)(const float *, size_t, int);
+    size_t (*argreduce_double)(const double *, size_t, int);
+    size_t (*argreduce_int)(const int *, size_t, int);
+    void (*reduce_rows_float)(float *, const float *, size_t, size_t, size_t, int, int);
+    void (*reduce_rows_double)(double *, const double *, size_t, size_t, size_t, int, int);
+    void (*reduce_rows_int)(int *, const int *, size_t, size_t, size_t, int, int);
+    // matrix multiplication (returns 0 if out of memory)
+    int (*gemm_float)(size_t, size_t, size_t, float, const float *, size_t, size_t,
+                      const float *, size_t, size_t, float, float *, size_t, size_t);
+    int (*gemm_double)(size_t, size_t, size_t, double, const double *, size_t, size_t,
+                       const double *, size_t, size_t, double, double *, size_t, size_t);
+} simd_kernel_table;
+
+// Instantiate the kernels for each level
+#ifdef SIMD_X86
+
+// SSE2 (16 bytes), baseline of x86-64
+#define SIMD_NAME(x) x##_sse2
+#define SIMD_TARGET __attribute__((target("sse2")))
+#define SIMD_ISA_NAME "sse2"
+#define VECTOR_BYTES 16
+#define SIMD_STREAM_STORE(ptr, vec) _mm_stream_si128((__m128i *)(ptr), (__m128i)(vec))
+#define SIMD_STREAM_FENCE() _mm_sfence()
+// no FMA unit: multiply then add (lanes and remainder items alike)
+#define SIMD_FMA_PS SIMD_S_MUL_ADD
+#define SIMD_FMA_PD SIMD_S_MUL_ADD
+#define SIMD_FMA_SS SIMD_S_MUL_ADD
+#define SIMD_FMA_SD SIMD_S_MUL_ADD
+#include "simd_kernels.inc"
+#undef SIMD_NAME
+#undef SIMD_TARGET
+#undef SIMD_ISA_NAME
+#undef VECTOR_BYTES
+#undef SIMD_STREAM_STORE
+#undef SIMD_STREAM_FENCE
+#undef SIMD_FMA_PS
+#undef SIMD_FMA_PD
+#undef SIMD_FMA_SS
+#undef SIMD_FMA_SD
+
+// AVX2 + FMA (32 bytes), Haswell / Zen and later
+#define SIMD_NAME(x) x##_avx2
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+#define SIMD_ISA_NAME "avx2"
+#define VECTOR_BYTES 32
+#define SIMD_STREAM_STORE(ptr, vec) _mm256_stream_si256((__m256i *)(ptr), (__m256i)(vec))
+#define SIMD_STREAM_FENCE() _mm_sfence()
+// fused, one rounding (lanes and remainder items alike)
+#define SIMD_FMA_PS(x, y, z) ((SIMD_NAME(vf))_mm256_fmadd_ps((__m256)(x), (__m256)(y), (__m256)(z)))
+#define SIMD_FMA_PD(x, y, z) ((SIMD_NAME(vd))_mm256_fmadd_pd((__m256d)(x), (__m256d)(y), (__m256d)(z)))
+#define SIMD_FMA_SS(x, y, z) __builtin_fmaf((x), (y), (z))
+#define SIMD_FMA_SD(x, y, z) __builtin_fma((x), (y), (z))
+// masked load / store of the first n lanes (edges of the small-matrix GEMM)
+#define SIMD_MASK_LOAD_PS(p, n) ((SIMD_NAME(vf))_mm256_maskload_ps((p), \
+    (__m256i)((SIMD_NAME(vi)){0, 1, 2, 3, 4, 5, 6, 7} < (int)(n))))
+#define SIMD_MASK_STORE_PS(p, x, n) _mm256_maskstore_ps((p), \
+    (__m256i)((SIMD_NAME(vi)){0, 1, 2, 3, 4, 5, 6, 7} < (int)(n)), (__m256)(x))
+#define SIMD_MASK_LOAD_PD(p, n) ((SIMD_NAME(vd))_mm256_maskload_pd((p), \
+    (__m256i)((SIMD_NAME(vl)){0, 1, 2, 3} < (long long)(n))))
+#define SIMD_MASK_STORE_PD(p, x, n) _mm256_maskstore_pd((p), \
+    (__m256i)((SIMD_NAME(vl)){0, 1, 2, 3} < (long long)(n)), (__m256d)(x))
+#include "simd_kernels.inc"
+#undef SIMD_NAME
+#undef SIMD_TARGET
+#undef SIMD_ISA_NAME
+#undef VECTOR_BYTES
+#undef SIMD_STREAM_STORE
+#undef SIMD_STREAM_FENCE
+#undef SIMD_FMA_PS
+#undef SIMD_FMA_PD
+#undef SIMD_FMA_SS
+#undef SIMD_FMA_SD
+#undef SIMD_MASK_LOAD_PS
+#undef SIMD_MASK_STORE_PS
+#undef SIMD_MASK_LOAD_PD
+#undef SIMD_MASK_STORE_PD
+
+// AVX-512 F/BW/DQ/VL (64 bytes), Skylake-SP / Zen 4 and later
+#define SIMD_NAME(x) x##_avx512
+#define SIMD_TARGET __attribute__((target("avx2,fma,avx512f,avx512bw,avx512dq,avx512vl")))
+#define SIMD_ISA_NAME "avx512"
+#define VECTOR_BYTES 64
+#define SIMD_STREAM_STORE(ptr, vec) _mm512_stream_si512((__m512i *)(ptr), (__m512i)(vec))
+#define SIMD_STREAM_FENCE() _mm_sfence()
+// fused, one rounding (lanes and remainder items alike)
+#define SIMD_FMA_PS(x, y, z) ((SIMD_NAME(vf))_mm512_fmadd_ps((__m512)(x), (__m512)(y), (__m512)(z)))
+#define SIMD_FMA_PD(x, y, z) ((SIMD_NAME(vd))_mm512_fmadd_pd((__m512d)(x), (__m512d)(y), (__m512d)(z)))
+#define SIMD_FMA_SS(x, y, z) __builtin_fmaf((x), (y), (z))
+#define SIMD_FMA_SD(x, y, z) __builtin_fma((x), (y), (z))
+// masked load / store of the first n lanes (edges of the small-matrix GEMM)
+#define SIMD_MASK_LOAD_PS(p, n) \
+    ((SIMD_NAME(vf))_mm512_maskz_loadu_ps((__mmask16)((1u << (n)) - 1), (p)))
+#define SIMD_MASK_STORE_PS(p, x, n) \
+    _mm512_mask_storeu_ps((p), (__mmask16)((1u << (n)) - 1), (__m512)(x))
+#define SIMD_MASK_LOAD_PD(p, n) \
+    ((SIMD_NAME(vd))_mm512_maskz_loadu_pd((__mmask8)((1u << (n)) - 1), (p)))
+#define SIMD_MASK_STORE_PD(p, x, n) \
+    _mm512_mask_storeu_pd((p), (__mmask8)((1u << (n)) - 1), (__m512d)(x))
+#include "simd_kernels.inc"
+#undef SIMD_NAME
+#undef SIMD_TARGET
+#undef SIMD_ISA_NAME
+#undef VECTOR_BYTES
+#undef SIMD_STREAM_STORE
+#undef SIMD_STREAM_FENCE
+#undef SIMD_FMA_PS
+#undef SIMD_FMA_PD
+#undef SIMD_FMA_SS
+#undef SIMD_FMA_SD
+#undef SIMD_MASK_LOAD_PS
+#undef SIMD_MASK_STORE_PS
+#undef SIMD_MASK_LOAD_PD
+#undef SIMD_MASK_STORE_PD
+
+// levels from the lowest to the highest
+static const simd_kernel_table *const simd_levels[] =
+{
+    &kernels_sse2,
+    &kernels_avx2,
+    &kernels_avx512
+};
+
+#else
+
+// generic (16 bytes), ARM NEON or whatever the compiler targets
+#define SIMD_NAME(x) x##_generic
+#define SIMD_TARGET
+#define SIMD_ISA_NAME "generic"
+#define VECTOR_BYTES 16
+// no streaming store here, ordinary aligned store
+#define SIMD_STREAM_STORE(ptr, vec) (*(vany *)(ptr) = (vany)(vec))
+#define SIMD_STREAM_FENCE() ((void)0)
+// multiply then add (lanes and remainder items alike)
+#define SIMD_FMA_PS SIMD_S_MUL_ADD
+#define SIMD_FMA_PD SIMD_S_MUL_ADD
+#define SIMD_FMA_SS SIMD_S_MUL_ADD
+#define SIMD_FMA_SD SIMD_S_MUL_ADD
+#include "simd_kernels.inc"
+#undef SIMD_NAME
+#undef SIMD_TARGET
+#undef SIMD_ISA_NAME
+#undef VECTOR_BYTES
+#undef SIMD_STREAM_STORE
+#undef SIMD_STREAM_FENCE
+#undef SIMD_FMA_PS
+#undef SIMD_FMA_PD
+#undef SIMD_FMA_SS
+#undef SIMD_FMA_SD
+
+// single level
+static const simd_kernel_table *const simd_levels[] =
+{
+    &kernels_generic
+};
+
+#endif
+
+/**
+ * @brief [STATIC] internal helper to get the highest level the CPU (and OS) supports
+ * @return size_t Index in simd_levels
+ * @note AVX levels also need the OS to save the wider registers (XCR0)
+ */
+static size_t
+cpu_level(void)
+{
+#ifdef SIMD_X86
+    unsigned int eax, ebx, ecx, edx;
+    // leaf 1: AVX, FMA and OSXSAVE
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX) || !(ecx & bit_FMA))
+        return 0;
+    // XCR0: the OS saves XMM / YMM (bits 1, 2) and opmask / ZMM (bits 5, 6, 7)
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__ __volatile__ ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    (void)xcr0_hi;
+    if ((xcr0_lo & 0x06) != 0x06)
+        return 0;
+    // leaf 7: AVX2 and AVX-512
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return 0;
+    if (!(ebx & bit_AVX2))
+        return 0;
+    if ((ebx & bit_AVX512F) && (ebx & bit_AVX512BW) &&
+        (ebx & bit_AVX512DQ) && (ebx & bit_AVX512VL) &&
+        (xcr0_lo & 0xE6) == 0xE6)
+        return 2;
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+// active level (NULL until the first call)
+static const simd_kernel_table *simd_active_table = NULL;
+
+/**
+ * @brief [STATIC] internal helper to get the active kernels
+ * @return const simd_kernel_table* Kernels of the active level
+ * @note Picked at first use: the highest level the CPU supports, capped by
+ *       SIMD_MAX_ISA (unknown or higher values are ignored). Threads racing
+ *       on the first call pick the same level.
+ */
+static const simd_kernel_table *
+simd_active(void)
 {
-    // Check if both addresses are aligned to the same boundary
-    return (((size_t)ptr_1 & (VECTOR_BYTES - 1)) == ((size_t)ptr_2 & (VECTOR_BYTES - 1))) ? 1 : 0;
+    const simd_kernel_table *table = __atomic_load_n(&simd_active_table, __ATOMIC_ACQUIRE);
+    if (table)
+        return table;
+    // pick the level
+    size_t level = cpu_level();
+    const char *forced = getenv("SIMD_MAX_ISA");
+    if (forced)
+        for (size_t i = 0; i < level; ++i)
+            if (!strcmp(forced, simd_levels[i]->isa))
+            {
+                level = i;
+                break;
+            }
+    table = simd_levels[level];
+    __atomic_store_n(&simd_active_table, table, __ATOMIC_RELEASE);
+    return table;
 }
 
 /**
- * @brief [DEBUG] Gets the current System SIMD vector size in bytes
+ * @brief [DEBUG] Gets the SIMD vector size of the active level in bytes
  * @return size_t The vector size in bytes
  */
-inline size_t simd_get_vecsize(void)
+size_t simd_get_vecsize(void)
 {
-    return (size_t)VECTOR_BYTES;
+    return simd_active()->vecsize;
+}
+
+/**
+ * @brief [DEBUG] Gets the name of the active level
+ * @return const char* "sse2", "avx2", "avx512" (x86) or "generic"
+ */
+const char *simd_get_isa(void)
+{
+    return simd_active()->isa;
 }
 
 /**
  * @brief Vectorized COPY (any generic type)
- * @param dest pointer to destination array
- * @param src pointer to source array
- * @param length Vector length (in bytes)
- * @note We will help you to do memory alignment and handle the remainder elements
+ * @see simd.h
  */
 void simd_copy_any(void *dest, const void *src, size_t length)
 {
-    // cast the pointers to unsigned char
-    unsigned char *d = (unsigned char *)dest;
-    const unsigned char *s = (const unsigned char *)src;
+    simd_active()->copy_any(dest, src, length);
+}
 
-    // Nothing to do
-    if (d == s || (!length))
-        return;
+/**
+ * @brief Vectorized FILL (any generic type)
+ * @see simd.h
+ */
+void simd_fill_any(void *dest, const void *src, size_t dest_length, size_t src_length)
+{
+    simd_active()->fill_any(dest, src, dest_length, src_length);
+}
 
-    // Detect overlap that requires reverse copy:
-    // [s ............. s+length)
-    //        [d ............. d+length)
-    // If dest starts inside the source range and is after src, copy backwards.
-    const int copy_reversely = (d > s) && (d < (s + length));
+/**
+ * @brief Vectorized COPY (any generic type), aligned pointers only
+ * @see simd.h
+ */
+void simd_copy_aligned(void *dest, const void *src, size_t length)
+{
+    simd_active()->copy_aligned(dest, src, length);
+}
 
-    // Forward copy path
-    if (!copy_reversely)
-    {
-        // Check if both pointers share the same relative alignment.
-        // If they do, we can safely perform a strictly aligned core loop.
-        if (addresses_aligned(dest, src))
-        {
-            // Calculate memory alignment information
-            simd_memory_alignment_info alignment_info = calculate_memory_alignment(d, d + length - 1);
-
-            // Handle the unaligned start portion
-            for (size_t i = 0; i < alignment_info.start_offset; ++i)
-                d[i] = s[i];
-
-            // Handle the aligned portion using SIMD
-            size_t aligned_length = alignment_info.aligned_bytes;
-            size_t simd_iterations = aligned_length / VECTOR_BYTES;
-
-            // Update the pointers to point to the aligned portion
-            d += alignment_info.start_offset;
-            s += alignment_info.start_offset;
-
-            // cast to SIMD vector types -> vany (since we have aligned pointers)
-            vany *vd = (vany *)d;
-            const vany *vs = (const vany *)s;
-
-            // Perform the SIMD copy
-            for (size_t i = 0; i < simd_iterations; ++i)
-                vd[i] = vs[i];
-
-            // Update the pointers to point to the end of the aligned portion
-            d += aligned_length;
-            s += aligned_length;
-
-            // Handle the unaligned end portion
-            for (size_t i = 0; i < alignment_info.end_offset; ++i)
-                d[i] = s[i];
-
-            // return
-            return;
-        }
-
-        // Fallback: Pointers are misaligned relative to each other, or the buffer is too small.
-        // We execute an entirely unaligned SIMD loop using 'vany_unaligned'.
-        size_t simd_iterations = length / VECTOR_BYTES;
-
-        // cast to unaligned SIMD vector types -> vany_unaligned
-        vany_unaligned *vd = (vany_unaligned *)d;
-        const vany_unaligned *vs = (const vany_unaligned *)s;
-
-        // Perform the unaligned SIMD copy
-        for (size_t i = 0; i < simd_iterations; ++i)
-            vd[i] = vs[i];
-
-        // Update the pointers to point to the end of the aligned portion
-        size_t remaining_bytes = length & (VECTOR_BYTES - 1);
-        d += (length - remaining_bytes);
-        s += (length - remaining_bytes);
-
-        // Handle the remaining bytes (if any)
-        for (size_t i = 0; i < remaining_bytes; ++i)
-            d[i] = s[i];
-
-        // return
-        return;
-    }
+/**
+ * @brief Vectorized FILL (any generic type), aligned destination only
+ * @see simd.h
+ */
+void simd_fill_aligned(void *dest, const void *src, size_t dest_length, size_t src_length)
+{
+    simd_active()->fill_aligned(dest, src, dest_length, src_length);
+}
 
-    // Backward copy path
-    else
-    {
-        // Get the end pointers (actually points to the last element)
-        unsigned char *d_end = d + length - 1;
-        const unsigned char *s_end = s + length - 1;
-
-        // Check if both pointers share the same relative alignment.
-        // If they do, we can safely perform a strictly aligned core loop.
-        if (addresses_aligned(d_end, s_end))
-        {
-            // Calculate memory alignment information
-            simd_memory_alignment_info alignment_info = calculate_memory_alignment(d, d_end);
-
-            // Handle the unaligned end portion
-            for (size_t i = 0; i < alignment_info.end_offset; ++i)
-                d_end[-i] = s_end[-i];
-
-            // Handle the aligned portion using SIMD
-            size_t aligned_length = alignment_info.aligned_bytes;
-            size_t simd_iterations = aligned_length / VECTOR_BYTES;
-
-            // Update the pointers to point to the aligned portion
-            d_end -= alignment_info.end_offset;
-            s_end -= alignment_info.end_offset;
-
-            // cast to SIMD vector types -> vany (since we have aligned pointers)
-            vany *vd = (vany *)(d_end - aligned_length + 1);
-            const vany *vs = (const vany *)(s_end - aligned_length + 1);
-
-            // Perform the SIMD copy in reverse
-            for (size_t i = 0; i < simd_iterations; ++i)
-                vd[simd_iterations - 1 - i] = vs[simd_iterations - 1 - i];
-
-            // Update the pointers to point to the start of the aligned portion
-            d_end -= aligned_length;
-            s_end -= aligned_length;
-
-            // Handle the unaligned start portion
-            for (size_t i = 0; i < alignment_info.start_offset; ++i)
-                d_end[-i] = s_end[-i];
-
-            return;
-        }
-
-        // Fallback: Pointers are misaligned relative to each other, or the buffer is too small.
-        // We execute an entirely unaligned SIMD loop using 'vany_unaligned'.
-        size_t simd_iterations = length / VECTOR_BYTES;
-
-        // cast to unaligned SIMD vector types -> vany_unaligned
-        vany_unaligned *vd = (vany_unaligned *)(d_end - VECTOR_BYTES + 1);
-        const vany_unaligned *vs = (const vany_unaligned *)(s_end - VECTOR_BYTES + 1);
-
-        // Perform the unaligned SIMD copy in reverse
-        for (size_t i = 0; i < simd_iterations; ++i)
-            vd[simd_iterations - 1 - i] = vs[simd_iterations - 1 - i];
-
-        // Update the pointers to point to the start of the aligned portion
-        size_t remaining_bytes = length & (VECTOR_BYTES - 1);
-        d_end -= (length - remaining_bytes);
-        s_end -= (length - remaining_bytes);
-
-        // Handle the remaining bytes (if any)
-        for (size_t i = 0; i < remaining_bytes; ++i)
-            d_end[-i] = s_end[-i];
-
-        // return
-        return;        
-    }
+/**
+ * @brief Vectorized COPY (any generic type), non-temporal stores
+ * @see simd.h
+ */
+void simd_copy_stream(void *dest, const void *src, size_t length)
+{
+    simd_active()->copy_stream(dest, src, length);
 }
 
 /**
- * @brief Vectorized FILL (any generic type)
+ * @brief Vectorized FILL (any generic type), non-temporal stores
+ * @see simd.h
+ */
+void simd_fill_stream(void *dest, const void *src, size_t dest_length, size_t src_length)
+{
+    simd_active()->fill_stream(dest, src, dest_length, src_length);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (float), batched
+ * @param dest pointer to destination array, holds batch x (cols x rows)
+ * @param src pointer to source array, holds batch x (rows x cols)
+ * @param rows Number of rows of each source matrix
+ * @param cols Number of columns of each source matrix
+ * @param batch Number of matrices (use 1 for a plain 2D transpose)
+ * @note Both arrays are packed (row-major, no padding) and should not overlap
+ *       The matrices are walked in cache-sized blocks, each block is
+ *       transposed in 4x4 tiles using in-register shuffles
+ */
+void simd_transpose_float(float *dest, const float *src, size_t rows, size_t cols, size_t batch)
+{
+    for (size_t b = 0; b < batch; ++b)
+        simd_active()->transpose_32((u32_alias *)dest + b * rows * cols, rows,
+                                    (const u32_alias *)src + b * rows * cols, cols, rows, cols);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (double), batched
+ * @see simd_transpose_float
+ */
+void simd_transpose_double(double *dest, const double *src, size_t rows, size_t cols, size_t batch)
+{
+    for (size_t b = 0; b < batch; ++b)
+        simd_active()->transpose_64((u64_alias *)dest + b * rows * cols, rows,
+                                    (const u64_alias *)src + b * rows * cols, cols, rows, cols);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (int), batched
+ * @see simd_transpose_float
+ */
+void simd_transpose_int(int *dest, const int *src, size_t rows, size_t cols, size_t batch)
+{
+    for (size_t b = 0; b < batch; ++b)
+        simd_active()->transpose_32((u32_alias *)dest + b * rows * cols, rows,
+                                    (const u32_alias *)src + b * rows * cols, cols, rows, cols);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (float) of one matrix, any row lengths
+ * @param dest pointer to the destination (item [c][r] at dest[c * ld_dest + r])
+ * @param ld_dest Row length of the destination (>= rows)
+ * @param src pointer to the source (item [r][c] at src[r * ld_src + c])
+ * @param ld_src Row length of the source (>= cols)
+ * @param rows Number of rows of the source matrix
+ * @param cols Number of columns of the source matrix
+ * @note A block of rows of a larger matrix is transposed into the matching
+ *       block of columns (used to split a transpose over threads)
+ */
+void simd_transpose_strided_float(float *dest, size_t ld_dest, const float *src, size_t ld_src,
+                                  size_t rows, size_t cols)
+{
+    simd_active()->transpose_32((u32_alias *)dest, ld_dest, (const u32_alias *)src, ld_src, rows, cols);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (double) of one matrix, any row lengths
+ * @see simd_transpose_strided_float
+ */
+void simd_transpose_strided_double(double *dest, size_t ld_dest, const double *src, size_t ld_src,
+                                   size_t rows, size_t cols)
+{
+    simd_active()->transpose_64((u64_alias *)dest, ld_dest, (const u64_alias *)src, ld_src, rows, cols);
+}
+
+/**
+ * @brief Tiled TRANSPOSE (int) of one matrix, any row lengths
+ * @see simd_transpose_strided_float
+ */
+void simd_transpose_strided_int(int *dest, size_t ld_dest, const int *src, size_t ld_src,
+                                size_t rows, size_t cols)
+{
+    simd_active()->transpose_32((u32_alias *)dest, ld_dest, (const u32_alias *)src, ld_src, rows, cols);
+}
+
+/**
+ * @brief Vectorized CONVERSION int -> float
  * @param dest pointer to destination array
- * @param src pointer to source VALUEs, the array should be in length that
- *        VECTOR_BYTES could be divided by.
- *        i.e. if VECTOR_BYTES = 16, src should be in length of 1, 2, 4, 8, or 16 bytes
- *        You could get the size of VECTOR_BYTES by calling simd_get_vecsize()
- * @param dest_length Length of the destination array (in bytes)
- * @param src_length Length of the source array (in bytes)
- * @note We will help you to do memory alignment, the final bits will be wrapped
- *       around to the starting values of the src array
- * @example VECTOR_BYTES = 16, dest_length = 20,
- *          src = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16}
- *         dest = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,1,2,3,4}
+ * @param src pointer to source array
+ * @param length Number of items
+ * @note Exact up to 2^24, rounded to nearest beyond.
+ *       The arrays should not overlap (same for all conversions).
  */
-void simd_fill_any(void *dest, const void *src, size_t dest_length, size_t src_length)
+void simd_convert_int_float(float *dest, const int *src, size_t length)
+{
+    simd_active()->convert_int_float(dest, src, length, SIMD_CONVERT_TRUNCATE);
+}
+
+/**
+ * @brief Vectorized CONVERSION float -> int
+ * @param dest pointer to destination array
+ * @param src pointer to source array
+ * @param length Number of items
+ * @param mode Rounding / saturation (see simd_convert_mode)
+ */
+void simd_convert_float_int(int *dest, const float *src, size_t length, simd_convert_mode mode)
+{
+    simd_active()->convert_float_int(dest, src, length, (int)mode);
+}
+
+/**
+ * @brief Vectorized CONVERSION float -> double (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_float_double(double *dest, const float *src, size_t length)
+{
+    simd_active()->convert_float_double(dest, src, length, SIMD_CONVERT_TRUNCATE);
+}
+
+/**
+ * @brief Vectorized CONVERSION double -> float (rounded to nearest)
+ * @see simd_convert_int_float
+ */
+void simd_convert_double_float(float *dest, const double *src, size_t length)
+{
+    simd_active()->convert_double_float(dest, src, length, SIMD_CONVERT_TRUNCATE);
+}
+
+/**
+ * @brief Vectorized CONVERSION int -> double (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_int_double(double *dest, const int *src, size_t length)
+{
+    simd_active()->convert_int_double(dest, src, length, SIMD_CONVERT_TRUNCATE);
+}
+
+/**
+ * @brief Vectorized CONVERSION double -> int
+ * @see simd_convert_float_int
+ */
+void simd_convert_double_int(int *dest, const double *src, size_t length, simd_convert_mode mode)
+{
+    simd_active()->convert_double_int(dest, src, length, (int)mode);
+}
+
+/**
+ * @brief Vectorized CONVERSION int8 (signed char) -> float (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_int8_float(float *dest, const signed char *src, size_t length)
+{
+    simd_active()->convert_int8_float(dest, src, length, SIMD_CONVERT_TRUNCATE);
+}
+
+/**
+ * @brief Vectorized CONVERSION float -> int8 (signed char)
+ * @note Without SIMD_CONVERT_SATURATE, values are converted to int
+ *       first and wrapped to 8 bits
+ * @see simd_convert_float_int
+ */
+void simd_convert_float_int8(signed char *dest, const float *src, size_t length, simd_convert_mode mode)
+{
+    simd_active()->convert_float_int8(dest, src, length, (int)mode);
+}
+
+/**
+ * @brief Element-wise ARITHMETIC (float)
+ * @see simd.h
+ */
+void simd_binary_float(float *dest, const float *a, const float *b, size_t length,
+                       simd_binary_op op, int scalars)
+{
+    simd_active()->binary_float(dest, a, b, length, (int)op, scalars);
+}
+
+/**
+ * @brief Element-wise ARITHMETIC (double)
+ * @see simd.h
+ */
+void simd_binary_double(double *dest, const double *a, const double *b, size_t length,
+                        simd_binary_op op, int scalars)
 {
-    // check if src_length is valid
-    if (src_length == 0 ||
-        src_length > VECTOR_BYTES ||
-        (VECTOR_BYTES % src_length))
-        return;
+    simd_active()->binary_double(dest, a, b, length, (int)op, scalars);
+}
 
-    // Calculate destination alignment first
-    // we should copy the first couple of misaligned bytes first
-    simd_memory_alignment_info
-    dest_alignment = calculate_memory_alignment(dest, (unsigned char *)dest + dest_length - 1);
+/**
+ * @brief Element-wise ARITHMETIC (int)
+ * @see simd.h
+ */
+void simd_binary_int(int *dest, const int *a, const int *b, size_t length,
+                     simd_binary_op op, int scalars)
+{
+    simd_active()->binary_int(dest, a, b, length, (int)op, scalars);
+}
 
-    // Prepare a indexer of the source array first
-    size_t src_index = 0;
+/**
+ * @brief Element-wise MULTIPLY-ADD (float)
+ * @see simd.h
+ */
+void simd_fma_float(float *dest, const float *a, const float *b, const float *c,
+                    size_t length, int scalars)
+{
+    simd_active()->fma_float(dest, a, b, c, length, scalars);
+}
+
+/**
+ * @brief Element-wise MULTIPLY-ADD (double)
+ * @see simd.h
+ */
+void simd_fma_double(double *dest, const double *a, const double *b, const double *c,
+                     size_t length, int scalars)
+{
+    simd_active()->fma_double(dest, a, b, c, length, scalars);
+}
+
+/**
+ * @brief Element-wise MULTIPLY-ADD (int)
+ * @see simd.h
+ */
+void simd_fma_int(int *dest, const int *a, const int *b, const int *c,
+                  size_t length, int scalars)
+{
+    simd_active()->fma_int(dest, a, b, c, length, scalars);
+}
+
+/**
+ * @brief REDUCTION (float)
+ * @see simd.h
+ */
+float simd_reduce_float(const float *src, size_t length, simd_reduce_op op)
+{
+    return simd_active()->reduce_float(src, length, (int)op);
+}
+
+/**
+ * @brief REDUCTION (double)
+ * @see simd.h
+ */
+double simd_reduce_double(const double *src, size_t length, simd_reduce_op op)
+{
+    return simd_active()->reduce_double(src, length, (int)op);
+}
+
+/**
+ * @brief REDUCTION (int)
+ * @see simd.h
+ */
+int simd_reduce_int(const int *src, size_t length, simd_reduce_op op)
+{
+    return simd_active()->reduce_int(src, length, (int)op);
+}
 
-    // handle the unaligned start portion of the destination
-    unsigned char *d = (unsigned char *)dest;
-    const unsigned char *s = (const unsigned char *)src;
-    for (size_t i = 0; i < dest_alignment.start_offset; ++i)
+/**
+ * @brief ARG-MAX / ARG-MIN (float)
+ * @see simd.h
+ * @note Kernels track lane indexes in 32-bit integers, longer arrays
+ *       go in chunks (strict comparison keeps the first index)
+ */
+size_t simd_argreduce_float(const float *src, size_t length, simd_reduce_op op)
+{
+    const size_t chunk = (size_t)1 << 30;
+    size_t best_index = 0;
+    if (length == 0)
+        return 0;
+    for (size_t start = 0; start < length; start += chunk)
     {
-        // assign the value from src to dest
-        d[i] = s[src_index];
-        // increment the src_index and wrap around if necessary
-        // as src_length is guaranteed to be a divisor of VECTOR_BYTES,
-        // and VECTOR_BYTES is a power of 2, we can use bitwise AND to wrap around
-        src_index = (src_index + 1) & (src_length - 1);
+        const size_t count = (length - start < chunk) ? length - start : chunk;
+        const size_t index = start + simd_active()->argreduce_float(src + start, count, (int)op);
+        if ((op == SIMD_REDUCE_MAX) ? (src[index] > src[best_index]) : (src[index] < src[best_index]))
+            best_index = index;
     }
+    return best_index;
+}
 
-    // Create a SIMD (aligned) vector from the source array
-    // staring from the current src_index, we will fill the rest of the vector
-    // do not initialise the values as we will fill it later
-    vany src_vector;
-    for (size_t i = 0; i < VECTOR_BYTES; ++i)
+/**
+ * @brief ARG-MAX / ARG-MIN (double)
+ * @see simd.h
+ * @note Kernels track lane indexes in 32-bit integers, longer arrays
+ *       go in chunks (strict comparison keeps the first index)
+ */
+size_t simd_argreduce_double(const double *src, size_t length, simd_reduce_op op)
+{
+    const size_t chunk = (size_t)1 << 30;
+    size_t best_index = 0;
+    if (length == 0)
+        return 0;
+    for (size_t start = 0; start < length; start += chunk)
     {
-        // assign the value from src to src_vector
-        src_vector[i] = s[src_index];
-        // increment the src_index and wrap around if necessary
-        src_index = (src_index + 1) & (src_length - 1);
+        const size_t count = (length - start < chunk) ? length - start : chunk;
+        const size_t index = start + simd_active()->argreduce_double(src + start, count, (int)op);
+        if ((op == SIMD_REDUCE_MAX) ? (src[index] > src[best_index]) : (src[index] < src[best_index]))
+            best_index = index;
     }
+    return best_index;
+}
 
-    // increment the destination pointer to point to the aligned portion
-    d += dest_alignment.start_offset;
-
-    // Handle the aligned portion of the destination using SIMD
-    size_t aligned_length = dest_alignment.aligned_bytes;
-    size_t simd_iterations = aligned_length / VECTOR_BYTES;
+/**
+ * @brief ARG-MAX / ARG-MIN (int)
+ * @see simd.h
+ * @note Kernels track lane indexes in 32-bit integers, longer arrays
+ *       go in chunks (strict comparison keeps the first index)
+ */
+size_t simd_argreduce_int(const int *src, size_t length, simd_reduce_op op)
+{
+    const size_t chunk = (size_t)1 << 30;
+    size_t best_index = 0;
+    if (length == 0)
+        return 0;
+    for (size_t start = 0; start < length; start += chunk)
+    {
+        const size_t count = (length - start < chunk) ? length - start : chunk;
+        const size_t index = start + simd_active()->argreduce_int(src + start, count, (int)op);
+        if ((op == SIMD_REDUCE_MAX) ? (src[index] > src[best_index]) : (src[index] < src[best_index]))
+            best_index = index;
+    }
+    return best_index;
+}
 
-    // cast to SIMD vector types -> vany (since we have aligned pointers)
-    vany *vd = (vany *)d;
+/**
+ * @brief Row-wise REDUCTION (float)
+ * @see simd.h
+ */
+void simd_reduce_rows_float(float *dest, const float *src, size_t rows, size_t cols,
+                         size_t row_stride, simd_reduce_op op, int accumulate)
+{
+    simd_active()->reduce_rows_float(dest, src, rows, cols, row_stride, (int)op, accumulate);
+}
 
-    // Perform the SIMD fill
-    for (size_t i = 0; i < simd_iterations; ++i)
-        vd[i] = src_vector;
+/**
+ * @brief Row-wise REDUCTION (double)
+ * @see simd.h
+ */
+void simd_reduce_rows_double(double *dest, const double *src, size_t rows, size_t cols,
+                         size_t row_stride, simd_reduce_op op, int accumulate)
+{
+    simd_active()->reduce_rows_double(dest, src, rows, cols, row_stride, (int)op, accumulate);
+}
 
-    // Update the destination pointer to point to the end of the aligned portion
-    d += aligned_length;
+/**
+ * @brief Row-wise REDUCTION (int)
+ * @see simd.h
+ */
+void simd_reduce_rows_int(int *dest, const int *src, size_t rows, size_t cols,
+                         size_t row_stride, simd_reduce_op op, int accumulate)
+{
+    simd_active()->reduce_rows_int(dest, src, rows, cols, row_stride, (int)op, accumulate);
+}
 
-    // reset the src_index to 0 to fill the remaining bytes
-    src_index = 0;
+/**
+ * @brief Matrix MULTIPLICATION (float)
+ * @see simd.h
+ */
+int simd_gemm_float(size_t m, size_t n, size_t k, float alpha,
+                    const float *a, size_t a_row_stride, size_t a_col_stride,
+                    const float *b, size_t b_row_stride, size_t b_col_stride,
+                    float beta, float *c, size_t c_row_stride, size_t c_col_stride)
+{
+    return simd_active()->gemm_float(m, n, k, alpha, a, a_row_stride, a_col_stride,
+                                     b, b_row_stride, b_col_stride, beta, c, c_row_stride, c_col_stride);
+}
 
-    // Handle the unaligned end portion of the destination
-    for (size_t i = 0; i < dest_alignment.end_offset; ++i)
-    {
-        // assign the value from src to dest
-        d[i] = s[src_index];
-        // increment the src_index and wrap around if necessary
-        src_index = (src_index + 1) & (src_length - 1);
-    }
-    
-    // return
-    return;    
+/**
+ * @brief Matrix MULTIPLICATION (double)
+ * @see simd.h
+ */
+int simd_gemm_double(size_t m, size_t n, size_t k, double alpha,
+                     const double *a, size_t a_row_stride, size_t a_col_stride,
+                     const double *b, size_t b_row_stride, size_t b_col_stride,
+                     double beta, double *c, size_t c_row_stride, size_t c_col_stride)
+{
+    return simd_active()->gemm_double(m, n, k, alpha, a, a_row_stride, a_col_stride,
+                                      b, b_row_stride, b_col_stride, beta, c, c_row_stride, c_col_stride);
 }
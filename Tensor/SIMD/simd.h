@@ -9,6 +9,19 @@
 // Include necessary headers
 #include <stddef.h> // size_t
 
+// Copies / fills from this size (in bytes) on use non-temporal (streaming)
+// stores, which bypass the cache: a destination larger than the last-level
+// cache would only evict the working set (and pay read-for-ownership traffic)
+#ifndef SIMD_STREAM_THRESHOLD
+    #define SIMD_STREAM_THRESHOLD (8 * 1024 * 1024)
+#endif
+
+// Block edge (in items) of the cache blocking used by the transpose
+// a block of the source and the destination should sit in L1 together
+#ifndef SIMD_TRANSPOSE_BLOCK
+    #define SIMD_TRANSPOSE_BLOCK 32
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -17,17 +30,28 @@ extern "C"
 // Function declarations
 
 /**
- * @brief [DEBUG] Gets the current System SIMD vector size in bytes
- * @return size_t The vector size in bytes
+ * @brief [DEBUG] Gets the SIMD vector size of the active level in bytes
+ * @return size_t The vector size in bytes (16: SSE2, 32: AVX2, 64: AVX-512)
+ * @note The level is picked at first use from the CPU features, the
+ *       environment variable SIMD_MAX_ISA (sse2 / avx2 / avx512) forces
+ *       a lower one. Alignment checks should use this value.
  */
 size_t simd_get_vecsize(void);
 
+/**
+ * @brief [DEBUG] Gets the name of the active level
+ * @return const char* "sse2", "avx2", "avx512" (x86) or "generic"
+ */
+const char* simd_get_isa(void);
+
 /**
  * @brief Vectorized COPY (any generic type)
  * @param dest pointer to destination array
  * @param src pointer to source array
  * @param length Vector length (in bytes)
  * @note We will help you to do memory alignment and handle the remainder elements
+ * @note From SIMD_STREAM_THRESHOLD bytes on, non-overlapping copies go
+ *       through simd_copy_stream()
  */
 void simd_copy_any(void* dest, const void* src, size_t length);
 
@@ -45,22 +69,395 @@ void simd_copy_any(void* dest, const void* src, size_t length);
  * @example VECTOR_BYTES = 16, dest_length = 20,
  *          src = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16}
  *         dest = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,1,2,3,4}
+ * @note From SIMD_STREAM_THRESHOLD bytes on, this is simd_fill_stream()
  */
 void simd_fill_any(void* dest, const void* src, size_t dest_length, size_t src_length);
 
-// Integer operations
 /**
- * @brief Addition (vectorized)
- * @param a pointer to first array
- * @param b pointer to second array
- * @note The length of the arrays must be the same
- *       We will help you to do memory alignment and handle the remainder elements
- * @param result pointer to the result array
- * @note You can use a or b as result, the operation will then be in-place
- * @param length Vector length
- * @param subtract (unsigned char) 0 for addition (a + b), 1 for subtraction (a - b)
+ * @brief Vectorized COPY (any generic type), aligned pointers only
+ * @param dest pointer to destination array
+ * @param src pointer to source array
+ * @param length Vector length (in bytes)
+ * @note Both pointers MUST be aligned to the vector size (simd_get_vecsize()),
+ *       i.e. the start of buffers from MemoryContainer. The alignment
+ *       bookkeeping is skipped, only the remainder bytes are handled.
+ *       The arrays should not overlap.
+ */
+void simd_copy_aligned(void* dest, const void* src, size_t length);
+
+/**
+ * @brief Vectorized FILL (any generic type), aligned destination only
+ * @param dest pointer to destination array
+ * @param src pointer to source VALUEs (same requirements as simd_fill_any())
+ * @param dest_length Length of the destination array (in bytes)
+ * @param src_length Length of the source array (in bytes)
+ * @note dest MUST be aligned to the vector size (simd_get_vecsize()).
+ *       The alignment bookkeeping is skipped, only the remainder bytes
+ *       are handled (wrapped around to the starting values of src).
+ */
+void simd_fill_aligned(void* dest, const void* src, size_t dest_length, size_t src_length);
+
+/**
+ * @brief Vectorized COPY (any generic type), non-temporal stores
+ * @param dest pointer to destination array
+ * @param src pointer to source array
+ * @param length Vector length (in bytes)
+ * @note The destination is written around the cache (streaming stores,
+ *       followed by a store fence), use it for buffers larger than the
+ *       last-level cache that are not read right after.
+ *       Overlapping arrays fall back to simd_copy_any().
+ *       Targets without streaming stores use ordinary stores.
+ */
+void simd_copy_stream(void* dest, const void* src, size_t length);
+
+/**
+ * @brief Vectorized FILL (any generic type), non-temporal stores
+ * @param dest pointer to destination array
+ * @param src pointer to source VALUEs (same requirements as simd_fill_any())
+ * @param dest_length Length of the destination array (in bytes)
+ * @param src_length Length of the source array (in bytes)
+ * @see simd_copy_stream
+ */
+void simd_fill_stream(void* dest, const void* src, size_t dest_length, size_t src_length);
+
+/**
+ * @brief Tiled TRANSPOSE (float), batched
+ * @param dest pointer to destination array, holds batch x (cols x rows)
+ * @param src pointer to source array, holds batch x (rows x cols)
+ * @param rows Number of rows of each source matrix
+ * @param cols Number of columns of each source matrix
+ * @param batch Number of matrices (use 1 for a plain 2D transpose)
+ * @note Both arrays are packed (row-major, no padding) and should not overlap
+ *       The matrices are walked in cache-sized blocks, each block is
+ *       transposed in 4x4 tiles using in-register shuffles
+ */
+void simd_transpose_float(float* dest, const float* src, size_t rows, size_t cols, size_t batch);
+
+/**
+ * @brief Tiled TRANSPOSE (double), batched
+ * @see simd_transpose_float
+ */
+void simd_transpose_double(double* dest, const double* src, size_t rows, size_t cols, size_t batch);
+
+/**
+ * @brief Tiled TRANSPOSE (int), batched
+ * @see simd_transpose_float
+ */
+void simd_transpose_int(int* dest, const int* src, size_t rows, size_t cols, size_t batch);
+
+/**
+ * @brief Tiled TRANSPOSE (float) of one matrix, any row lengths
+ * @param dest pointer to the destination (item [c][r] at dest[c * ld_dest + r])
+ * @param ld_dest Row length of the destination (>= rows)
+ * @param src pointer to the source (item [r][c] at src[r * ld_src + c])
+ * @param ld_src Row length of the source (>= cols)
+ * @param rows Number of rows of the source matrix
+ * @param cols Number of columns of the source matrix
+ * @note A block of rows of a larger matrix is transposed into the matching
+ *       block of columns (used to split a transpose over threads)
+ */
+void simd_transpose_strided_float(float* dest, size_t ld_dest, const float* src, size_t ld_src,
+                                  size_t rows, size_t cols);
+
+/**
+ * @brief Tiled TRANSPOSE (double) of one matrix, any row lengths
+ * @see simd_transpose_strided_float
+ */
+void simd_transpose_strided_double(double* dest, size_t ld_dest, const double* src, size_t ld_src,
+                                   size_t rows, size_t cols);
+
+/**
+ * @brief Tiled TRANSPOSE (int) of one matrix, any row lengths
+ * @see simd_transpose_strided_float
+ */
+void simd_transpose_strided_int(int* dest, size_t ld_dest, const int* src, size_t ld_src,
+                                size_t rows, size_t cols);
+
+// Type conversions
+/**
+ * @brief Conversion modes (float/double -> integer conversions)
+ * @note ROUND and SATURATE are flags, SIMD_CONVERT_ROUND_SATURATE does both
+ */
+typedef enum simd_convert_mode
+{
+    // toward zero (C cast), out of range values are undefined
+    SIMD_CONVERT_TRUNCATE = 0,
+    // to nearest, ties to even
+    SIMD_CONVERT_ROUND = 1,
+    // toward zero, clamped to the integer range (NaN gives 0)
+    SIMD_CONVERT_SATURATE = 2,
+    // to nearest, clamped to the integer range (NaN gives 0)
+    SIMD_CONVERT_ROUND_SATURATE = 3
+} simd_convert_mode;
+
+/**
+ * @brief Vectorized CONVERSION int -> float
+ * @param dest pointer to destination array
+ * @param src pointer to source array
+ * @param length Number of items
+ * @note Exact up to 2^24, rounded to nearest beyond.
+ *       The arrays should not overlap (same for all conversions).
+ */
+void simd_convert_int_float(float* dest, const int* src, size_t length);
+
+/**
+ * @brief Vectorized CONVERSION float -> int
+ * @param dest pointer to destination array
+ * @param src pointer to source array
+ * @param length Number of items
+ * @param mode Rounding / saturation (see simd_convert_mode)
+ */
+void simd_convert_float_int(int* dest, const float* src, size_t length, simd_convert_mode mode);
+
+/**
+ * @brief Vectorized CONVERSION float -> double (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_float_double(double* dest, const float* src, size_t length);
+
+/**
+ * @brief Vectorized CONVERSION double -> float (rounded to nearest)
+ * @see simd_convert_int_float
+ */
+void simd_convert_double_float(float* dest, const double* src, size_t length);
+
+/**
+ * @brief Vectorized CONVERSION int -> double (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_int_double(double* dest, const int* src, size_t length);
+
+/**
+ * @brief Vectorized CONVERSION double -> int
+ * @see simd_convert_float_int
+ */
+void simd_convert_double_int(int* dest, const double* src, size_t length, simd_convert_mode mode);
+
+/**
+ * @brief Vectorized CONVERSION int8 (signed char) -> float (exact)
+ * @see simd_convert_int_float
+ */
+void simd_convert_int8_float(float* dest, const signed char* src, size_t length);
+
+/**
+ * @brief Vectorized CONVERSION float -> int8 (signed char)
+ * @note Without SIMD_CONVERT_SATURATE, values are converted to int
+ *       first and wrapped to 8 bits
+ * @see simd_convert_float_int
+ */
+void simd_convert_float_int8(signed char* dest, const float* src, size_t length, simd_convert_mode mode);
+
+// Element-wise arithmetic
+/**
+ * @brief Element-wise operations (simd_binary_*())
+ */
+typedef enum simd_binary_op
+{
+    SIMD_OP_ADD = 0, // a + b
+    SIMD_OP_SUB = 1, // a - b
+    SIMD_OP_MUL = 2, // a * b
+    SIMD_OP_DIV = 3, // a / b
+    SIMD_OP_MIN = 4, // b < a ? b : a
+    SIMD_OP_MAX = 5  // b > a ? b : a
+} simd_binary_op;
+
+/**
+ * @brief Operands given as a single value (flags, 0 for none)
+ * @note A single value is used for every item (broadcasting a scalar)
+ */
+typedef enum simd_scalar_operand
+{
+    SIMD_SCALAR_NONE = 0,
+    SIMD_SCALAR_A = 1,
+    SIMD_SCALAR_B = 2,
+    SIMD_SCALAR_C = 4
+} simd_scalar_operand;
+
+/**
+ * @brief Element-wise ARITHMETIC (float): dest = a op b
+ * @param dest pointer to destination array
+ * @param a pointer to first operand (array or single value)
+ * @param b pointer to second operand (array or single value)
+ * @param length Number of items
+ * @param op Operation (see simd_binary_op)
+ * @param scalars simd_scalar_operand flags of a and b
+ * @note dest may be a or b (in-place), other overlaps are not allowed
+ * @note No alignment is required. MIN / MAX keep a when b is NaN.
+ */
+void simd_binary_float(float* dest, const float* a, const float* b, size_t length,
+                       simd_binary_op op, int scalars);
+
+/**
+ * @brief Element-wise ARITHMETIC (double)
+ * @see simd_binary_float
+ */
+void simd_binary_double(double* dest, const double* a, const double* b, size_t length,
+                        simd_binary_op op, int scalars);
+
+/**
+ * @brief Element-wise ARITHMETIC (int)
+ * @see simd_binary_float
+ * @note ADD / SUB / MUL wrap around on overflow, DIV truncates toward
+ *       zero (b must not be 0)
+ */
+void simd_binary_int(int* dest, const int* a, const int* b, size_t length,
+                     simd_binary_op op, int scalars);
+
+/**
+ * @brief Element-wise MULTIPLY-ADD (float): dest = a * b + c
+ * @param dest pointer to destination array
+ * @param a, b, c pointers to operands (arrays or single values)
+ * @param length Number of items
+ * @param scalars simd_scalar_operand flags of a, b and c
+ * @note Fused (one rounding) on levels with an FMA unit (avx2, avx512),
+ *       multiply then add otherwise. Items of one call are all rounded
+ *       the same way.
+ * @note dest may be a, b or c (in-place), other overlaps are not allowed
+ */
+void simd_fma_float(float* dest, const float* a, const float* b, const float* c,
+                    size_t length, int scalars);
+
+/**
+ * @brief Element-wise MULTIPLY-ADD (double)
+ * @see simd_fma_float
+ */
+void simd_fma_double(double* dest, const double* a, const double* b, const double* c,
+                     size_t length, int scalars);
+
+/**
+ * @brief Element-wise MULTIPLY-ADD (int), wraps around on overflow
+ * @see simd_fma_float
+ */
+void simd_fma_int(int* dest, const int* a, const int* b, const int* c,
+                  size_t length, int scalars);
+
+// Reductions
+/**
+ * @brief Reductions (simd_reduce_*(), simd_argreduce_*(), simd_reduce_rows_*())
+ */
+typedef enum simd_reduce_op
+{
+    SIMD_REDUCE_SUM = 0,            // sum of the items
+    SIMD_REDUCE_SUM_SQUARES = 1,    // sum of the squared items
+    SIMD_REDUCE_MAX = 2,            // greatest item
+    SIMD_REDUCE_MIN = 3             // smallest item
+} simd_reduce_op;
+
+/**
+ * @brief Vectorized REDUCTION (float) of contiguous items
+ * @param src pointer to source array
+ * @param length Number of items (0 gives 0)
+ * @param op Reduction (see simd_reduce_op)
+ * @return The sum / sum of squares / greatest / smallest item
+ * @note Sums are pairwise (blocked tree of SIMD_REDUCE_BLOCK item leaves),
+ *       the order only depends on length and on the active level, not on
+ *       the alignment of src.
+ * @note NaN items are not ordered: MAX / MIN are undefined with NaN
+ */
+float simd_reduce_float(const float* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized REDUCTION (double)
+ * @see simd_reduce_float
+ */
+double simd_reduce_double(const double* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized REDUCTION (int), sums wrap around on overflow
+ * @see simd_reduce_float
+ */
+int simd_reduce_int(const int* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized ARG-MAX / ARG-MIN (float) of contiguous items
+ * @param src pointer to source array
+ * @param length Number of items (0 gives 0)
+ * @param op SIMD_REDUCE_MAX or SIMD_REDUCE_MIN
+ * @return Index of the first greatest / smallest item
+ */
+size_t simd_argreduce_float(const float* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized ARG-MAX / ARG-MIN (double)
+ * @see simd_argreduce_float
+ */
+size_t simd_argreduce_double(const double* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized ARG-MAX / ARG-MIN (int)
+ * @see simd_argreduce_float
+ */
+size_t simd_argreduce_int(const int* src, size_t length, simd_reduce_op op);
+
+/**
+ * @brief Vectorized row-wise REDUCTION (float): dest[j] = op of src[i * row_stride + j]
+ *        over the rows i (reduces the outer dimension of a row-major matrix)
+ * @param dest pointer to destination array (cols items)
+ * @param src pointer to the first row
+ * @param rows Number of rows (0 leaves dest untouched)
+ * @param cols Number of columns (items of a row)
+ * @param row_stride Distance between two rows (in items)
+ * @param op Reduction (see simd_reduce_op)
+ * @param accumulate 0 to overwrite dest, 1 to combine with it
+ *        (dest[j] + sum, or the greatest / smallest of both)
+ * @note Rows are read as contiguous vectors in column tiles (no gather).
+ *       Sums are pairwise over leaves of SIMD_REDUCE_ROWS_BLOCK rows, the
+ *       order only depends on rows (and the active level).
+ * @note dest should not overlap src
+ */
+void simd_reduce_rows_float(float* dest, const float* src, size_t rows, size_t cols,
+                            size_t row_stride, simd_reduce_op op, int accumulate);
+
+/**
+ * @brief Vectorized row-wise REDUCTION (double)
+ * @see simd_reduce_rows_float
+ */
+void simd_reduce_rows_double(double* dest, const double* src, size_t rows, size_t cols,
+                             size_t row_stride, simd_reduce_op op, int accumulate);
+
+/**
+ * @brief Vectorized row-wise REDUCTION (int), sums wrap around on overflow
+ * @see simd_reduce_rows_float
+ */
+void simd_reduce_rows_int(int* dest, const int* src, size_t rows, size_t cols,
+                          size_t row_stride, simd_reduce_op op, int accumulate);
+
+// Matrix multiplication
+/**
+ * @brief Blocked matrix MULTIPLICATION (float): C = alpha * A x B + beta * C
+ * @param m Rows of A and C
+ * @param n Columns of B and C
+ * @param k Columns of A, rows of B
+ * @param alpha Scale of the product
+ * @param a pointer to A (item (i, p) at a[i * a_row_stride + p * a_col_stride])
+ * @param b pointer to B (item (p, j) at b[p * b_row_stride + j * b_col_stride])
+ * @param beta Scale of C (0: C is overwritten, its items are never read)
+ * @param c pointer to C (item (i, j) at c[i * c_row_stride + j * c_col_stride])
+ * @return 1 if successful, 0 if the packing buffer could not be allocated
+ *         (C is only scaled by beta then)
+ * @note Any strides work (a transposed operand is just swapped strides).
+ *       Panels of A and B are packed for the caches, a register-blocked
+ *       micro-kernel computes 6 x (2 vectors) tiles of C. Row-major C
+ *       (c_col_stride 1) is updated with vector stores.
+ * @note Small products (m, n, k <= SIMD_GEMM_SMALL, 32) skip the packing:
+ *       A is read in place, B only copied if it is strided or its rows
+ *       are not whole vectors.
+ * @note The arrays should not overlap C. Single-threaded: callers split
+ *       C in blocks of rows / columns for threads.
+ */
+int simd_gemm_float(size_t m, size_t n, size_t k, float alpha,
+                    const float* a, size_t a_row_stride, size_t a_col_stride,
+                    const float* b, size_t b_row_stride, size_t b_col_stride,
+                    float beta, float* c, size_t c_row_stride, size_t c_col_stride);
+
+/**
+ * @brief Blocked matrix MULTIPLICATION (double)
+ * @see simd_gemm_float
  */
-// void simd_add_int(const int* a, const int* b, int* result, size_t length, unsigned char subtract);
+int simd_gemm_double(size_t m, size_t n, size_t k, double alpha,
+                     const double* a, size_t a_row_stride, size_t a_col_stride,
+                     const double* b, size_t b_row_stride, size_t b_col_stride,
+                     double beta, double* c, size_t c_row_stride, size_t c_col_stride);
 
 #ifdef __cplusplus
 }
@@ -99,6 +99,9 @@ namespace ty
         // if success tensor should always be contiguous
         virtual bool allocate (const size_t * shape, size_t dims_count) = 0;
         virtual bool allocate_like (const TENSOR_UTILITIES::Shape & shape) = 0;
+        // Same as allocate, but all bytes are zero (init() is then a no-op)
+        virtual bool allocate_zeroed (const size_t * shape, size_t dims_count) = 0;
+        virtual bool allocate_zeroed_like (const TENSOR_UTILITIES::Shape & shape) = 0;
         // Initialisation (using buffer's default init function, no guarantee value)
         virtual void init (void) = 0;
         // Erase the tensor data and reset the shape info (void the tensor)
@@ -161,6 +164,49 @@ namespace ty
         bool set_as (const size_t flatted_index,
                      TENSOR_CONVERSION_INTERMEDIATE_TYPE value) override;
 
+    // private helpers
+    private:
+        // converts count items of T into the destination buffer
+        // starting at item dst_offset (destination type is fixed per function)
+        typedef void (*Convert_fn)(void * dst, size_t dst_offset, const T * src, size_t count);
+        // plan of a run-based copy (shared by all parts)
+        struct Copy_plan
+        {
+            // coalesced source shape (iteration shape)
+            const TENSOR_UTILITIES::Shape * iter_shape;
+            // source buffer
+            const T * src;
+            // destination buffer (same type only, nullptr otherwise)
+            T * dst;
+            // destination tensor (used for cross type copy)
+            _Tensor * dest;
+            // cross type bulk conversion (nullptr if the destination
+            // type is unknown, then items go through set_as())
+            Convert_fn convert;
+            // destination buffer (cross type copy with convert only)
+            void * dest_raw;
+            // items per run and stride inside a run
+            size_t inner_count;
+            size_t inner_stride;
+            // number of parts (slices of the destination)
+            size_t parts;
+        };
+        // materialize one part of a run-based copy
+        static void copy_part (const Copy_plan & plan, size_t part);
+        // copy a contiguous run of items (block copy)
+        static void copy_run (T * dst, const T * src, size_t count);
+        // transpose a batch of packed matrices (false if no kernel for T)
+        static bool copy_transposed (T * dst, const T * src, size_t batch, size_t rows, size_t cols);
+        // convert a run of T into a buffer of X (see Convert_fn)
+        template <typename X>
+        static void convert_run (void * dst, size_t dst_offset, const T * src, size_t count);
+        // pick the bulk conversion for a destination (nullptr if unknown type)
+        static Convert_fn select_converter (const _Tensor & dest);
+        // update the contiguity flag after a shape change
+        bool sync_contiguity (void);
+        // allocation shared by allocate_like() and allocate_zeroed_like()
+        bool allocate_as (const TENSOR_UTILITIES::Shape & shape, bool zeroed);
+
     // basic public APIs
     public:
 
@@ -189,9 +235,30 @@ namespace ty
                      TENSOR_CONVERSION_INTERMEDIATE_TYPE value) override;
         bool allocate (const size_t * shape, size_t dims_count) override;
         bool allocate_like (const TENSOR_UTILITIES::Shape & shape) override;
+        bool allocate_zeroed (const size_t * shape, size_t dims_count) override;
+        bool allocate_zeroed_like (const TENSOR_UTILITIES::Shape & shape) override;
         void init (void) override;
         void erase (void) override;
 
+        /* Allocation policy (Tensor<T> only) */
+        // huge pages / locked pages for the tensor buffer
+        bool set_alloc_policy (TENSOR_UTILITIES::Alloc_policy policy);
+
+        /* Raw access (Tensor<T> only) */
+        // first item of the buffer (memory order, see get_shape() for strides)
+        // nullptr for an empty tensor
+        const T * raw_data (void) const;
+        T * raw_data (void);
+
+        /* File mapping (Tensor<T> only) */
+        // wrap a region of a file as a contiguous tensor (no copy)
+        // should not touch the tensor if failed
+        bool map_file (const char * path, const size_t * shape, size_t dims_count,
+                       size_t offset = 0,
+                       TENSOR_UTILITIES::Map_mode mode = TENSOR_UTILITIES::Map_mode::READ_ONLY);
+        // access pattern hint (mapped tensors only)
+        bool advise (TENSOR_UTILITIES::Map_advice advice) const;
+
         /* Utilities */
         void print (unsigned int precision = 6, size_t max_items = 100) const override;
     };
@@ -200,5 +267,7 @@ namespace ty
 
 // we implement in here
 #include "Tensor.tpp"
+// math on tensors (element-wise, ...)
+#include "Tensor_Math/Tensor_Math.hpp"
 
 #endif
\ No newline at end of file
@@ -44,7 +44,8 @@ inline ty::Tensor<T>::Tensor(Tensor &&other)
 {
     // move shape info (this will also move stride info)
     this->m_shape = std::move(other.m_shape);
-    // move tensor data
+    // move tensor data (and the allocation policy)
+    this->m_tensor_buff.set_alloc_policy(other.m_tensor_buff.get_alloc_policy());
     TENSOR_UTILITIES::move_assign(this->m_tensor_buff, std::move(other.m_tensor_buff));
     // move contiguity state
     this->m_contiguous = other.m_contiguous;
@@ -69,6 +70,8 @@ inline ty::Tensor<T>::Tensor(Tensor &&other)
 template <typename T>
 inline bool ty::Tensor<T>::copy_to(_Tensor &dest, bool make_contiguous) const
 {
+    // allocations are attributed to copy_to (unless a scope is active)
+    TENSOR_UTILITIES::Alloc_tag_scope tag_scope ("copy_to", true);
     // same type flag
     const bool same_type = (typeid(dest) == typeid(*this));
 
@@ -116,8 +119,12 @@ inline bool ty::Tensor<T>::copy_to(_Tensor &dest, bool make_contiguous) const
     size_t item_count = src_shape.get_item_count();
     // if count is 0, we reset dest to an empty state and return true
     if (item_count == 0) { dest.erase(); return true; }
-    // get the indexer for the source tensor
-    TENSOR_UTILITIES::Indexer src_indexer = src_shape.generate_indexer();
+    // we iterate over the coalesced form of the source shape
+    // (same visiting order, fewest dimensions: every contiguous run
+    //  collapses into the innermost dimension)
+    const TENSOR_UTILITIES::Shape iter_shape = src_shape.coalesced();
+    if (iter_shape.get_dim_count() == 0)
+        return false;
     // allocate the destination tensor
     if (!dest.allocate_like(src_shape))
     {
@@ -125,41 +132,332 @@ inline bool ty::Tensor<T>::copy_to(_Tensor &dest, bool make_contiguous) const
         // allocation does not touch the tensor if failed
         return false;
     }
-    // if same type
+    // source buffer (we read through the raw pointer, runs are in range)
+    const T * src_ptr = (const T *)this->m_tensor_buff.get(0);
+
+    // permuted last two axes (batched transpose) -> tiled transpose kernel
+    // (split over the pool by matrix and block of rows)
     if (same_type)
     {
-        // cast the destination to the correct type
-        Tensor<T> & dest_tensor = static_cast<Tensor<T>&>(dest);
+        size_t batch = 0, rows = 0, cols = 0;
+        if (iter_shape.get_batched_transpose(batch, rows, cols))
+        {
+            // cast the destination to the correct type
+            Tensor<T> & dest_tensor = static_cast<Tensor<T>&>(dest);
+            if (Tensor<T>::copy_transposed((T *)dest_tensor.m_tensor_buff.get(0), src_ptr, batch, rows, cols))
+                return true;
+        }
+    }
+
+    // the innermost coalesced dimension is the longest run that is
+    // contiguous in the source (if its stride is 1)
+    // (destination is freshly allocated, thus always contiguous)
+    // otherwise (innermost stride is not 1), we gather along it
+    const size_t inner_dim = iter_shape.get_dim_count() - 1;
+    Copy_plan plan { };
+    plan.iter_shape = &iter_shape;
+    plan.src = src_ptr;
+    plan.dst = same_type ? (T *)static_cast<Tensor<T>&>(dest).m_tensor_buff.get(0) : nullptr;
+    plan.dest = &dest;
+    plan.convert = same_type ? nullptr : Tensor<T>::select_converter(dest);
+    plan.dest_raw = plan.convert ? _Tensor::invoke_data(dest, (size_t)0) : nullptr;
+    plan.inner_count = iter_shape.get_shape(inner_dim);
+    plan.inner_stride = iter_shape.get_memory_stride(inner_dim);
+    plan.parts = 1;
 
-        // iterate indexer
-        for (size_t i = 0; i < item_count; ++i)
+// [THREADED] each thread materializes its own slice of the destination
+#ifdef BUFFER_THREADED_OPERATIONS
+    // each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+    size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(T);
+    if (min_items == 0)
+        min_items = 1;
+    plan.parts = item_count / min_items;
+    if (plan.parts > TENSOR_UTILITIES::ThreadPool::instance().get_thread_count())
+        plan.parts = TENSOR_UTILITIES::ThreadPool::instance().get_thread_count();
+    if (plan.parts == 0)
+        plan.parts = 1;
+#endif
+    // run the parts (on the process-wide pool)
+    TENSOR_UTILITIES::parallel_for(0, plan.parts, 1,
+        [](size_t start, size_t end, void * plan_ptr)
         {
-            dest_tensor.m_tensor_buff.set(i,
-                this->m_tensor_buff.get(src_shape.get_flattened_index(src_indexer)));
+            for (size_t part = start; part < end; ++part)
+                Tensor<T>::copy_part(*(const Copy_plan *)plan_ptr, part);
+        },
+        &plan);
+
+    // allocation like has already set the contiguity state
+    // return
+    return true;
+}
+
+/**
+ * @brief [INTERNAL] Materialize one part of a run-based copy
+ * @param plan The copy plan (shared by all parts).
+ * @param part Index of the part to copy (0-indexed, < plan.parts).
+ * @note Parts cover disjoint slices of the destination, so they can
+ *       run on different threads. Each part starts its own Indexer at
+ *       the first step of its slice.
+ */
+template <typename T>
+inline void ty::Tensor<T>::copy_part(const Copy_plan &plan, size_t part)
+{
+    // get the slice of this part (never splits a run)
+    size_t start = 0, end = 0;
+    if (!plan.iter_shape->partition(part, plan.parts, plan.inner_count, start, end) ||
+        start == end)
+        return;
+
+    // get the indexer for the source tensor (tracks the memory offset)
+    // let the indexer visit the first item of every run
+    TENSOR_UTILITIES::Indexer src_indexer = plan.iter_shape->generate_indexer(true);
+    src_indexer.set_stride(plan.inner_count);
+    if (!src_indexer.set_step(start))
+        return;
+
+    const size_t inner_count = plan.inner_count;
+    const size_t inner_stride = plan.inner_stride;
+    // if same type
+    if (plan.dst)
+    {
+        // iterate runs
+        for (size_t i = start; i < end; i += inner_count)
+        {
+            const T * run_ptr = plan.src + src_indexer.get_offset();
+            // contiguous run -> one block copy
+            if (inner_stride == 1)
+                Tensor<T>::copy_run(plan.dst + i, run_ptr, inner_count);
+            // strided innermost dimension -> scalar gather
+            else
+                for (size_t j = 0; j < inner_count; ++j)
+                    plan.dst[i + j] = run_ptr[j * inner_stride];
+            src_indexer.next();
+        }
+    }
+    // not same type, known destination type -> bulk conversion
+    else if (plan.convert)
+    {
+        // gather buffer for a strided innermost dimension
+        const size_t gather_count = 64;
+        T gather[gather_count];
+        // iterate runs
+        for (size_t i = start; i < end; i += inner_count)
+        {
+            const T * run_ptr = plan.src + src_indexer.get_offset();
+            // contiguous run -> converted as a whole
+            if (inner_stride == 1)
+                plan.convert(plan.dest_raw, i, run_ptr, inner_count);
+            // strided innermost dimension -> gather, then convert
+            else
+                for (size_t j = 0; j < inner_count; j += gather_count)
+                {
+                    const size_t count = (inner_count - j < gather_count) ? inner_count - j : gather_count;
+                    for (size_t k = 0; k < count; ++k)
+                        gather[k] = run_ptr[(j + k) * inner_stride];
+                    plan.convert(plan.dest_raw, i + j, gather, count);
+                }
             src_indexer.next();
         }
     }
-    // not same type
+    // not same type, unknown destination type
     else
     {
         // intermediate buffer
         TENSOR_CONVERSION_INTERMEDIATE_TYPE buff { };
-        // iterate indexer
-        for (size_t i = 0; i < item_count; ++i)
+        // iterate runs
+        for (size_t i = start; i < end; i += inner_count)
         {
-            // get and cast value from T* to
-            // the intermidiate type (TENSOR_CONVERSION_INTERMEDIATE_TYPE)
-            buff = static_cast<TENSOR_CONVERSION_INTERMEDIATE_TYPE>(
-                *((T*)this->m_tensor_buff.get(src_shape.get_flattened_index(src_indexer)))
-            );
-            // set value
-            _Tensor::invoke_set_as(dest, i, buff);
-            // move to the next index
+            const T * run_ptr = plan.src + src_indexer.get_offset();
+            for (size_t j = 0; j < inner_count; ++j)
+            {
+                // get and cast value from T* to
+                // the intermidiate type (TENSOR_CONVERSION_INTERMEDIATE_TYPE)
+                buff = static_cast<TENSOR_CONVERSION_INTERMEDIATE_TYPE>(run_ptr[j * inner_stride]);
+                // set value
+                _Tensor::invoke_set_as(*plan.dest, i + j, buff);
+            }
             src_indexer.next();
         }
     }
-    // allocation like has already set the contiguity state
     // return
+    return;
+}
+
+/**
+ * @brief [INTERNAL] Copy a contiguous run of items
+ * @param dst Pointer to the first destination item.
+ * @param src Pointer to the first source item.
+ * @param count Number of items to copy.
+ * @note The two ranges should not overlap.
+ */
+template <typename T>
+inline void ty::Tensor<T>::copy_run(T *dst, const T *src, size_t count)
+{
+// [SIMD] one vectorized block copy for the whole run
+#ifdef BUFFER_ENABLE_SIMD
+    simd_copy_any(dst, src, count * sizeof(T));
+// [NORMAL] plain loop (compiler is free to vectorize it)
+#else
+    for (size_t i = 0; i < count; ++i)
+        dst[i] = src[i];
+#endif
+    // return
+    return;
+}
+
+/**
+ * @brief [INTERNAL] Transpose a batch of packed matrices
+ * @param dst Pointer to the destination, holds batch x (cols x rows) items.
+ * @param src Pointer to the source, holds batch x (rows x cols) items.
+ * @param batch Number of matrices.
+ * @param rows Number of rows of each source matrix.
+ * @param cols Number of columns of each source matrix.
+ * @return True if a transpose kernel is available for T, false otherwise
+ *         (nothing is written in that case).
+ * @note Kernels are only available for float/double/int with SIMD enabled
+ * @note Tasks are (matrix x block of SIMD_TRANSPOSE_BLOCK source rows),
+ *       split over the pool with the part sizing of the run-based copy
+ *       (BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD, thread count).
+ */
+template <typename T>
+inline bool ty::Tensor<T>::copy_transposed(T *dst, const T *src, size_t batch, size_t rows, size_t cols)
+{
+// [SIMD] tiled transpose kernels
+#ifdef BUFFER_ENABLE_SIMD
+    // this syntax causes runtime overhead
+    // (constexpr if-else is available in C++17)
+    if (typeid(T) != typeid(float) && typeid(T) != typeid(double) && typeid(T) != typeid(int))
+        return false;
+
+    // arguments for the parts
+    struct transpose_arg
+    {
+        T *dst;
+        const T *src;
+        size_t rows;
+        size_t cols;
+        // row blocks per matrix
+        size_t blocks;
+    };
+    transpose_arg arg { dst, src, rows, cols, (rows + SIMD_TRANSPOSE_BLOCK - 1) / SIMD_TRANSPOSE_BLOCK };
+    const size_t tasks = batch * arg.blocks;
+    size_t min_tasks = tasks;
+
+// [THREADED] each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+#ifdef BUFFER_THREADED_OPERATIONS
+    size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(T);
+    if (min_items == 0)
+        min_items = 1;
+    size_t parts = (batch * rows * cols) / min_items;
+    if (parts > TENSOR_UTILITIES::ThreadPool::instance().get_thread_count())
+        parts = TENSOR_UTILITIES::ThreadPool::instance().get_thread_count();
+    if (parts == 0)
+        parts = 1;
+    min_tasks = tasks / parts;
+#endif
+    // run the parts (on the process-wide pool)
+    TENSOR_UTILITIES::parallel_for(0, tasks, min_tasks,
+        [](size_t start, size_t end, void *arg_ptr)
+        {
+            const transpose_arg &data = *(const transpose_arg *)arg_ptr;
+            const size_t matrix_size = data.rows * data.cols;
+            // consecutive row blocks of a matrix go in one call
+            for (size_t task = start; task < end; )
+            {
+                const size_t matrix = task / data.blocks;
+                const size_t first = task % data.blocks;
+                size_t last = data.blocks;
+                if (last - first > end - task)
+                    last = first + (end - task);
+                const size_t row = first * SIMD_TRANSPOSE_BLOCK;
+                const size_t row_end = (last * SIMD_TRANSPOSE_BLOCK < data.rows) ? last * SIMD_TRANSPOSE_BLOCK
+                                                                                 : data.rows;
+                // source rows [row, row_end) -> destination columns [row, row_end)
+                T *d = data.dst + matrix * matrix_size + row;
+                const T *s = data.src + matrix * matrix_size + row * data.cols;
+                if (typeid(T) == typeid(float))
+                    simd_transpose_strided_float((float *)d, data.rows, (const float *)s, data.cols,
+                                                 row_end - row, data.cols);
+                else if (typeid(T) == typeid(double))
+                    simd_transpose_strided_double((double *)d, data.rows, (const double *)s, data.cols,
+                                                  row_end - row, data.cols);
+                else
+                    simd_transpose_strided_int((int *)d, data.rows, (const int *)s, data.cols,
+                                               row_end - row, data.cols);
+                task += last - first;
+            }
+        },
+        &arg);
+    return true;
+// [NORMAL] no kernel, caller falls back to the run-based copy
+#else
+    (void)dst; (void)src; (void)batch; (void)rows; (void)cols;
+    return false;
+#endif
+}
+
+/**
+ * @brief [INTERNAL] Convert a run of items into a buffer of another type
+ * @param dst Pointer to the first item of the destination buffer (X).
+ * @param dst_offset Index of the first destination item to write.
+ * @param src Pointer to the first source item.
+ * @param count Number of items to convert.
+ * @note Items are truncated (plain casts), vectorized for the common
+ *       pairs with SIMD enabled (see Conversion.hpp)
+ */
+template <typename T>
+template <typename X>
+inline void ty::Tensor<T>::convert_run(void *dst, size_t dst_offset, const T *src, size_t count)
+{
+    TENSOR_UTILITIES::convert_items((X *)dst + dst_offset, src, count);
+    return;
+}
+
+/**
+ * @brief [INTERNAL] Pick the bulk conversion for a destination tensor
+ * @param dest The destination tensor.
+ * @return The conversion into dest's item type,
+ *         nullptr if dest is not a Tensor of an arithmetic type.
+ */
+template <typename T>
+inline typename ty::Tensor<T>::Convert_fn ty::Tensor<T>::select_converter(const _Tensor &dest)
+{
+    // this syntax causes runtime overhead
+    // (constexpr if-else is available in C++17)
+    const std::type_info & type = typeid(dest);
+    if (type == typeid(Tensor<float>))              return &Tensor<T>::convert_run<float>;
+    if (type == typeid(Tensor<double>))             return &Tensor<T>::convert_run<double>;
+    if (type == typeid(Tensor<int>))                return &Tensor<T>::convert_run<int>;
+    if (type == typeid(Tensor<unsigned int>))       return &Tensor<T>::convert_run<unsigned int>;
+    if (type == typeid(Tensor<signed char>))        return &Tensor<T>::convert_run<signed char>;
+    if (type == typeid(Tensor<unsigned char>))      return &Tensor<T>::convert_run<unsigned char>;
+    if (type == typeid(Tensor<char>))               return &Tensor<T>::convert_run<char>;
+    if (type == typeid(Tensor<short>))              return &Tensor<T>::convert_run<short>;
+    if (type == typeid(Tensor<unsigned short>))     return &Tensor<T>::convert_run<unsigned short>;
+    if (type == typeid(Tensor<long>))               return &Tensor<T>::convert_run<long>;
+    if (type == typeid(Tensor<unsigned long>))      return &Tensor<T>::convert_run<unsigned long>;
+    if (type == typeid(Tensor<long long>))          return &Tensor<T>::convert_run<long long>;
+    if (type == typeid(Tensor<unsigned long long>)) return &Tensor<T>::convert_run<unsigned long long>;
+    if (type == typeid(Tensor<long double>))        return &Tensor<T>::convert_run<long double>;
+    return nullptr;
+}
+
+/**
+ * @brief [INTERNAL] Updates the contiguity flag after a shape change
+ * @return True if successful, false otherwise
+ * @note A flat shape (items packed in logical order, only the strides of
+ *       size 1 dimensions differ) gets its strides reset, so it stays
+ *       contiguous without moving any data. O(1) otherwise (cached).
+ */
+template <typename T>
+inline bool ty::Tensor<T>::sync_contiguity(void)
+{
+    // flat but not contiguous -> reset strides
+    if (this->m_shape.is_flat() && !this->m_shape.is_contiguous())
+        if (!this->m_shape.reset_permutation())
+            return false;
+    // update contiguity flag
+    this->m_contiguous = this->m_shape.is_contiguous();
     return true;
 }
 
@@ -295,7 +593,10 @@ template <typename T>
 inline bool ty::Tensor<T>::squeeze(void)
 {
     // we only temper with the shape info
-    return this->m_shape.squeeze();
+    if (!this->m_shape.squeeze())
+        return false;
+    // update contiguity flag
+    return this->sync_contiguity();
 }
 
 /**
@@ -307,7 +608,10 @@ template <typename T>
 inline bool ty::Tensor<T>::squeeze(size_t dim)
 {
     // we only temper with the shape info
-    return this->m_shape.squeeze(dim);
+    if (!this->m_shape.squeeze(dim))
+        return false;
+    // update contiguity flag
+    return this->sync_contiguity();
 }
 
 /**
@@ -320,7 +624,10 @@ template <typename T>
 inline bool ty::Tensor<T>::squeeze(const size_t *dims, size_t dims_count)
 {
     // we only temper with the shape info
-    return this->m_shape.squeeze(dims, dims_count);
+    if (!this->m_shape.squeeze(dims, dims_count))
+        return false;
+    // update contiguity flag
+    return this->sync_contiguity();
 }
 
 /**
@@ -332,7 +639,10 @@ template <typename T>
 inline bool ty::Tensor<T>::unsqueeze(size_t dim)
 {
     // we only temper with the shape info
-    return this->m_shape.unsqueeze(dim);
+    if (!this->m_shape.unsqueeze(dim))
+        return false;
+    // update contiguity flag
+    return this->sync_contiguity();
 }
 
 /**
@@ -346,7 +656,10 @@ template <typename T>
 inline bool ty::Tensor<T>::unsqueeze(const size_t *dims, size_t dims_count)
 {
     // we only temper with the shape info
-    return this->m_shape.unsqueeze(dims, dims_count);
+    if (!this->m_shape.unsqueeze(dims, dims_count))
+        return false;
+    // update contiguity flag
+    return this->sync_contiguity();
 }
 
 /**
@@ -380,46 +693,40 @@ template <typename T>
 inline bool ty::Tensor<T>::reshape_like(const TENSOR_UTILITIES::Shape & shape)
 {
     // check if we have the same amount of parameters
+    // (cached item counts, O(1))
     if (this->m_shape.get_item_count() != shape.get_item_count())
         return false;
 
-    // check if our tensor is contiguous,
-    // if so, we can just copy the data and set the new shape
-    // faster
-    if (this->m_contiguous)
+    // non-flat tensor: we first check if we can create a view that
+    // does not require copy of data, we don't want to call contiguous so fast
+    if (!this->m_shape.is_flat())
     {
-        // set the new shape
-        TENSOR_UTILITIES::Shape new_shape = shape;
-        // reset stride
-        if (!new_shape.reset_permutation())
+        TENSOR_UTILITIES::Shape viewable = this->m_shape.viewable_as(shape);
+        // if viewable is not empty, we can just set the new shape to the viewable shape
+        if (viewable.get_dim_count() != 0)
+        {
+            // move the new shape
+            this->m_shape = std::move(viewable);
+            // update contiguity flag
+            return this->sync_contiguity();
+        }
+        // if not viewable, we have to make it contiguous first
+        if (!this->contiguous())
             return false;
-        // set the new shape
-        this->m_shape = std::move(new_shape);
-        // update contiguity flag (one can ignore this though)
-        // this->m_contiguous = this->m_shape.is_contiguous();
-        // return
-        return true;
     }
 
-    // We first check if we can create a view that does not
-    // require copy of data, we don't want to call contiguous so fast
-    TENSOR_UTILITIES::Shape viewable = this->m_shape.viewable_as(shape);
-    // if viewable is not empty, we can just set the new shape to the viewable shape
-    if (viewable.get_dim_count() != 0)
-    {
-        // move the new shape
-        this->m_shape = std::move(viewable);
-        // update contiguity flag
-        this->m_contiguous = this->m_shape.is_contiguous();
-        return true;
-    }
-
-    // if not viewable, we have to make it contiguous first, then set the new shape
-    if (!this->contiguous())
+    // our tensor is flat (items in logical order),
+    // we can just set the new shape (no data moved)
+    TENSOR_UTILITIES::Shape new_shape = shape;
+    // reset stride
+    if (!new_shape.reset_permutation())
         return false;
-    // make a recursive call to this function (we will fall into our first
-    // base-case)
-    return this->reshape_like(shape);
+    // set the new shape
+    this->m_shape = std::move(new_shape);
+    // update contiguity flag
+    this->m_contiguous = true;
+    // return
+    return true;
 }
 
 /**
@@ -435,9 +742,7 @@ inline bool ty::Tensor<T>::permute(const size_t *permute_ptr)
     if (!this->m_shape.permute(permute_ptr))
         return false;
     // update contiguity flag
-    this->m_contiguous = this->m_shape.is_contiguous();
-    // return
-    return true;
+    return this->sync_contiguity();
 }
 
 /**
@@ -455,10 +760,16 @@ inline bool ty::Tensor<T>::contiguous(void)
         return false; // Tensor is problematic [STOP immediately]
     if (this->m_contiguous)
         return true;  // already contiguous, do nothing
+    // flat tensor only needs its strides reset (no data moved)
+    if (this->m_shape.is_flat())
+        return this->sync_contiguity();
 
     // we create a new tensor and copy
     // copy_to will make sure to set m_contiguous correctly
+    // (same allocation policy)
+    TENSOR_UTILITIES::Alloc_tag_scope tag_scope ("contiguous", true);
     Tensor<T> tensor { };
+    tensor.m_tensor_buff.set_alloc_policy(this->m_tensor_buff.get_alloc_policy());
     if (!this->copy_to(tensor, true))
         return false;
 
@@ -586,12 +897,63 @@ inline bool ty::Tensor<T>::allocate(const size_t *shape, size_t dims_count)
 template <typename T>
 inline bool ty::Tensor<T>::allocate_like(const TENSOR_UTILITIES::Shape &shape)
 {
-    // create a new Tensor object
+    // plain allocation
+    return this->allocate_as(shape, false);
+}
+
+/**
+ * @brief Allocate zero-filled memory for the tensor based on a new shape
+ * @param shape Pointer to an array containing the new shape (size of each dimension)
+ * @param dims_count The number of dimensions in the new shape
+ * @return True if successful, false otherwise
+ * @note Same as allocate(), but every byte of the buffer is zero.
+ */
+template <typename T>
+inline bool ty::Tensor<T>::allocate_zeroed(const size_t *shape, size_t dims_count)
+{
+    // create a new shape object
+    TENSOR_UTILITIES::Shape shape_obj { };
+    if (!shape_obj.set_shape(shape, dims_count))
+        return false;
+    // call allocate_zeroed_like
+    return this->allocate_zeroed_like(shape_obj);
+}
+
+/**
+ * @brief Allocate zero-filled memory for the tensor based on a new shape
+ * @param shape A shape object (to reference its shape)
+ * @return True if successful, false otherwise
+ * @note Same as allocate_like(), but every byte of the buffer is zero.
+ *       Large buffers (BUFFER_ZEROED_MMAP_THRESHOLD) are fresh pages from
+ *       the OS, nothing is written until the pages are touched.
+ * @note For arithmetic and pointer types the tensor is already initialized,
+ *       a following init() is a no-op (until a mutable access, e.g. raw_data()).
+ */
+template <typename T>
+inline bool ty::Tensor<T>::allocate_zeroed_like(const TENSOR_UTILITIES::Shape &shape)
+{
+    // zero-filled allocation
+    return this->allocate_as(shape, true);
+}
+
+/**
+ * @brief Allocation shared by allocate_like() and allocate_zeroed_like()
+ * @param shape A shape object (to reference its shape)
+ * @param zeroed True to get a zero-filled buffer
+ * @return True if successful, false otherwise (tensor untouched)
+ */
+template <typename T>
+inline bool ty::Tensor<T>::allocate_as(const TENSOR_UTILITIES::Shape &shape, bool zeroed)
+{
+    // create a new Tensor object (same allocation policy)
     Tensor<T> tensor { };
+    tensor.m_tensor_buff.set_alloc_policy(this->m_tensor_buff.get_alloc_policy());
     // get item count
     size_t count = shape.get_item_count();
     // allocate memory
-    if (!tensor.m_tensor_buff.allocate(count))
+    const bool allocated = zeroed ? tensor.m_tensor_buff.allocate_zeroed(count)
+                                  : tensor.m_tensor_buff.allocate(count);
+    if (!allocated)
         return false;
     if (!tensor.m_tensor_buff.set_effective_size(count))
         return false;
@@ -614,8 +976,112 @@ inline bool ty::Tensor<T>::allocate_like(const TENSOR_UTILITIES::Shape &shape)
     return true;
 }
 
+/**
+ * @brief Set the allocation policy of the tensor buffer
+ * @param policy DEFAULT / HUGE_PAGE / LOCKED / HUGE_PAGE_LOCKED
+ * @return True if successful, false otherwise
+ * @note The policy is kept for every later allocation of this tensor
+ *       (allocate(), contiguous(), copies into it ...), the current
+ *       buffer is moved to a block of the new policy right away.
+ */
+template <typename T>
+inline bool ty::Tensor<T>::set_alloc_policy(TENSOR_UTILITIES::Alloc_policy policy)
+{
+    // forward to the buffer
+    return this->m_tensor_buff.set_alloc_policy(policy);
+}
+
+/**
+ * @brief Get the first item of the buffer (value peaking)
+ * @return Pointer to the item at memory offset 0, nullptr if empty
+ * @note Items are laid out by the memory strides of the shape
+ *       (get_shape().get_memory_stride()), which are not the logical
+ *       ones after a permutation. Meant for kernels walking the buffer.
+ */
+template <typename T>
+inline const T *ty::Tensor<T>::raw_data(void) const
+{
+    return (const T *)this->m_tensor_buff.get(0);
+}
+
+/**
+ * @brief Get the first item of the buffer (value editing)
+ * @return Pointer to the item at memory offset 0, nullptr if empty
+ * @note A block shared with other tensors (copy-on-write) or backed by
+ *       a read-only mapping is copied first, same as data().
+ * @see raw_data() const
+ */
+template <typename T>
+inline T *ty::Tensor<T>::raw_data(void)
+{
+    return (T *)this->m_tensor_buff.get(0);
+}
+
+/**
+ * @brief Wrap a region of a file as a contiguous tensor (memory mapped, no copy)
+ * @param path Path to the file
+ * @param shape Pointer to an array containing the shape (size of each dimension)
+ * @param dims_count The number of dimensions
+ * @param offset Offset of the first item in the file (in Byte),
+ *        should be a multiple of alignof(T)
+ * @param mode READ_ONLY (the first mutable access copies the data to the heap)
+ *        or PRIVATE (pages are copied by the OS on write, the file never changes)
+ * @return True if successful, false otherwise
+ * @note Items are read in place (raw binary of T, contiguous layout), pages
+ *       are loaded on first access. The file should hold at least
+ *       (item count x sizeof(T)) bytes after offset.
+ * @note If mapping fails, the original tensor will remain unchanged.
+ * @note Copies of the tensor share the mapping.
+ */
+template <typename T>
+inline bool ty::Tensor<T>::map_file(const char *path, const size_t *shape, size_t dims_count,
+                                    size_t offset, TENSOR_UTILITIES::Map_mode mode)
+{
+    // create a new Tensor object
+    Tensor<T> tensor { };
+    // set shape
+    if (!tensor.m_shape.set_shape(shape, dims_count))
+        return false;
+    // map the file (exactly the items we need)
+    size_t count = tensor.m_shape.get_item_count();
+    if (count == 0)
+        return false;
+    if (!tensor.m_tensor_buff.map_file(path, offset, count, mode))
+        return false;
+    // set contiguity flag
+    tensor.m_contiguous = true;
+
+    /* Move everything from temp */
+    // move shape info
+    this->m_shape = std::move(tensor.m_shape);
+    // move tensor data
+    TENSOR_UTILITIES::move_assign(this->m_tensor_buff, std::move(tensor.m_tensor_buff));
+    // move contiguity state
+    this->m_contiguous = tensor.m_contiguous;
+
+    // return
+    return true;
+}
+
+/**
+ * @brief Give an access pattern hint for a mapped tensor
+ * @param advice SEQUENTIAL / RANDOM / WILLNEED (read ahead now) /
+ *        DONTNEED (drop the pages, re-read on next access) / NORMAL
+ * @return True if successful, false otherwise
+ *         (or if the tensor is not backed by a mapped file)
+ * @note With DONTNEED on a PRIVATE mapping, written pages are lost.
+ */
+template <typename T>
+inline bool ty::Tensor<T>::advise(TENSOR_UTILITIES::Map_advice advice) const
+{
+    // the whole buffer
+    return this->m_tensor_buff.advise(advice);
+}
+
 /**
  * @brief Initialize the tensor (using buffer's default init function, no guarantee value)
+ * @note No-op for arithmetic and pointer types on a buffer fresh from
+ *       allocate_zeroed() (not yet handed out for writing).
  */
 template <typename T>
 inline void ty::Tensor<T>::init(void)
@@ -683,7 +1149,7 @@ inline void ty::Tensor<T>::print(unsigned int precision, size_t max_items) const
 
     // Get tensor information
     size_t dimension_count = this->m_shape.get_dim_count();
-    TENSOR_UTILITIES::Indexer indexer = this->m_shape.generate_indexer();
+    TENSOR_UTILITIES::Indexer indexer = this->m_shape.generate_indexer(true);
     size_t param_count = indexer.get_max_step();
 
     // calculate number of interest (for indentation)
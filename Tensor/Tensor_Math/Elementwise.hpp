@@ -0,0 +1,708 @@
+// File: Elementwise.hpp
+// Description: Element-wise arithmetic with broadcasting
+//              (add / sub / mul / div / min / max / multiply-add).
+//              Operands are walked in runs along the innermost
+//              dimension, contiguous runs (and broadcast single
+//              values) go to the SIMD library when BUFFER_ENABLE_SIMD
+//              is defined. Large outputs are split over the pool.
+// Date: Oct. 17, 2026
+// @ADMINGUOYU
+
+#ifndef _MATH_ELEMENTWISE_HPP_
+#define _MATH_ELEMENTWISE_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <typeinfo> // typeid()
+#include <utility>  // std::move()
+#include "../Tensor.hpp"
+
+// SIMD element-wise kernels (precompiled SIMD library)
+#ifdef BUFFER_ENABLE_SIMD
+    #include "../SIMD/simd.h"
+#endif // BUFFER_ENABLE_SIMD
+
+namespace TENSOR_MATH
+{
+
+    // element-wise operations (same values as simd_binary_op)
+    enum class Binary_op
+    {
+        ADD = 0,    // a + b
+        SUB = 1,    // a - b
+        MUL = 2,    // a * b
+        DIV = 3,    // a / b
+        MIN = 4,    // b < a ? b : a
+        MAX = 5     // b > a ? b : a
+    };
+
+    // operands given as a single value (flags, same values as simd_scalar_operand)
+    enum Scalar_operand
+    {
+        SCALAR_NONE = 0,
+        SCALAR_A = 1,
+        SCALAR_B = 2,
+        SCALAR_C = 4
+    };
+
+    // keeps T out of template argument deduction (for single value operands,
+    // so add(out, a, 2) works on a Tensor<float>)
+    template <typename T>
+    struct Item_type { typedef T type; };
+
+    /**
+     * @brief Applies an operation to one pair of items
+     * @param x First operand
+     * @param y Second operand
+     * @param op The operation
+     * @return x op y
+     */
+    template <typename T>
+    inline T apply_binary(T x, T y, Binary_op op)
+    {
+        switch (op)
+        {
+        case Binary_op::ADD: return x + y;
+        case Binary_op::SUB: return x - y;
+        case Binary_op::MUL: return x * y;
+        case Binary_op::DIV: return x / y;
+        case Binary_op::MIN: return (y < x) ? y : x;
+        case Binary_op::MAX: return (y > x) ? y : x;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Element-wise operation on a run of items: dst = a op b
+     * @param dst Pointer to the destination items
+     * @param a Pointer to the first operand (items or a single value)
+     * @param b Pointer to the second operand (items or a single value)
+     * @param count Number of items
+     * @param op The operation
+     * @param scalars Scalar_operand flags of a and b
+     * @note dst may be a or b (in-place), other overlaps are not allowed
+     * @note With BUFFER_ENABLE_SIMD, float / double / int use the
+     *       vectorized kernels, every other type is a scalar loop.
+     */
+    template <typename T>
+    inline void binary_items(T * dst, const T * a, const T * b, size_t count,
+                             Binary_op op, int scalars)
+    {
+// [SIMD] vectorized kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        const simd_binary_op simd_op = (simd_binary_op)op;
+        if (typeid(T) == typeid(float))
+            { simd_binary_float((float *)dst, (const float *)a, (const float *)b, count, simd_op, scalars); return; }
+        if (typeid(T) == typeid(double))
+            { simd_binary_double((double *)dst, (const double *)a, (const double *)b, count, simd_op, scalars); return; }
+        if (typeid(T) == typeid(int))
+            { simd_binary_int((int *)dst, (const int *)a, (const int *)b, count, simd_op, scalars); return; }
+#endif
+// [NORMAL] scalar loop
+        const size_t step_a = (scalars & SCALAR_A) ? 0 : 1;
+        const size_t step_b = (scalars & SCALAR_B) ? 0 : 1;
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = apply_binary<T>(a[i * step_a], b[i * step_b], op);
+        // return
+        return;
+    }
+
+    /**
+     * @brief Element-wise multiply-add on a run of items: dst = a * b + c
+     * @param dst Pointer to the destination items
+     * @param a, b, c Pointers to the operands (items or single values)
+     * @param count Number of items
+     * @param scalars Scalar_operand flags of a, b and c
+     * @note dst may be a, b or c (in-place), other overlaps are not allowed
+     * @note The SIMD kernels are fused (one rounding) on CPUs with an FMA
+     *       unit, see simd_fma_float().
+     */
+    template <typename T>
+    inline void fma_items(T * dst, const T * a, const T * b, const T * c, size_t count,
+                          int scalars)
+    {
+// [SIMD] vectorized kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        if (typeid(T) == typeid(float))
+            { simd_fma_float((float *)dst, (const float *)a, (const float *)b, (const float *)c, count, scalars); return; }
+        if (typeid(T) == typeid(double))
+            { simd_fma_double((double *)dst, (const double *)a, (const double *)b, (const double *)c, count, scalars); return; }
+        if (typeid(T) == typeid(int))
+            { simd_fma_int((int *)dst, (const int *)a, (const int *)b, (const int *)c, count, scalars); return; }
+#endif
+// [NORMAL] scalar loop
+        const size_t step_a = (scalars & SCALAR_A) ? 0 : 1;
+        const size_t step_b = (scalars & SCALAR_B) ? 0 : 1;
+        const size_t step_c = (scalars & SCALAR_C) ? 0 : 1;
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = a[i * step_a] * b[i * step_b] + c[i * step_c];
+        // return
+        return;
+    }
+
+    // maximum number of operands of a plan (output included,
+    // 3 inputs for fma(), up to 7 tensors for an Expression.hpp tree)
+    const size_t ELEMENTWISE_MAX_OPERANDS = 8;
+
+    /**
+     * @brief Iteration plan of an element-wise operation
+     * @note Operand 0 is the output, its dimensions are iterated in logical
+     *       order. Every operand has a memory stride per dimension, 0 where
+     *       it is broadcast. Size 1 dimensions are dropped and dimensions
+     *       that are contiguous for every operand are merged, so the
+     *       innermost dimension is the longest common run.
+     */
+    struct Elementwise_plan
+    {
+        // number of operands (output included)
+        size_t operand_count {0};
+        // number of (merged) dimensions, at least 1
+        size_t dim_count {0};
+        // total item count of the output
+        size_t item_count {0};
+        // size of each dimension
+        TENSOR_UTILITIES::DimArray shape { };
+        // memory stride of each operand along each dimension
+        TENSOR_UTILITIES::DimArray strides[ELEMENTWISE_MAX_OPERANDS];
+    };
+
+    /**
+     * @brief Builds the plan of an element-wise operation
+     * @param plan The plan to fill
+     * @param out Shape of the output (the broadcast shape of the inputs)
+     * @param inputs Shapes of the inputs (nullptr for a single value)
+     * @param input_count Number of inputs (< ELEMENTWISE_MAX_OPERANDS)
+     * @return True if successful, false if an input does not broadcast
+     *         to the output (or the output is empty)
+     * @note Inputs are aligned to the output from the last dimension on
+     *       (numpy broadcasting rules), missing dimensions are broadcast.
+     */
+    inline bool make_elementwise_plan(Elementwise_plan & plan, const TENSOR_UTILITIES::Shape & out,
+                                      const TENSOR_UTILITIES::Shape * const * inputs, size_t input_count)
+    {
+        const size_t operand_count = input_count + 1;
+        const size_t out_dims = out.get_dim_count();
+        if (operand_count > ELEMENTWISE_MAX_OPERANDS || out_dims == 0 || out.get_item_count() == 0)
+            return false;
+        // allocate (dropping and merging only shrinks)
+        if (!plan.shape.allocate(out_dims))
+            return false;
+        for (size_t k = 0; k < operand_count; ++k)
+            if (!plan.strides[k].allocate(out_dims))
+                return false;
+        plan.operand_count = operand_count;
+        plan.item_count = out.get_item_count();
+
+        size_t kept = 0;
+        size_t stride[ELEMENTWISE_MAX_OPERANDS];
+        for (size_t d = 0; d < out_dims; ++d)
+        {
+            const size_t n = out.get_shape(d);
+            // size 1 dimensions never move the offsets
+            if (n == 1)
+                continue;
+            // stride of every operand along d
+            stride[0] = out.get_memory_stride(d);
+            for (size_t k = 0; k < input_count; ++k)
+            {
+                stride[k + 1] = 0;
+                const TENSOR_UTILITIES::Shape * shape = inputs[k];
+                // single value
+                if (!shape)
+                    continue;
+                const size_t dims = shape->get_dim_count();
+                if (dims > out_dims)
+                    return false;
+                // missing dimension -> broadcast
+                if (d < out_dims - dims)
+                    continue;
+                const size_t dim = d - (out_dims - dims);
+                const size_t size = shape->get_shape(dim);
+                if (size == n)
+                    stride[k + 1] = shape->get_memory_stride(dim);
+                else if (size != 1)
+                    return false;
+            }
+            // merge into the previous dimension if the pair is contiguous
+            // for every operand (broadcast dimensions merge with each other)
+            bool merge = (kept > 0);
+            for (size_t k = 0; merge && k < operand_count; ++k)
+                merge = (plan.strides[k][kept - 1] == stride[k] * n);
+            if (merge)
+            {
+                plan.shape[kept - 1] *= n;
+                for (size_t k = 0; k < operand_count; ++k)
+                    plan.strides[k][kept - 1] = stride[k];
+                continue;
+            }
+            plan.shape[kept] = n;
+            for (size_t k = 0; k < operand_count; ++k)
+                plan.strides[k][kept] = stride[k];
+            ++kept;
+        }
+        // single item
+        if (kept == 0)
+        {
+            plan.shape[0] = 1;
+            for (size_t k = 0; k < operand_count; ++k)
+                plan.strides[k][0] = 0;
+            kept = 1;
+        }
+        // set effective sizes
+        plan.dim_count = kept;
+        plan.shape.set_effective_size(kept);
+        for (size_t k = 0; k < operand_count; ++k)
+            plan.strides[k].set_effective_size(kept);
+        // return
+        return true;
+    }
+
+    /**
+     * @brief Checks whether a shape broadcasts to another one
+     * @param from The shape to broadcast
+     * @param to The target shape
+     * @return True if every dimension of from (aligned from the last one)
+     *         is 1 or the size of to, and from has no more dimensions
+     */
+    inline bool broadcasts_to(const TENSOR_UTILITIES::Shape & from, const TENSOR_UTILITIES::Shape & to)
+    {
+        const size_t from_dims = from.get_dim_count();
+        const size_t to_dims = to.get_dim_count();
+        if (from_dims == 0 || from_dims > to_dims)
+            return false;
+        for (size_t i = 1; i <= from_dims; ++i)
+        {
+            const size_t size = from.get_shape(from_dims - i);
+            if (size != 1 && size != to.get_shape(to_dims - i))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Checks whether two shapes have the same dimensions
+     *        (strides are not compared)
+     */
+    inline bool same_dims(const TENSOR_UTILITIES::Shape & shape1, const TENSOR_UTILITIES::Shape & shape2)
+    {
+        const size_t dims = shape1.get_dim_count();
+        if (dims != shape2.get_dim_count())
+            return false;
+        for (size_t i = 0; i < dims; ++i)
+            if (shape1.get_shape(i) != shape2.get_shape(i))
+                return false;
+        return true;
+    }
+
+    /**
+     * @brief Broadcast shape of tensors
+     * @param shape The broadcast shape (result)
+     * @param tensors The tensors (nullptr entries are single values, skipped)
+     * @param count Number of entries
+     * @return True if successful, false if a tensor is empty, they do not
+     *         broadcast together or there is no tensor at all
+     */
+    template <typename T>
+    inline bool broadcast_shape(TENSOR_UTILITIES::Shape & shape, const ty::Tensor<T> * const * tensors,
+                                size_t count)
+    {
+        bool has_shape = false;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (!tensors[i])
+                continue;
+            const TENSOR_UTILITIES::Shape & input_shape = tensors[i]->get_shape();
+            if (input_shape.get_item_count() == 0)
+                return false;
+            if (!has_shape)
+            {
+                shape = input_shape;
+                has_shape = true;
+                continue;
+            }
+            TENSOR_UTILITIES::Broadcast_result result =
+                TENSOR_UTILITIES::get_compatible_shapes(shape, input_shape);
+            if (result.compatible_shape.get_dim_count() == 0)
+                return false;
+            shape = std::move(result.compatible_shape);
+        }
+        // return
+        return has_shape;
+    }
+
+    /**
+     * @brief Arguments of an element-wise run (shared by all parts)
+     */
+    template <typename T>
+    struct Elementwise_task
+    {
+        // iteration plan (operand 0 is out)
+        const Elementwise_plan * plan;
+        // first item of every operand
+        T * out;
+        const T * in[ELEMENTWISE_MAX_OPERANDS - 1];
+        // multiply-add (3 inputs) or binary operation (2 inputs)
+        bool fma;
+        Binary_op op;
+    };
+
+    /**
+     * @brief Runs the items [start, end) of an element-wise operation
+     * @param task The task (shared by all parts)
+     * @param start First item (logical order of the output)
+     * @param end Last item (not inclusive)
+     * @note Items are walked in runs along the innermost dimension. Runs
+     *       with a packed output and packed or broadcast inputs go to the
+     *       run kernels, other runs are strided loops.
+     */
+    template <typename T>
+    inline void elementwise_part(const Elementwise_task<T> & task, size_t start, size_t end)
+    {
+        const Elementwise_plan & plan = *task.plan;
+        const size_t dims = plan.dim_count;
+        const size_t last = dims - 1;
+        const size_t inner = plan.shape[last];
+        const size_t input_count = plan.operand_count - 1;
+        // inner strides (same for every run)
+        size_t step[ELEMENTWISE_MAX_OPERANDS];
+        int scalars = SCALAR_NONE;
+        bool packed = true;
+        for (size_t k = 0; k < plan.operand_count; ++k)
+        {
+            step[k] = plan.strides[k][last];
+            // output must be packed
+            if (k == 0)
+                packed = (step[k] == 1);
+            // broadcast input -> single value (SCALAR_A, SCALAR_B, SCALAR_C)
+            else if (step[k] == 0)
+                scalars |= (1 << (k - 1));
+            else
+                packed = packed && (step[k] == 1);
+        }
+
+        // index of the first item
+        TENSOR_UTILITIES::DimArray index { };
+        if (!index.allocate(dims))
+            return;
+        index.set_effective_size(dims);
+        size_t rest = start;
+        for (size_t d = dims; d > 0; --d)
+        {
+            index[d - 1] = rest % plan.shape[d - 1];
+            rest /= plan.shape[d - 1];
+        }
+
+        size_t offset[ELEMENTWISE_MAX_OPERANDS];
+        for (size_t pos = start; pos < end; )
+        {
+            // offsets of the run
+            for (size_t k = 0; k < plan.operand_count; ++k)
+            {
+                offset[k] = 0;
+                for (size_t d = 0; d < dims; ++d)
+                    offset[k] += index[d] * plan.strides[k][d];
+            }
+            size_t count = inner - index[last];
+            if (count > end - pos)
+                count = end - pos;
+
+            T * out = task.out + offset[0];
+            const T * a = task.in[0] + offset[1];
+            const T * b = task.in[1] + offset[2];
+            const T * c = (input_count > 2) ? task.in[2] + offset[3] : nullptr;
+            // packed run -> run kernels
+            if (packed)
+            {
+                if (task.fma)
+                    fma_items<T>(out, a, b, c, count, scalars);
+                else
+                    binary_items<T>(out, a, b, count, task.op, scalars);
+            }
+            // strided run -> scalar loop
+            else if (task.fma)
+                for (size_t j = 0; j < count; ++j)
+                    out[j * step[0]] = a[j * step[1]] * b[j * step[2]] + c[j * step[3]];
+            else
+                for (size_t j = 0; j < count; ++j)
+                    out[j * step[0]] = apply_binary<T>(a[j * step[1]], b[j * step[2]], task.op);
+
+            // next run
+            pos += count;
+            index[last] += count;
+            for (size_t d = last; d > 0 && index[d] == plan.shape[d]; --d)
+            {
+                index[d] = 0;
+                ++index[d - 1];
+            }
+        }
+        // return
+        return;
+    }
+
+    /**
+     * @brief Element-wise operation on tensors (driver)
+     * @param out The output tensor
+     * @param tensors The input tensors (nullptr for a single value)
+     * @param values The single values (used where tensors[i] is nullptr)
+     * @param input_count Number of inputs (2 for a binary operation, 3 for fma)
+     * @param fma True for a * b + c, false for a op b
+     * @param op The operation (binary only)
+     * @return True if successful, false if the inputs do not broadcast
+     *         together or allocation failed (out is untouched then)
+     * @note out keeps its buffer and layout if it already has the broadcast
+     *       shape (in-place when it is one of the inputs), it is allocated
+     *       (contiguous) otherwise.
+     */
+    template <typename T>
+    inline bool elementwise_tensors(ty::Tensor<T> & out, const ty::Tensor<T> * const * tensors,
+                                    const T * const * values, size_t input_count,
+                                    bool fma, Binary_op op)
+    {
+        // broadcast shape of the inputs
+        TENSOR_UTILITIES::Shape shape { };
+        if (!broadcast_shape<T>(shape, tensors, input_count))
+            return false;
+        bool aliased = false;
+        for (size_t i = 0; i < input_count; ++i)
+            aliased = aliased || (tensors[i] == &out);
+
+        // output of another shape
+        if (!same_dims(out.get_shape(), shape))
+        {
+            // output is also an input -> compute aside, then copy
+            if (aliased)
+            {
+                ty::Tensor<T> result { };
+                if (!elementwise_tensors<T>(result, tensors, values, input_count, fma, op))
+                    return false;
+                return result.copy_to(out);
+            }
+            if (!out.allocate_like(shape))
+                return false;
+        }
+
+        // plan
+        const TENSOR_UTILITIES::Shape * shapes[ELEMENTWISE_MAX_OPERANDS - 1];
+        for (size_t i = 0; i < input_count; ++i)
+            shapes[i] = tensors[i] ? &tensors[i]->get_shape() : nullptr;
+        Elementwise_plan plan { };
+        if (!make_elementwise_plan(plan, out.get_shape(), shapes, input_count))
+            return false;
+
+        // output first (a shared block is copied before the inputs are read)
+        Elementwise_task<T> task { };
+        task.plan = &plan;
+        task.out = out.raw_data();
+        for (size_t i = 0; i < input_count; ++i)
+            task.in[i] = tensors[i] ? tensors[i]->raw_data() : values[i];
+        task.fma = fma;
+        task.op = op;
+        if (!task.out)
+            return false;
+
+        // each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+#ifdef BUFFER_THREADED_OPERATIONS
+        const size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(T);
+#else
+        const size_t min_items = plan.item_count;
+#endif
+        // run the parts (on the process-wide pool)
+        TENSOR_UTILITIES::parallel_for(0, plan.item_count, min_items,
+            [](size_t start, size_t end, void * task_ptr)
+            {
+                elementwise_part<T>(*(const Elementwise_task<T> *)task_ptr, start, end);
+            },
+            &task);
+        // return
+        return true;
+    }
+}
+
+namespace ty
+{
+
+    /**
+     * @brief Element-wise operation with broadcasting: out = a op b
+     * @param out The output tensor
+     * @param a The first operand
+     * @param b The second operand (a tensor or a single value)
+     * @param op ADD / SUB / MUL / DIV / MIN / MAX
+     * @return True if successful, false if a and b do not broadcast together
+     *         (or allocation failed), out is untouched then
+     * @note Shapes are aligned from the last dimension on, size 1 (or
+     *       missing) dimensions are repeated (numpy broadcasting rules).
+     * @note out keeps its buffer and layout if it already has the result
+     *       shape, otherwise it is allocated (contiguous). out may be a or b.
+     * @note Integer division by 0 is undefined, MIN / MAX keep a if b is NaN.
+     */
+    template <typename T>
+    inline bool binary_op(Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b,
+                          TENSOR_MATH::Binary_op op)
+    {
+        const Tensor<T> * tensors[2] = { &a, &b };
+        const T * values[2] = { nullptr, nullptr };
+        return TENSOR_MATH::elementwise_tensors<T>(out, tensors, values, 2, false, op);
+    }
+    template <typename T>
+    inline bool binary_op(Tensor<T> & out, const Tensor<T> & a,
+                          typename TENSOR_MATH::Item_type<T>::type b, TENSOR_MATH::Binary_op op)
+    {
+        const Tensor<T> * tensors[2] = { &a, nullptr };
+        const T * values[2] = { nullptr, &b };
+        return TENSOR_MATH::elementwise_tensors<T>(out, tensors, values, 2, false, op);
+    }
+
+    /**
+     * @brief In-place element-wise operation: a = a op b
+     * @param a The operand to update (keeps its shape and layout)
+     * @param b The second operand (a tensor or a single value)
+     * @param op ADD / SUB / MUL / DIV / MIN / MAX
+     * @return True if successful, false if b does not broadcast to a's
+     *         shape (a is untouched then)
+     */
+    template <typename T>
+    inline bool binary_op_assign(Tensor<T> & a, const Tensor<T> & b, TENSOR_MATH::Binary_op op)
+    {
+        if (!TENSOR_MATH::broadcasts_to(b.get_shape(), a.get_shape()))
+            return false;
+        return binary_op<T>(a, a, b, op);
+    }
+    template <typename T>
+    inline bool binary_op_assign(Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b,
+                                 TENSOR_MATH::Binary_op op)
+    {
+        return binary_op<T>(a, a, b, op);
+    }
+
+    // out = a + b, a - b, a * b, a / b, min(a, b), max(a, b) (see binary_op())
+    template <typename T>
+    inline bool add (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::ADD); }
+    template <typename T>
+    inline bool add (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::ADD); }
+    template <typename T>
+    inline bool sub (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::SUB); }
+    template <typename T>
+    inline bool sub (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::SUB); }
+    template <typename T>
+    inline bool mul (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MUL); }
+    template <typename T>
+    inline bool mul (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MUL); }
+    template <typename T>
+    inline bool div (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::DIV); }
+    template <typename T>
+    inline bool div (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::DIV); }
+    template <typename T>
+    inline bool minimum (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MIN); }
+    template <typename T>
+    inline bool minimum (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MIN); }
+    template <typename T>
+    inline bool maximum (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MAX); }
+    template <typename T>
+    inline bool maximum (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op<T>(out, a, b, TENSOR_MATH::Binary_op::MAX); }
+
+    // a += b, a -= b, a *= b, a /= b, a = min(a, b), a = max(a, b) (see binary_op_assign())
+    template <typename T>
+    inline bool add_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::ADD); }
+    template <typename T>
+    inline bool add_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::ADD); }
+    template <typename T>
+    inline bool sub_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::SUB); }
+    template <typename T>
+    inline bool sub_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::SUB); }
+    template <typename T>
+    inline bool mul_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MUL); }
+    template <typename T>
+    inline bool mul_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MUL); }
+    template <typename T>
+    inline bool div_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::DIV); }
+    template <typename T>
+    inline bool div_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::DIV); }
+    template <typename T>
+    inline bool minimum_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MIN); }
+    template <typename T>
+    inline bool minimum_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MIN); }
+    template <typename T>
+    inline bool maximum_assign (Tensor<T> & a, const Tensor<T> & b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MAX); }
+    template <typename T>
+    inline bool maximum_assign (Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    { return binary_op_assign<T>(a, b, TENSOR_MATH::Binary_op::MAX); }
+
+    /**
+     * @brief Element-wise multiply-add with broadcasting: out = a * b + c
+     * @param out The output tensor
+     * @param a, b, c The operands (b may be a single value)
+     * @return True if successful, false if the operands do not broadcast
+     *         together (or allocation failed), out is untouched then
+     * @note One pass over the operands (no temporary for a * b). With
+     *       BUFFER_ENABLE_SIMD, float / double are fused (one rounding)
+     *       on CPUs with an FMA unit.
+     * @see binary_op() for the broadcasting and output rules
+     */
+    template <typename T>
+    inline bool fma (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b, const Tensor<T> & c)
+    {
+        const Tensor<T> * tensors[3] = { &a, &b, &c };
+        const T * values[3] = { nullptr, nullptr, nullptr };
+        return TENSOR_MATH::elementwise_tensors<T>(out, tensors, values, 3, true, TENSOR_MATH::Binary_op::ADD);
+    }
+    template <typename T>
+    inline bool fma (Tensor<T> & out, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b,
+                     const Tensor<T> & c)
+    {
+        const Tensor<T> * tensors[3] = { &a, nullptr, &c };
+        const T * values[3] = { nullptr, &b, nullptr };
+        return TENSOR_MATH::elementwise_tensors<T>(out, tensors, values, 3, true, TENSOR_MATH::Binary_op::ADD);
+    }
+
+    /**
+     * @brief In-place multiply-accumulate: acc = a * b + acc
+     * @param acc The accumulator (keeps its shape and layout)
+     * @param a, b The operands (b may be a single value, i.e. axpy)
+     * @return True if successful, false if a or b does not broadcast
+     *         to acc's shape (acc is untouched then)
+     */
+    template <typename T>
+    inline bool fma_assign (Tensor<T> & acc, const Tensor<T> & a, const Tensor<T> & b)
+    {
+        if (!TENSOR_MATH::broadcasts_to(a.get_shape(), acc.get_shape()) ||
+            !TENSOR_MATH::broadcasts_to(b.get_shape(), acc.get_shape()))
+            return false;
+        return fma<T>(acc, a, b, acc);
+    }
+    template <typename T>
+    inline bool fma_assign (Tensor<T> & acc, const Tensor<T> & a, typename TENSOR_MATH::Item_type<T>::type b)
+    {
+        if (!TENSOR_MATH::broadcasts_to(a.get_shape(), acc.get_shape()))
+            return false;
+        return fma<T>(acc, a, b, acc);
+    }
+
+} // end of namespace
+
+#endif // _MATH_ELEMENTWISE_HPP_
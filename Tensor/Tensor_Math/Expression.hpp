@@ -0,0 +1,688 @@
+// File: Expression.hpp
+// Description: Lazy element-wise expressions (C++11 expression
+//              templates). Operators on tensors (a * b + c,
+//              relu(x + bias) * 0.5f ...) only build a tree of nodes,
+//              evaluate() runs the whole tree in one pass over the
+//              output: broadcasting and strides are resolved once
+//              (one Elementwise_plan for every tensor of the tree),
+//              items go through the nodes in blocks that stay in the
+//              L1 cache (run kernels, SIMD with BUFFER_ENABLE_SIMD),
+//              no intermediate tensor is allocated.
+// Date: Oct. 17, 2026
+// @ADMINGUOYU
+
+#ifndef _MATH_EXPRESSION_HPP_
+#define _MATH_EXPRESSION_HPP_
+
+#include <cstddef>      // defines: size_t
+#include <cmath>        // std::sqrt(); std::exp(); std::tanh()
+#include <type_traits>  // std::enable_if; std::is_base_of; std::is_same; std::is_arithmetic
+#include "../Tensor.hpp"
+#include "./Elementwise.hpp"
+
+// Items of a block: every node of an expression runs on a block at
+// once, its result stays in a buffer of this size (L1 cache)
+#ifndef TENSOR_EXPRESSION_BLOCK
+    #define TENSOR_EXPRESSION_BLOCK 256
+#endif
+
+namespace ty
+{
+
+    /**
+     * @brief Base of the lazy element-wise expressions (CRTP)
+     * @note Built by the operators / functions at the end of this file
+     *       and run by evaluate(). Nodes keep references to their
+     *       tensors: evaluate an expression before its tensors go away.
+     */
+    template <typename E>
+    struct Expression
+    {
+        const E & self (void) const { return *static_cast<const E *>(this); }
+    };
+
+} // end of namespace
+
+namespace TENSOR_MATH
+{
+
+    // element-wise functions of an expression
+    enum class Unary_op
+    {
+        NEG = 0,        // -x
+        ABS = 1,        // |x|
+        SQRT = 2,       // square root
+        EXP = 3,        // e^x
+        TANH = 4,       // hyperbolic tangent
+        SIGMOID = 5,    // 1 / (1 + e^-x)
+        RELU = 6        // 0 > x ? 0 : x (NaN kept)
+    };
+
+    /**
+     * @brief Applies a function to one item
+     * @param x The item
+     * @param op The function
+     * @return op(x)
+     */
+    template <typename T>
+    inline T apply_unary(T x, Unary_op op)
+    {
+        switch (op)
+        {
+        case Unary_op::NEG: return x * (T)-1;
+        // (+ 0: -0 becomes 0)
+        case Unary_op::ABS: return (x < T()) ? x * (T)-1 : x + T();
+        case Unary_op::SQRT: return (T)std::sqrt(x);
+        case Unary_op::EXP: return (T)std::exp(x);
+        case Unary_op::TANH: return (T)std::tanh(x);
+        case Unary_op::SIGMOID: return (T)1 / ((T)1 + (T)std::exp(x * (T)-1));
+        case Unary_op::RELU: return (T() > x) ? T() : x;
+        }
+        return x;
+    }
+
+    /**
+     * @brief Element-wise function on a run of items: dst = op(src)
+     * @param dst Pointer to the destination items
+     * @param src Pointer to the items
+     * @param count Number of items
+     * @param op The function
+     * @note dst may be src (in-place). NEG / RELU are run kernels against a
+     *       single value (see binary_items()), the others are scalar loops.
+     */
+    template <typename T>
+    inline void unary_items(T * dst, const T * src, size_t count, Unary_op op)
+    {
+        // -x = x * -1, relu(x) = max(x, 0)
+        if (op == Unary_op::NEG || op == Unary_op::RELU)
+        {
+            const T value = (op == Unary_op::NEG) ? (T)-1 : T();
+            binary_items<T>(dst, src, &value, count,
+                            (op == Unary_op::NEG) ? Binary_op::MUL : Binary_op::MAX, SCALAR_B);
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+            dst[i] = apply_unary<T>(src[i], op);
+        // return
+        return;
+    }
+
+    /**
+     * @brief Items of a block (shared by the nodes of an expression)
+     */
+    template <typename T>
+    struct Expression_block
+    {
+        // first item and inner stride of every tensor (order of collect())
+        const T * in[ELEMENTWISE_MAX_OPERANDS - 1];
+        size_t step[ELEMENTWISE_MAX_OPERANDS - 1];
+        // number of items (at most TENSOR_EXPRESSION_BLOCK)
+        size_t count;
+        // node buffers (TENSOR_EXPRESSION_BLOCK items each)
+        T * buffers;
+    };
+
+    // result of a node on a block: count items, or a single value
+    template <typename T>
+    struct Block_items
+    {
+        const T * items;
+        bool single;
+    };
+
+    /*
+        Every node has:
+            item_type                   item type of the tree
+            tensors                     number of tensors of the subtree
+            buffers                     buffers used by the subtree (its
+                                        own result excluded, see eval())
+            collect(list)               lists the tensors of the subtree
+            eval(block, first, buffer, dst)
+                                        runs the subtree on a block: first
+                                        is the index of its first tensor,
+                                        buffer the first buffer it may use,
+                                        dst where a computed result goes
+                                        (a read-only result may be returned
+                                        in place instead)
+    */
+
+    /**
+     * @brief Leaf: a tensor (read through the plan's strides)
+     */
+    template <typename T>
+    struct Tensor_leaf : public ty::Expression<Tensor_leaf<T>>
+    {
+        typedef T item_type;
+        static const size_t tensors = 1;
+        static const size_t buffers = 0;
+
+        const ty::Tensor<T> & tensor;
+
+        explicit Tensor_leaf (const ty::Tensor<T> & tensor) : tensor(tensor) { }
+
+        void collect (const ty::Tensor<T> ** list) const
+        {
+            list[0] = &this->tensor;
+            return;
+        }
+
+        Block_items<T> eval (const Expression_block<T> & block, size_t first, size_t buffer, T * dst) const
+        {
+            (void)buffer;
+            const T * items = block.in[first];
+            const size_t step = block.step[first];
+            // packed or broadcast -> read in place
+            if (step <= 1)
+                return Block_items<T>{ items, step == 0 };
+            // strided -> gathered
+            for (size_t i = 0; i < block.count; ++i)
+                dst[i] = items[i * step];
+            return Block_items<T>{ dst, false };
+        }
+    };
+
+    /**
+     * @brief Leaf: a single value
+     */
+    template <typename T>
+    struct Value_leaf : public ty::Expression<Value_leaf<T>>
+    {
+        typedef T item_type;
+        static const size_t tensors = 0;
+        static const size_t buffers = 0;
+
+        T value;
+
+        explicit Value_leaf (T value) : value(value) { }
+
+        void collect (const ty::Tensor<T> ** list) const
+        {
+            (void)list;
+            return;
+        }
+
+        Block_items<T> eval (const Expression_block<T> & block, size_t first, size_t buffer, T * dst) const
+        {
+            (void)block;
+            (void)first;
+            (void)buffer;
+            (void)dst;
+            return Block_items<T>{ &this->value, true };
+        }
+    };
+
+    /**
+     * @brief Node: element-wise function of an expression
+     * @note The operand is computed into dst, then transformed in place.
+     */
+    template <Unary_op OP, typename X>
+    struct Unary_node : public ty::Expression<Unary_node<OP, X>>
+    {
+        typedef typename X::item_type item_type;
+        static const size_t tensors = X::tensors;
+        static const size_t buffers = X::buffers;
+
+        X operand;
+
+        explicit Unary_node (const X & operand) : operand(operand) { }
+
+        void collect (const ty::Tensor<item_type> ** list) const
+        {
+            this->operand.collect(list);
+            return;
+        }
+
+        Block_items<item_type> eval (const Expression_block<item_type> & block, size_t first,
+                                     size_t buffer, item_type * dst) const
+        {
+            const Block_items<item_type> x = this->operand.eval(block, first, buffer, dst);
+            if (x.single)
+            {
+                dst[0] = apply_unary<item_type>(x.items[0], OP);
+                return Block_items<item_type>{ dst, true };
+            }
+            unary_items<item_type>(dst, x.items, block.count, OP);
+            return Block_items<item_type>{ dst, false };
+        }
+    };
+
+    // runs a binary node on a block (see below, a * b + c is fused)
+    template <Binary_op OP, typename L, typename R>
+    struct Binary_node;
+    template <Binary_op OP, typename L, typename R>
+    inline Block_items<typename L::item_type>
+    eval_binary(const Binary_node<OP, L, R> & node, const Expression_block<typename L::item_type> & block,
+                size_t first, size_t buffer, typename L::item_type * dst);
+
+    /**
+     * @brief Node: element-wise operation of two expressions
+     * @note The right operand is computed first into the node's buffer,
+     *       then the left one into dst.
+     */
+    template <Binary_op OP, typename L, typename R>
+    struct Binary_node : public ty::Expression<Binary_node<OP, L, R>>
+    {
+        typedef typename L::item_type item_type;
+        static const size_t tensors = L::tensors + R::tensors;
+        static const size_t buffers = L::buffers + 1 + R::buffers;
+
+        L left;
+        R right;
+
+        Binary_node (const L & left, const R & right) : left(left), right(right) { }
+
+        void collect (const ty::Tensor<item_type> ** list) const
+        {
+            this->left.collect(list);
+            this->right.collect(list + L::tensors);
+            return;
+        }
+
+        Block_items<item_type> eval (const Expression_block<item_type> & block, size_t first,
+                                     size_t buffer, item_type * dst) const
+        {
+            return eval_binary(*this, block, first, buffer, dst);
+        }
+    };
+
+    /**
+     * @brief Runs a binary node on a block: dst = left op right
+     * @note Single values are copied aside first (dst may hold one).
+     */
+    template <Binary_op OP, typename L, typename R>
+    inline Block_items<typename L::item_type>
+    eval_binary(const Binary_node<OP, L, R> & node, const Expression_block<typename L::item_type> & block,
+                size_t first, size_t buffer, typename L::item_type * dst)
+    {
+        typedef typename L::item_type T;
+        T * const right_dst = block.buffers + buffer * TENSOR_EXPRESSION_BLOCK;
+        const Block_items<T> y = node.right.eval(block, first + L::tensors, buffer + 1, right_dst);
+        const Block_items<T> x = node.left.eval(block, first, buffer + 1 + R::buffers, dst);
+        const T x_value = x.items[0];
+        const T y_value = y.items[0];
+        if (x.single && y.single)
+        {
+            dst[0] = apply_binary<T>(x_value, y_value, OP);
+            return Block_items<T>{ dst, true };
+        }
+        binary_items<T>(dst, x.single ? &x_value : x.items, y.single ? &y_value : y.items, block.count,
+                        OP, (x.single ? SCALAR_A : SCALAR_NONE) | (y.single ? SCALAR_B : SCALAR_NONE));
+        return Block_items<T>{ dst, false };
+    }
+
+    /**
+     * @brief Runs a * b + c on a block (one multiply-add pass, see fma_items())
+     * @note Operands are computed as c, b, a (a into dst).
+     */
+    template <typename A, typename B, typename R>
+    inline Block_items<typename A::item_type>
+    eval_binary(const Binary_node<Binary_op::ADD, Binary_node<Binary_op::MUL, A, B>, R> & node,
+                const Expression_block<typename A::item_type> & block,
+                size_t first, size_t buffer, typename A::item_type * dst)
+    {
+        typedef typename A::item_type T;
+        const size_t b_buffer = buffer + 1 + R::buffers;
+        const Block_items<T> z = node.right.eval(block, first + A::tensors + B::tensors, buffer + 1,
+                                                 block.buffers + buffer * TENSOR_EXPRESSION_BLOCK);
+        const Block_items<T> y = node.left.right.eval(block, first + A::tensors, b_buffer + 1,
+                                                      block.buffers + b_buffer * TENSOR_EXPRESSION_BLOCK);
+        const Block_items<T> x = node.left.left.eval(block, first, b_buffer + 1 + B::buffers, dst);
+        const T x_value = x.items[0];
+        const T y_value = y.items[0];
+        const T z_value = z.items[0];
+        if (x.single && y.single && z.single)
+        {
+            fma_items<T>(dst, &x_value, &y_value, &z_value, 1, SCALAR_NONE);
+            return Block_items<T>{ dst, true };
+        }
+        fma_items<T>(dst, x.single ? &x_value : x.items, y.single ? &y_value : y.items,
+                     z.single ? &z_value : z.items, block.count,
+                     (x.single ? SCALAR_A : SCALAR_NONE) | (y.single ? SCALAR_B : SCALAR_NONE) |
+                     (z.single ? SCALAR_C : SCALAR_NONE));
+        return Block_items<T>{ dst, false };
+    }
+
+    // void if the types exist (no std::void_t in C++11)
+    template <typename... X>
+    struct Expression_void { typedef void type; };
+
+    // operand of an expression: a tensor or a node (other types have no
+    // members: the operators below drop out of overload resolution)
+    template <typename X, typename Enable = void>
+    struct Expression_operand { };
+    template <typename T>
+    struct Expression_operand<ty::Tensor<T>, void>
+    {
+        typedef T item_type;
+        typedef Tensor_leaf<T> node_type;
+        static node_type make (const ty::Tensor<T> & x) { return node_type(x); }
+    };
+    template <typename E>
+    struct Expression_operand<E, typename std::enable_if<std::is_base_of<ty::Expression<E>, E>::value>::type>
+    {
+        typedef typename E::item_type item_type;
+        typedef E node_type;
+        static const E & make (const E & x) { return x; }
+    };
+
+    // operands of a binary node: two tensors / nodes of the same item type,
+    // or one and a single value (converted to the item type)
+    template <typename L, typename R, typename Enable = void>
+    struct Expression_pair { };
+    template <typename L, typename R>
+    struct Expression_pair<L, R, typename std::enable_if<std::is_same<
+        typename Expression_operand<L>::item_type, typename Expression_operand<R>::item_type>::value>::type>
+    {
+        typedef typename Expression_operand<L>::node_type left_type;
+        typedef typename Expression_operand<R>::node_type right_type;
+        template <Binary_op OP> struct node { typedef Binary_node<OP, left_type, right_type> type; };
+        static left_type left (const L & x) { return Expression_operand<L>::make(x); }
+        static right_type right (const R & y) { return Expression_operand<R>::make(y); }
+    };
+    template <typename L, typename R>
+    struct Expression_pair<L, R, typename std::enable_if<std::is_arithmetic<R>::value,
+        typename Expression_void<typename Expression_operand<L>::item_type>::type>::type>
+    {
+        typedef typename Expression_operand<L>::node_type left_type;
+        typedef Value_leaf<typename Expression_operand<L>::item_type> right_type;
+        template <Binary_op OP> struct node { typedef Binary_node<OP, left_type, right_type> type; };
+        static left_type left (const L & x) { return Expression_operand<L>::make(x); }
+        static right_type right (R y) { return right_type((typename right_type::item_type)y); }
+    };
+    template <typename L, typename R>
+    struct Expression_pair<L, R, typename std::enable_if<std::is_arithmetic<L>::value,
+        typename Expression_void<typename Expression_operand<R>::item_type>::type>::type>
+    {
+        typedef Value_leaf<typename Expression_operand<R>::item_type> left_type;
+        typedef typename Expression_operand<R>::node_type right_type;
+        template <Binary_op OP> struct node { typedef Binary_node<OP, left_type, right_type> type; };
+        static left_type left (L x) { return left_type((typename left_type::item_type)x); }
+        static right_type right (const R & y) { return Expression_operand<R>::make(y); }
+    };
+
+    /**
+     * @brief Arguments of an expression run (shared by all parts)
+     */
+    template <typename T, typename E>
+    struct Expression_task
+    {
+        // iteration plan (operand 0 is out, then the tensors of the tree)
+        const Elementwise_plan * plan;
+        // first item of every operand
+        T * out;
+        const T * in[ELEMENTWISE_MAX_OPERANDS - 1];
+        // the tree
+        const E * expression;
+        // out is one of the tensors: results go through a buffer
+        bool aliased;
+    };
+
+    /**
+     * @brief Runs the items [start, end) of an expression
+     * @param task The task (shared by all parts)
+     * @param start First item (logical order of the output)
+     * @param end Last item (not inclusive)
+     * @note Runs along the innermost dimension are cut in blocks of
+     *       TENSOR_EXPRESSION_BLOCK items, the tree runs on one block at
+     *       a time. A packed output is the result buffer of the root
+     *       (unless it is also read by the tree).
+     */
+    template <typename T, typename E>
+    inline void expression_part(const Expression_task<T, E> & task, size_t start, size_t end)
+    {
+        const Elementwise_plan & plan = *task.plan;
+        const size_t dims = plan.dim_count;
+        const size_t last = dims - 1;
+        const size_t inner = plan.shape[last];
+        // node buffers, then the result of the root
+        T buffers[(E::buffers + 1) * TENSOR_EXPRESSION_BLOCK];
+        T * const result = buffers + E::buffers * TENSOR_EXPRESSION_BLOCK;
+        Expression_block<T> block { };
+        block.buffers = buffers;
+        for (size_t k = 0; k < E::tensors; ++k)
+            block.step[k] = plan.strides[k + 1][last];
+        const size_t out_step = plan.strides[0][last];
+        const bool in_place = (out_step == 1 && !task.aliased);
+
+        // index of the first item
+        TENSOR_UTILITIES::DimArray index { };
+        if (!index.allocate(dims))
+            return;
+        index.set_effective_size(dims);
+        size_t rest = start;
+        for (size_t d = dims; d > 0; --d)
+        {
+            index[d - 1] = rest % plan.shape[d - 1];
+            rest /= plan.shape[d - 1];
+        }
+
+        size_t offset[ELEMENTWISE_MAX_OPERANDS];
+        for (size_t pos = start; pos < end; )
+        {
+            // offsets of the run
+            for (size_t k = 0; k < plan.operand_count; ++k)
+            {
+                offset[k] = 0;
+                for (size_t d = 0; d < dims; ++d)
+                    offset[k] += index[d] * plan.strides[k][d];
+            }
+            size_t count = inner - index[last];
+            if (count > end - pos)
+                count = end - pos;
+
+            // blocks of the run
+            for (size_t done = 0; done < count; done += block.count)
+            {
+                block.count = (count - done < TENSOR_EXPRESSION_BLOCK) ? count - done : TENSOR_EXPRESSION_BLOCK;
+                for (size_t k = 0; k < E::tensors; ++k)
+                    block.in[k] = task.in[k] + offset[k + 1] + done * block.step[k];
+                T * out = task.out + offset[0] + done * out_step;
+                const Block_items<T> items = task.expression->eval(block, 0, 0, in_place ? out : result);
+                if (items.items == out && !items.single)
+                    continue;
+                // single value, result buffer or a tensor read in place -> out
+                const T value = items.items[0];
+                if (items.single)
+                    for (size_t i = 0; i < block.count; ++i)
+                        out[i * out_step] = value;
+                else
+                    for (size_t i = 0; i < block.count; ++i)
+                        out[i * out_step] = items.items[i];
+            }
+
+            // next run
+            pos += count;
+            index[last] += count;
+            for (size_t d = last; d > 0 && index[d] == plan.shape[d]; --d)
+            {
+                index[d] = 0;
+                ++index[d - 1];
+            }
+        }
+        // return
+        return;
+    }
+
+    /**
+     * @brief Evaluates an expression into a tensor (driver)
+     * @param out The output tensor
+     * @param expression The tree
+     * @return True if successful, false if the tensors do not broadcast
+     *         together or allocation failed (out is untouched then)
+     * @note out keeps its buffer and layout if it already has the broadcast
+     *       shape (in-place when it is one of the tensors), it is allocated
+     *       (contiguous) otherwise.
+     */
+    template <typename T, typename E>
+    inline bool expression_tensors(ty::Tensor<T> & out, const E & expression)
+    {
+        static_assert(E::tensors > 0 && E::tensors < ELEMENTWISE_MAX_OPERANDS,
+                      "an expression has 1 to ELEMENTWISE_MAX_OPERANDS - 1 tensors");
+        // tensors of the tree and their broadcast shape
+        const ty::Tensor<T> * tensors[ELEMENTWISE_MAX_OPERANDS - 1];
+        expression.collect(tensors);
+        TENSOR_UTILITIES::Shape shape { };
+        if (!broadcast_shape<T>(shape, tensors, E::tensors))
+            return false;
+        bool aliased = false;
+        for (size_t i = 0; i < E::tensors; ++i)
+            aliased = aliased || (tensors[i] == &out);
+
+        // output of another shape
+        if (!same_dims(out.get_shape(), shape))
+        {
+            // output is also an input -> compute aside, then copy
+            if (aliased)
+            {
+                ty::Tensor<T> result { };
+                if (!expression_tensors<T, E>(result, expression))
+                    return false;
+                return result.copy_to(out);
+            }
+            if (!out.allocate_like(shape))
+                return false;
+        }
+
+        // plan
+        const TENSOR_UTILITIES::Shape * shapes[ELEMENTWISE_MAX_OPERANDS - 1];
+        for (size_t i = 0; i < E::tensors; ++i)
+            shapes[i] = &tensors[i]->get_shape();
+        Elementwise_plan plan { };
+        if (!make_elementwise_plan(plan, out.get_shape(), shapes, E::tensors))
+            return false;
+
+        // output first (a shared block is copied before the inputs are read)
+        Expression_task<T, E> task { };
+        task.plan = &plan;
+        task.out = out.raw_data();
+        for (size_t i = 0; i < E::tensors; ++i)
+            task.in[i] = tensors[i]->raw_data();
+        task.expression = &expression;
+        task.aliased = aliased;
+        if (!task.out)
+            return false;
+
+        // each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+#ifdef BUFFER_THREADED_OPERATIONS
+        const size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(T);
+#else
+        const size_t min_items = plan.item_count;
+#endif
+        // run the parts (on the process-wide pool)
+        TENSOR_UTILITIES::parallel_for(0, plan.item_count, min_items,
+            [](size_t start, size_t end, void * task_ptr)
+            {
+                expression_part<T, E>(*(const Expression_task<T, E> *)task_ptr, start, end);
+            },
+            &task);
+        // return
+        return true;
+    }
+}
+
+namespace ty
+{
+
+    /**
+     * @brief Evaluates a lazy element-wise expression: out = expression
+     * @param out The output tensor
+     * @param expression The expression (operators / functions below)
+     * @return True if successful, false if the tensors of the expression
+     *         do not broadcast together (or allocation failed), out is
+     *         untouched then
+     * @note One pass over the output and the tensors, whatever the size
+     *       of the tree: no intermediate tensor, blocks of
+     *       TENSOR_EXPRESSION_BLOCK items go through every node (run
+     *       kernels, SIMD with BUFFER_ENABLE_SIMD). a * b + c runs as one
+     *       multiply-add (fused on CPUs with an FMA unit, see fma()).
+     * @note Broadcasting and output rules are the ones of binary_op(),
+     *       out may be one of the tensors. Up to 7 tensors per expression.
+     * @note Example: evaluate(y, relu(x * w + bias) * 0.5f)
+     */
+    template <typename T, typename E>
+    inline bool evaluate (Tensor<T> & out, const Expression<E> & expression)
+    {
+        static_assert(std::is_same<T, typename E::item_type>::value,
+                      "the output and the expression have the same item type");
+        return TENSOR_MATH::expression_tensors<T, E>(out, expression.self());
+    }
+
+    // lazy a + b, a - b, a * b, a / b, minimum(a, b), maximum(a, b) of tensors,
+    // expressions and single values (see evaluate())
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::ADD>::type
+    operator+ (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::ADD>::type(pair::left(a), pair::right(b));
+    }
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::SUB>::type
+    operator- (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::SUB>::type(pair::left(a), pair::right(b));
+    }
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::MUL>::type
+    operator* (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::MUL>::type(pair::left(a), pair::right(b));
+    }
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::DIV>::type
+    operator/ (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::DIV>::type(pair::left(a), pair::right(b));
+    }
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::MIN>::type
+    minimum (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::MIN>::type(pair::left(a), pair::right(b));
+    }
+    template <typename L, typename R>
+    inline typename TENSOR_MATH::Expression_pair<L, R>::template node<TENSOR_MATH::Binary_op::MAX>::type
+    maximum (const L & a, const R & b)
+    {
+        typedef TENSOR_MATH::Expression_pair<L, R> pair;
+        return typename pair::template node<TENSOR_MATH::Binary_op::MAX>::type(pair::left(a), pair::right(b));
+    }
+
+    // lazy -x, abs(x), sqrt(x), exp(x), tanh(x), sigmoid(x), relu(x) of a tensor
+    // or an expression (see evaluate())
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::NEG, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    operator- (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::NEG, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::ABS, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    abs (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::ABS, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::SQRT, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    sqrt (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::SQRT, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::EXP, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    exp (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::EXP, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::TANH, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    tanh (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::TANH, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::SIGMOID, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    sigmoid (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::SIGMOID, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+    template <typename X>
+    inline TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::RELU, typename TENSOR_MATH::Expression_operand<X>::node_type>
+    relu (const X & x)
+    { return TENSOR_MATH::Unary_node<TENSOR_MATH::Unary_op::RELU, typename TENSOR_MATH::Expression_operand<X>::node_type>(TENSOR_MATH::Expression_operand<X>::make(x)); }
+
+} // end of namespace
+
+#endif // _MATH_EXPRESSION_HPP_
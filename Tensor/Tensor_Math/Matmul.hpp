@@ -0,0 +1,428 @@
+// File: Matmul.hpp
+// Description: Matrix multiplication of tensors (GEMM), batched over
+//              broadcast leading dimensions. Operands are read
+//              through their Shape strides, so a permute()d
+//              (transposed) tensor needs no contiguous() copy. float /
+//              double run the packed, cache-blocked SIMD kernel (small
+//              matrices run unpacked), (matrix x tile) tasks are
+//              split over the threads.
+// Date: Oct. 17, 2026
+// @ADMINGUOYU
+
+#ifndef _MATH_MATMUL_HPP_
+#define _MATH_MATMUL_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <typeinfo> // typeid()
+#include "../Tensor.hpp"
+
+// SIMD GEMM kernels (precompiled SIMD library)
+#ifdef BUFFER_ENABLE_SIMD
+    #include "../SIMD/simd.h"
+#endif // BUFFER_ENABLE_SIMD
+
+namespace TENSOR_MATH
+{
+
+    // rows / columns of the output in one task (multiples of the
+    // micro-tiles of every SIMD level: 6 rows, 2 vectors of columns)
+    const size_t GEMM_ROW_TASK = 144;
+    const size_t GEMM_COLUMN_TASK = 128;
+
+    /**
+     * @brief Matrix multiplication of strided matrices: c = alpha * a x b + beta * c
+     * @param m Rows of a and c
+     * @param n Columns of b and c
+     * @param k Columns of a, rows of b
+     * @param alpha Scale of the product
+     * @param a Item (i, p) at a[i * rs_a + p * cs_a]
+     * @param b Item (p, j) at b[p * rs_b + j * cs_b]
+     * @param beta Scale of c (0: c is overwritten, its items are never read)
+     * @param c Item (i, j) at c[i * rs_c + j * cs_c]
+     * @note With BUFFER_ENABLE_SIMD, float / double use the packed, blocked
+     *       kernel (the scalar loop takes over if its packing buffer cannot
+     *       be allocated), every other type is a scalar loop.
+     */
+    template <typename T>
+    inline void gemm_items(size_t m, size_t n, size_t k, T alpha,
+                           const T * a, size_t rs_a, size_t cs_a,
+                           const T * b, size_t rs_b, size_t cs_b,
+                           T beta, T * c, size_t rs_c, size_t cs_c)
+    {
+// [SIMD] packed, cache-blocked kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        // (c is already scaled by beta if the kernel fails)
+        if (typeid(T) == typeid(float))
+        {
+            if (simd_gemm_float(m, n, k, (float)alpha, (const float *)a, rs_a, cs_a,
+                                (const float *)b, rs_b, cs_b, (float)beta, (float *)c, rs_c, cs_c))
+                return;
+            beta = (T)1;
+        }
+        if (typeid(T) == typeid(double))
+        {
+            if (simd_gemm_double(m, n, k, (double)alpha, (const double *)a, rs_a, cs_a,
+                                 (const double *)b, rs_b, cs_b, (double)beta, (double *)c, rs_c, cs_c))
+                return;
+            beta = (T)1;
+        }
+#endif
+// [NORMAL] scalar loop (i-p-j: the inner loop walks rows of b and c)
+        for (size_t i = 0; i < m; ++i)
+        {
+            T * c_row = c + i * rs_c;
+            for (size_t j = 0; j < n; ++j)
+                c_row[j * cs_c] = (beta == T()) ? T() : beta * c_row[j * cs_c];
+            for (size_t p = 0; p < k; ++p)
+            {
+                const T a_item = alpha * a[i * rs_a + p * cs_a];
+                const T * b_row = b + p * rs_b;
+                for (size_t j = 0; j < n; ++j)
+                    c_row[j * cs_c] += a_item * b_row[j * cs_b];
+            }
+        }
+        // return
+        return;
+    }
+
+    // leading (batch) dimensions of a matrix multiplication
+    struct Batch_plan
+    {
+        TENSOR_UTILITIES::DimArray shape { };       // broadcast sizes
+        TENSOR_UTILITIES::DimArray a_stride { };    // memory strides (0: broadcast)
+        TENSOR_UTILITIES::DimArray b_stride { };
+        TENSOR_UTILITIES::DimArray out_stride { };
+        size_t dims = 0;                            // number of leading dimensions
+        size_t count = 1;                           // number of matrices
+    };
+
+    /**
+     * @brief Leading dimensions of a batched matrix multiplication
+     * @param plan The plan to fill
+     * @param a Shape of the left operand (..., m, k)
+     * @param b Shape of the right operand (..., k, n)
+     * @return True if successful, false if the leading dimensions do not
+     *         broadcast together (or allocation failed)
+     * @note Leading dimensions follow the numpy rules (get_compatible_shapes()),
+     *       a missing or size 1 dimension of an operand has stride 0.
+     *       out_stride is left to the caller (output shape unknown here).
+     */
+    inline bool make_batch_plan(Batch_plan & plan, const TENSOR_UTILITIES::Shape & a,
+                                const TENSOR_UTILITIES::Shape & b)
+    {
+        const size_t a_dims = a.get_dim_count() - 2;
+        const size_t b_dims = b.get_dim_count() - 2;
+        plan.dims = (a_dims > b_dims) ? a_dims : b_dims;
+        plan.count = 1;
+        if (plan.dims == 0)
+            return true;
+        if (!plan.shape.allocate(plan.dims) || !plan.a_stride.allocate(plan.dims) ||
+            !plan.b_stride.allocate(plan.dims) || !plan.out_stride.allocate(plan.dims))
+            return false;
+
+        // broadcast sizes (a 2D operand takes the other's leading sizes)
+        if (a_dims == 0 || b_dims == 0)
+        {
+            const TENSOR_UTILITIES::Shape & lead = (a_dims == 0) ? b : a;
+            for (size_t d = 0; d < plan.dims; ++d)
+                plan.shape[d] = lead.get_shape(d);
+        }
+        else
+        {
+            TENSOR_UTILITIES::DimArray sizes { };
+            if (!sizes.allocate(plan.dims))
+                return false;
+            TENSOR_UTILITIES::Shape a_lead { };
+            TENSOR_UTILITIES::Shape b_lead { };
+            for (size_t d = 0; d < a_dims; ++d)
+                sizes[d] = a.get_shape(d);
+            if (!a_lead.set_shape(sizes.data(), a_dims))
+                return false;
+            for (size_t d = 0; d < b_dims; ++d)
+                sizes[d] = b.get_shape(d);
+            if (!b_lead.set_shape(sizes.data(), b_dims))
+                return false;
+            TENSOR_UTILITIES::Broadcast_result result =
+                TENSOR_UTILITIES::get_compatible_shapes(a_lead, b_lead);
+            if (result.compatible_shape.get_dim_count() != plan.dims)
+                return false;
+            for (size_t d = 0; d < plan.dims; ++d)
+                plan.shape[d] = result.compatible_shape.get_shape(d);
+        }
+
+        // strides (aligned from the last leading dimension)
+        for (size_t d = 0; d < plan.dims; ++d)
+        {
+            plan.count *= plan.shape[d];
+            const size_t skip_a = plan.dims - a_dims;
+            const size_t skip_b = plan.dims - b_dims;
+            plan.a_stride[d] = (d < skip_a || a.get_shape(d - skip_a) == 1) ?
+                               0 : a.get_memory_stride(d - skip_a);
+            plan.b_stride[d] = (d < skip_b || b.get_shape(d - skip_b) == 1) ?
+                               0 : b.get_memory_stride(d - skip_b);
+        }
+        // return
+        return true;
+    }
+
+    /**
+     * @brief Offsets of one matrix of a batch
+     * @param plan The batch plan
+     * @param index Linear index of the matrix (row-major over plan.shape)
+     * @param a_offset, b_offset, out_offset Offsets of the matrix in each tensor
+     */
+    inline void batch_offsets(const Batch_plan & plan, size_t index, size_t & a_offset,
+                              size_t & b_offset, size_t & out_offset)
+    {
+        a_offset = 0;
+        b_offset = 0;
+        out_offset = 0;
+        for (size_t d = plan.dims; d > 0; --d)
+        {
+            const size_t i = index % plan.shape[d - 1];
+            index /= plan.shape[d - 1];
+            a_offset += i * plan.a_stride[d - 1];
+            b_offset += i * plan.b_stride[d - 1];
+            out_offset += i * plan.out_stride[d - 1];
+        }
+        return;
+    }
+
+    // a (batched) matrix multiplication split in blocks of the output
+    template <typename T>
+    struct Gemm_task
+    {
+        const Batch_plan * batch;   // leading dimensions
+        size_t m, n, k;             // sizes (see gemm_items())
+        T alpha, beta;              // scales
+        const T * a;                // operands and their strides
+        size_t rs_a, cs_a;
+        const T * b;
+        size_t rs_b, cs_b;
+        T * c;                      // output and its strides
+        size_t rs_c, cs_c;
+        bool by_rows;               // tiles are GEMM_ROW_TASK rows (else GEMM_COLUMN_TASK columns)
+        size_t tiles;               // tiles of one matrix (task t: matrix t / tiles)
+    };
+
+    /**
+     * @brief Runs the tasks [start, end) of a matrix multiplication
+     * @param task The multiplication
+     * @param start First task
+     * @param end Last task (excluded)
+     * @note The tiles of one matrix in a part run as one block of rows
+     *       (columns): a / b panels are packed once per matrix and part.
+     */
+    template <typename T>
+    inline void gemm_part(const Gemm_task<T> & task, size_t start, size_t end)
+    {
+        size_t a_offset = 0;
+        size_t b_offset = 0;
+        size_t c_offset = 0;
+        for (size_t t = start; t < end; )
+        {
+            const size_t matrix = t / task.tiles;
+            const size_t last = ((matrix + 1) * task.tiles < end) ? (matrix + 1) * task.tiles : end;
+            const size_t first_tile = t - matrix * task.tiles;
+            const size_t end_tile = last - matrix * task.tiles;
+            batch_offsets(*task.batch, matrix, a_offset, b_offset, c_offset);
+            const T * a = task.a + a_offset;
+            const T * b = task.b + b_offset;
+            T * c = task.c + c_offset;
+            if (task.by_rows)
+            {
+                const size_t first = first_tile * GEMM_ROW_TASK;
+                const size_t rows_end = (end_tile * GEMM_ROW_TASK < task.m) ? end_tile * GEMM_ROW_TASK : task.m;
+                gemm_items<T>(rows_end - first, task.n, task.k, task.alpha,
+                              a + first * task.rs_a, task.rs_a, task.cs_a,
+                              b, task.rs_b, task.cs_b,
+                              task.beta, c + first * task.rs_c, task.rs_c, task.cs_c);
+            }
+            else
+            {
+                const size_t first = first_tile * GEMM_COLUMN_TASK;
+                const size_t cols_end = (end_tile * GEMM_COLUMN_TASK < task.n) ? end_tile * GEMM_COLUMN_TASK : task.n;
+                gemm_items<T>(task.m, cols_end - first, task.k, task.alpha,
+                              a, task.rs_a, task.cs_a,
+                              b + first * task.cs_b, task.rs_b, task.cs_b,
+                              task.beta, c + first * task.cs_c, task.rs_c, task.cs_c);
+            }
+            t = last;
+        }
+        // return
+        return;
+    }
+
+    /**
+     * @brief (Batched) matrix multiplication of tensors (driver):
+     *        out = alpha * a x b + beta * out, matrix by matrix
+     * @param out The output tensor (..., m, n)
+     * @param a The left operand (..., m, k)
+     * @param b The right operand (..., k, n)
+     * @param alpha Scale of the product
+     * @param beta Scale of out (0: out is overwritten)
+     * @return True if successful, false if a / b have less than 2
+     *         dimensions, are empty, their matrices do not match or their
+     *         leading dimensions do not broadcast, if beta is not 0 and out
+     *         does not have the result shape, or if allocation failed
+     * @note The last 2 dimensions are the matrices, leading dimensions are
+     *       broadcast (numpy rules). Every operand is read through its Shape
+     *       strides (any layout). out keeps its buffer and layout if it has
+     *       the result shape, otherwise it is allocated (contiguous).
+     *       out may be a or b.
+     * @note Work is (matrix x tile) tasks: many small matrices and a few
+     *       large ones are both spread over the threads.
+     */
+    template <typename T>
+    inline bool gemm_tensors(ty::Tensor<T> & out, const ty::Tensor<T> & a, const ty::Tensor<T> & b,
+                             T alpha, T beta)
+    {
+        const TENSOR_UTILITIES::Shape & a_shape = a.get_shape();
+        const TENSOR_UTILITIES::Shape & b_shape = b.get_shape();
+        const size_t a_dims = a_shape.get_dim_count();
+        const size_t b_dims = b_shape.get_dim_count();
+        if (a_dims < 2 || b_dims < 2 ||
+            a_shape.get_item_count() == 0 || b_shape.get_item_count() == 0 ||
+            a_shape.get_shape(a_dims - 1) != b_shape.get_shape(b_dims - 2))
+            return false;
+        const size_t m = a_shape.get_shape(a_dims - 2);
+        const size_t k = a_shape.get_shape(a_dims - 1);
+        const size_t n = b_shape.get_shape(b_dims - 1);
+
+        // leading dimensions
+        Batch_plan batch { };
+        if (!make_batch_plan(batch, a_shape, b_shape))
+            return false;
+        const size_t dims = batch.dims + 2;
+        TENSOR_UTILITIES::DimArray result_shape { };
+        if (!result_shape.allocate(dims))
+            return false;
+        for (size_t d = 0; d < batch.dims; ++d)
+            result_shape[d] = batch.shape[d];
+        result_shape[dims - 2] = m;
+        result_shape[dims - 1] = n;
+
+        // output of the right shape?
+        const TENSOR_UTILITIES::Shape & out_shape = out.get_shape();
+        bool out_fits = (out_shape.get_dim_count() == dims);
+        for (size_t d = 0; out_fits && d < dims; ++d)
+            out_fits = (out_shape.get_shape(d) == result_shape[d]);
+        if (beta != T() && !out_fits)
+            return false;
+        // output is also an input -> compute aside, then copy
+        if (&out == &a || &out == &b)
+        {
+            ty::Tensor<T> result { };
+            if (beta != T() && !out.copy_to(result))
+                return false;
+            if (!gemm_tensors<T>(result, a, b, alpha, beta))
+                return false;
+            return result.copy_to(out);
+        }
+        if (!out_fits && !out.allocate(result_shape.data(), dims))
+            return false;
+        for (size_t d = 0; d < batch.dims; ++d)
+            batch.out_stride[d] = out.get_shape().get_memory_stride(d);
+
+        // output first (a shared block is copied before the inputs are read)
+        Gemm_task<T> task { };
+        task.batch = &batch;
+        task.m = m;
+        task.n = n;
+        task.k = k;
+        task.alpha = alpha;
+        task.beta = beta;
+        task.c = out.raw_data();
+        task.rs_c = out.get_shape().get_memory_stride(dims - 2);
+        task.cs_c = out.get_shape().get_memory_stride(dims - 1);
+        task.a = a.raw_data();
+        task.rs_a = a_shape.get_memory_stride(a_dims - 2);
+        task.cs_a = a_shape.get_memory_stride(a_dims - 1);
+        task.b = b.raw_data();
+        task.rs_b = b_shape.get_memory_stride(b_dims - 2);
+        task.cs_b = b_shape.get_memory_stride(b_dims - 1);
+        if (!task.c)
+            return false;
+
+        // tiles: split the side that gives more of them
+        const size_t row_tiles = (m + GEMM_ROW_TASK - 1) / GEMM_ROW_TASK;
+        const size_t column_tiles = (n + GEMM_COLUMN_TASK - 1) / GEMM_COLUMN_TASK;
+        task.by_rows = (row_tiles >= column_tiles);
+        task.tiles = task.by_rows ? row_tiles : column_tiles;
+        const size_t tasks = batch.count * task.tiles;
+        // each part touches at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+        // (a / b / out items of a tile)
+#ifdef BUFFER_THREADED_OPERATIONS
+        const size_t rows = (task.by_rows && m > GEMM_ROW_TASK) ? GEMM_ROW_TASK : m;
+        const size_t cols = (!task.by_rows && n > GEMM_COLUMN_TASK) ? GEMM_COLUMN_TASK : n;
+        const size_t task_bytes = (rows * k + k * cols + rows * cols) * sizeof(T);
+        const size_t min_tasks = (BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD + task_bytes - 1) / task_bytes;
+#else
+        const size_t min_tasks = tasks;
+#endif
+        // run the parts (on the process-wide pool)
+        TENSOR_UTILITIES::parallel_for(0, tasks, min_tasks,
+            [](size_t start, size_t end, void * task_ptr)
+            {
+                gemm_part<T>(*(const Gemm_task<T> *)task_ptr, start, end);
+            },
+            &task);
+        // return
+        return true;
+    }
+}
+
+namespace ty
+{
+
+    /**
+     * @brief Matrix multiplication of tensors: out = a x b
+     * @param out The output tensor (..., m, n)
+     * @param a The left operand (..., m, k)
+     * @param b The right operand (..., k, n)
+     * @return True if successful, false if a / b have less than 2
+     *         dimensions, are empty, their inner sizes differ or their
+     *         leading dimensions do not broadcast (or allocation failed)
+     * @note The last 2 dimensions are multiplied as matrices, leading
+     *       dimensions are a batch broadcast with the numpy rules:
+     *       (2, 3, m, k) x (3, k, n) -> (2, 3, m, n), (m, k) x (8, k, n) -> (8, m, n).
+     * @note Operands are read through their strides: a permute()d
+     *       (transposed) or broadcast operand is multiplied without a copy.
+     * @note out keeps its buffer and layout if it has the result shape
+     *       already, otherwise it is allocated (contiguous). out may be a or b.
+     * @note float / double (BUFFER_ENABLE_SIMD) run the packed, cache-blocked
+     *       kernel (small matrices unpacked), (matrix x block of output rows
+     *       (columns)) tasks run on the threads.
+     *       Every item is computed by one thread in a fixed order.
+     */
+    template <typename T>
+    inline bool matmul (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b)
+    {
+        return TENSOR_MATH::gemm_tensors<T>(out, a, b, (T)1, T());
+    }
+
+    /**
+     * @brief General matrix multiplication: out = alpha * a x b + beta * out
+     * @param out The output tensor (..., m, n), already of the result
+     *            shape if beta is not 0
+     * @param a The left operand (..., m, k)
+     * @param b The right operand (..., k, n)
+     * @param alpha Scale of the product
+     * @param beta Scale of out (0: out is overwritten, its items are never read)
+     * @return True if successful, false otherwise (see matmul(), also if
+     *         beta is not 0 and out does not have the result shape)
+     * @see matmul()
+     */
+    template <typename T>
+    inline bool gemm (Tensor<T> & out, const Tensor<T> & a, const Tensor<T> & b,
+                      typename TENSOR_MATH::Item_type<T>::type alpha = 1,
+                      typename TENSOR_MATH::Item_type<T>::type beta = 0)
+    {
+        return TENSOR_MATH::gemm_tensors<T>(out, a, b, alpha, beta);
+    }
+
+} // end of namespace
+
+#endif // _MATH_MATMUL_HPP_
@@ -0,0 +1,910 @@
+// File: Reduction.hpp
+// Description: Reductions along axes (sum / mean / max / min /
+//              L2 norm / arg-max / arg-min) built on Shape strides.
+//              Reducing the innermost (contiguous) axis runs the
+//              pairwise SIMD kernel per output item, reducing an
+//              outer (strided) axis walks whole rows in column tiles.
+//              Work is split over the kept dimensions, every output
+//              item is computed in a fixed order: results do not
+//              depend on the thread count.
+// Date: Oct. 17, 2026
+// @ADMINGUOYU
+
+#ifndef _MATH_REDUCTION_HPP_
+#define _MATH_REDUCTION_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdlib>  // malloc(); free()
+#include <cmath>    // std::sqrt()
+#include <typeinfo> // typeid()
+#include "../Tensor.hpp"
+
+// SIMD reduction kernels (precompiled SIMD library)
+#ifdef BUFFER_ENABLE_SIMD
+    #include "../SIMD/simd.h"
+#endif // BUFFER_ENABLE_SIMD
+
+// A reduction of a single contiguous run longer than this (in items) is
+// split in fixed chunks reduced in parallel, then combined pairwise
+// (fixed chunks: the result does not depend on the thread count)
+#ifndef TENSOR_REDUCE_CHUNK
+    #define TENSOR_REDUCE_CHUNK (64 * 1024)
+#endif
+
+namespace TENSOR_MATH
+{
+
+    // reductions (same values as simd_reduce_op)
+    enum class Reduce_op
+    {
+        SUM = 0,            // sum of the items
+        SUM_SQUARES = 1,    // sum of the squared items
+        MAX = 2,            // greatest item
+        MIN = 3             // smallest item
+    };
+
+    // last step applied to every reduced item
+    enum class Reduce_finish
+    {
+        NONE = 0,   // as is
+        MEAN = 1,   // divided by the number of reduced items
+        SQRT = 2    // square root (L2 norm of a sum of squares)
+    };
+
+    // leaf size of the pairwise sums (same as SIMD_REDUCE_BLOCK)
+    const size_t REDUCE_BLOCK = 256;
+    // rows of a leaf / levels of the row-wise pairwise sums
+    // (same as SIMD_REDUCE_ROWS_BLOCK, SIMD_REDUCE_ROWS_LEVELS)
+    const size_t REDUCE_ROWS_BLOCK = 64;
+    const size_t REDUCE_ROWS_LEVELS = 48;
+    // columns of a tile of the row-wise reductions (does not change results)
+    const size_t REDUCE_ROWS_TILE = 64;
+    // columns of a task of an outer axis reduction
+    const size_t REDUCE_COLUMN_TASK = 512;
+
+    /**
+     * @brief Adds one item to a reduction
+     * @param acc The accumulator (updated)
+     * @param x The item
+     * @param op The reduction
+     */
+    template <typename T>
+    inline void reduce_item(T & acc, T x, Reduce_op op)
+    {
+        switch (op)
+        {
+        case Reduce_op::SUM: acc += x; break;
+        case Reduce_op::SUM_SQUARES: acc += x * x; break;
+        case Reduce_op::MAX: if (x > acc) acc = x; break;
+        case Reduce_op::MIN: if (x < acc) acc = x; break;
+        }
+        return;
+    }
+
+    /**
+     * @brief Merges two partial results of a reduction
+     * @note Partial sums of squares are added (not squared again)
+     */
+    template <typename T>
+    inline void reduce_merge(T & acc, T partial, Reduce_op op)
+    {
+        reduce_item<T>(acc, partial, (op == Reduce_op::SUM_SQUARES) ? Reduce_op::SUM : op);
+        return;
+    }
+
+    /**
+     * @brief Reduces a run of contiguous items
+     * @param src Pointer to the items
+     * @param count Number of items (0 gives T())
+     * @param op The reduction
+     * @return The sum / sum of squares / greatest / smallest item
+     * @note Sums are pairwise (leaves of REDUCE_BLOCK items), the
+     *       order only depends on count.
+     * @note With BUFFER_ENABLE_SIMD, float / double / int use the
+     *       vectorized kernels, every other type is a scalar loop.
+     */
+    template <typename T>
+    inline T reduce_items(const T * src, size_t count, Reduce_op op)
+    {
+// [SIMD] vectorized kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        const simd_reduce_op simd_op = (simd_reduce_op)op;
+        if (typeid(T) == typeid(float))
+            return (T)simd_reduce_float((const float *)src, count, simd_op);
+        if (typeid(T) == typeid(double))
+            return (T)simd_reduce_double((const double *)src, count, simd_op);
+        if (typeid(T) == typeid(int))
+            return (T)simd_reduce_int((const int *)src, count, simd_op);
+#endif
+// [NORMAL] scalar loop (same tree)
+        if (count == 0)
+            return T();
+        if (op == Reduce_op::MAX || op == Reduce_op::MIN)
+        {
+            T best = src[0];
+            for (size_t i = 1; i < count; ++i)
+                reduce_item<T>(best, src[i], op);
+            return best;
+        }
+        if (count > REDUCE_BLOCK)
+        {
+            const size_t half = ((count / REDUCE_BLOCK + 1) / 2) * REDUCE_BLOCK;
+            return reduce_items<T>(src, half, op) + reduce_items<T>(src + half, count - half, op);
+        }
+        T total = T();
+        for (size_t i = 0; i < count; ++i)
+            reduce_item<T>(total, src[i], op);
+        // return
+        return total;
+    }
+
+    /**
+     * @brief Arg-max / arg-min of a run of contiguous items
+     * @param src Pointer to the items
+     * @param count Number of items (0 gives 0)
+     * @param op MAX or MIN
+     * @return Index of the first greatest / smallest item
+     */
+    template <typename T>
+    inline size_t argreduce_items(const T * src, size_t count, Reduce_op op)
+    {
+// [SIMD] vectorized kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        const simd_reduce_op simd_op = (simd_reduce_op)op;
+        if (typeid(T) == typeid(float))
+            return simd_argreduce_float((const float *)src, count, simd_op);
+        if (typeid(T) == typeid(double))
+            return simd_argreduce_double((const double *)src, count, simd_op);
+        if (typeid(T) == typeid(int))
+            return simd_argreduce_int((const int *)src, count, simd_op);
+#endif
+// [NORMAL] scalar loop
+        size_t best = 0;
+        for (size_t i = 1; i < count; ++i)
+            if ((op == Reduce_op::MAX) ? (src[i] > src[best]) : (src[i] < src[best]))
+                best = i;
+        // return
+        return best;
+    }
+
+    /**
+     * @brief Row-wise reduction: dst[j] = reduction of src[i * row_stride + j] over rows i
+     * @param dst Pointer to the destination (cols items)
+     * @param src Pointer to the first row
+     * @param rows Number of rows (0 leaves dst untouched)
+     * @param cols Number of columns
+     * @param row_stride Distance between two rows (in items)
+     * @param op The reduction
+     * @param accumulate False to overwrite dst, true to merge with it
+     * @note Rows are read as contiguous runs in column tiles. Sums are
+     *       pairwise over leaves of REDUCE_ROWS_BLOCK rows (binary counter),
+     *       the order only depends on rows.
+     */
+    template <typename T>
+    inline void reduce_rows(T * dst, const T * src, size_t rows, size_t cols, size_t row_stride,
+                            Reduce_op op, bool accumulate)
+    {
+// [SIMD] vectorized kernels
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        const simd_reduce_op simd_op = (simd_reduce_op)op;
+        if (typeid(T) == typeid(float))
+            { simd_reduce_rows_float((float *)dst, (const float *)src, rows, cols, row_stride, simd_op, accumulate); return; }
+        if (typeid(T) == typeid(double))
+            { simd_reduce_rows_double((double *)dst, (const double *)src, rows, cols, row_stride, simd_op, accumulate); return; }
+        if (typeid(T) == typeid(int))
+            { simd_reduce_rows_int((int *)dst, (const int *)src, rows, cols, row_stride, simd_op, accumulate); return; }
+#endif
+// [NORMAL] scalar loops (same tree)
+        if (rows == 0)
+            return;
+        for (size_t c0 = 0; c0 < cols; c0 += REDUCE_ROWS_TILE)
+        {
+            const size_t width = (cols - c0 < REDUCE_ROWS_TILE) ? cols - c0 : REDUCE_ROWS_TILE;
+            const T * base = src + c0;
+            T * out = dst + c0;
+            T acc[REDUCE_ROWS_TILE];
+            // max / min: running best of the tile
+            if (op == Reduce_op::MAX || op == Reduce_op::MIN)
+            {
+                for (size_t j = 0; j < width; ++j)
+                    acc[j] = base[j];
+                for (size_t r = 1; r < rows; ++r)
+                    for (size_t j = 0; j < width; ++j)
+                        reduce_item<T>(acc[j], base[r * row_stride + j], op);
+            }
+            // sums: leaves of rows, merged pairwise (binary counter)
+            else
+            {
+                T levels[REDUCE_ROWS_LEVELS][REDUCE_ROWS_TILE];
+                size_t leaves = 0;
+                for (size_t r0 = 0; r0 < rows; r0 += REDUCE_ROWS_BLOCK, ++leaves)
+                {
+                    const size_t r1 = (rows - r0 < REDUCE_ROWS_BLOCK) ? rows : r0 + REDUCE_ROWS_BLOCK;
+                    for (size_t j = 0; j < width; ++j)
+                        acc[j] = T();
+                    for (size_t r = r0; r < r1; ++r)
+                        for (size_t j = 0; j < width; ++j)
+                            reduce_item<T>(acc[j], base[r * row_stride + j], op);
+                    // carry: merge with the leaves of equal weight
+                    size_t count = leaves, level = 0;
+                    for (; count & 1; count >>= 1, ++level)
+                        for (size_t j = 0; j < width; ++j)
+                            acc[j] = levels[level][j] + acc[j];
+                    for (size_t j = 0; j < width; ++j)
+                        levels[level][j] = acc[j];
+                }
+                // remaining levels, lightest first
+                bool first = true;
+                for (size_t level = 0; level < REDUCE_ROWS_LEVELS; ++level)
+                {
+                    if (!((leaves >> level) & 1))
+                        continue;
+                    for (size_t j = 0; j < width; ++j)
+                        acc[j] = first ? levels[level][j] : levels[level][j] + acc[j];
+                    first = false;
+                }
+            }
+            for (size_t j = 0; j < width; ++j)
+            {
+                if (accumulate)
+                    reduce_merge<T>(out[j], acc[j], op);
+                else
+                    out[j] = acc[j];
+            }
+        }
+        // return
+        return;
+    }
+
+    /**
+     * @brief Applies the last step of a reduction to one item
+     * @param value The reduced item
+     * @param finish The last step
+     * @param count Number of reduced items (MEAN)
+     */
+    template <typename T>
+    inline T reduce_finish(T value, Reduce_finish finish, size_t count)
+    {
+        switch (finish)
+        {
+        case Reduce_finish::MEAN: return (T)(value / (T)count);
+        case Reduce_finish::SQRT: return (T)std::sqrt(value);
+        default: return value;
+        }
+    }
+
+    /**
+     * @brief Iteration plan of a reduction
+     * @note Size 1 dimensions are dropped, neighbouring kept (or reduced)
+     *       dimensions that are contiguous in memory are merged. The kept
+     *       / reduced dimension with the smallest source stride goes last
+     *       (innermost). Both lists hold at least one dimension (size 1,
+     *       stride 0 if there is nothing).
+     */
+    struct Reduce_plan
+    {
+        // kept dimensions: size, source stride, output stride
+        size_t kept_count {0};
+        TENSOR_UTILITIES::DimArray kept_shape { };
+        TENSOR_UTILITIES::DimArray kept_stride { };
+        TENSOR_UTILITIES::DimArray out_stride { };
+        // reduced dimensions: size, source stride
+        size_t reduced_count {0};
+        TENSOR_UTILITIES::DimArray reduced_shape { };
+        TENSOR_UTILITIES::DimArray reduced_stride { };
+        // number of output items / reduced items per output item
+        size_t out_items {1};
+        size_t reduce_items {1};
+    };
+
+    /**
+     * @brief Moves the dimension with the smallest stride to the end
+     */
+    inline void reduce_plan_innermost(TENSOR_UTILITIES::DimArray & shape, TENSOR_UTILITIES::DimArray & stride,
+                                      TENSOR_UTILITIES::DimArray * other, size_t count)
+    {
+        size_t inner = count - 1;
+        for (size_t d = 0; d < count; ++d)
+            if (stride[d] < stride[inner])
+                inner = d;
+        if (inner == count - 1)
+            return;
+        size_t tmp = shape[inner]; shape[inner] = shape[count - 1]; shape[count - 1] = tmp;
+        tmp = stride[inner]; stride[inner] = stride[count - 1]; stride[count - 1] = tmp;
+        if (other)
+        {
+            tmp = (*other)[inner]; (*other)[inner] = (*other)[count - 1]; (*other)[count - 1] = tmp;
+        }
+        return;
+    }
+
+    /**
+     * @brief Builds the plan of a reduction
+     * @param plan The plan to fill
+     * @param in Shape of the source
+     * @param reduced Flags (one per dimension of in), non-zero for a reduced one
+     * @return True if successful, false otherwise (allocation failure)
+     * @note The output is contiguous, its items are the kept dimensions in order.
+     */
+    inline bool make_reduce_plan(Reduce_plan & plan, const TENSOR_UTILITIES::Shape & in, const size_t * reduced)
+    {
+        const size_t dims = in.get_dim_count();
+        if (dims == 0)
+            return false;
+        if (!plan.kept_shape.allocate(dims) || !plan.kept_stride.allocate(dims) ||
+            !plan.out_stride.allocate(dims) || !plan.reduced_shape.allocate(dims) ||
+            !plan.reduced_stride.allocate(dims))
+            return false;
+
+        // output strides of the kept dimensions (contiguous output)
+        size_t out_stride = 1;
+        for (size_t d = dims; d > 0; --d)
+        {
+            plan.out_stride[d - 1] = out_stride;
+            if (!reduced[d - 1])
+                out_stride *= in.get_shape(d - 1);
+        }
+
+        size_t kept = 0, red = 0;
+        plan.out_items = 1;
+        plan.reduce_items = 1;
+        for (size_t d = 0; d < dims; ++d)
+        {
+            const size_t n = in.get_shape(d);
+            const size_t stride = in.get_memory_stride(d);
+            // size 1 dimensions never move the offsets
+            if (n == 1)
+                continue;
+            if (reduced[d])
+            {
+                plan.reduce_items *= n;
+                // merge with the previous reduced dimension
+                if (red > 0 && plan.reduced_stride[red - 1] == stride * n)
+                {
+                    plan.reduced_shape[red - 1] *= n;
+                    plan.reduced_stride[red - 1] = stride;
+                    continue;
+                }
+                plan.reduced_shape[red] = n;
+                plan.reduced_stride[red] = stride;
+                ++red;
+            }
+            else
+            {
+                plan.out_items *= n;
+                const size_t o_stride = plan.out_stride[d];
+                // merge with the previous kept dimension
+                if (kept > 0 && plan.kept_stride[kept - 1] == stride * n &&
+                    plan.out_stride[kept - 1] == o_stride * n)
+                {
+                    plan.kept_shape[kept - 1] *= n;
+                    plan.kept_stride[kept - 1] = stride;
+                    plan.out_stride[kept - 1] = o_stride;
+                    continue;
+                }
+                plan.kept_shape[kept] = n;
+                plan.kept_stride[kept] = stride;
+                plan.out_stride[kept] = o_stride;
+                ++kept;
+            }
+        }
+        // nothing kept / reduced -> a single size 1 dimension
+        if (kept == 0)
+        {
+            plan.kept_shape[0] = 1;
+            plan.kept_stride[0] = 0;
+            plan.out_stride[0] = 0;
+            kept = 1;
+        }
+        if (red == 0)
+        {
+            plan.reduced_shape[0] = 1;
+            plan.reduced_stride[0] = 0;
+            red = 1;
+        }
+        // innermost dimensions last
+        reduce_plan_innermost(plan.kept_shape, plan.kept_stride, &plan.out_stride, kept);
+        reduce_plan_innermost(plan.reduced_shape, plan.reduced_stride, nullptr, red);
+        // set effective sizes
+        plan.kept_count = kept;
+        plan.reduced_count = red;
+        plan.kept_shape.set_effective_size(kept);
+        plan.kept_stride.set_effective_size(kept);
+        plan.out_stride.set_effective_size(kept);
+        plan.reduced_shape.set_effective_size(red);
+        plan.reduced_stride.set_effective_size(red);
+        // return
+        return true;
+    }
+
+    /**
+     * @brief Offsets of a linear index over the first dims dimensions
+     * @param index Linear index (row-major over shape[0 .. dims))
+     * @param shape Size of each dimension
+     * @param dims Number of dimensions to use
+     * @param stride1 First stride array (offset1)
+     * @param stride2 Second stride array (offset2, may be nullptr)
+     */
+    inline void reduce_offsets(size_t index, const TENSOR_UTILITIES::DimArray & shape, size_t dims,
+                               const TENSOR_UTILITIES::DimArray & stride1, size_t & offset1,
+                               const TENSOR_UTILITIES::DimArray * stride2, size_t & offset2)
+    {
+        offset1 = 0;
+        offset2 = 0;
+        for (size_t d = dims; d > 0; --d)
+        {
+            const size_t i = index % shape[d - 1];
+            index /= shape[d - 1];
+            offset1 += i * stride1[d - 1];
+            if (stride2)
+                offset2 += i * (*stride2)[d - 1];
+        }
+        return;
+    }
+
+    // how the items of a reduction are walked
+    enum class Reduce_path
+    {
+        INNER,      // reduced innermost dimension is contiguous (per output item runs)
+        OUTER,      // kept innermost dimension is contiguous (row-wise, column tiles)
+        CHUNKED,    // a single long contiguous run (fixed chunks, merged pairwise)
+        GENERIC     // anything else (strided scalar loops)
+    };
+
+    /**
+     * @brief Arguments of a reduction (shared by all parts)
+     * @note R is T, or size_t for arg-max / arg-min
+     */
+    template <typename T, typename R>
+    struct Reduce_task
+    {
+        const Reduce_plan * plan;
+        const T * src;
+        R * dst;
+        Reduce_op op;
+        Reduce_finish finish;
+        // arg-max / arg-min (dst holds indexes)
+        bool arg;
+        // OUTER: column tasks per outer kept item
+        size_t column_tasks;
+        // CHUNKED: partial results of every chunk
+        T * partials;
+        size_t * partial_indexes;
+    };
+
+    /**
+     * @brief Runs the tasks [start, end) of a reduction
+     * @param task The task (shared by all parts)
+     * @param path How items are walked
+     * @param start First task (INNER / GENERIC: output item, OUTER: column
+     *        task, CHUNKED: chunk)
+     * @param end Last task (not inclusive)
+     */
+    template <typename T, typename R>
+    inline void reduce_part(const Reduce_task<T, R> & task, Reduce_path path, size_t start, size_t end)
+    {
+        const Reduce_plan & plan = *task.plan;
+        const size_t kept_last = plan.kept_count - 1;
+        const size_t red_last = plan.reduced_count - 1;
+        const size_t inner = plan.reduced_shape[red_last];
+        const size_t inner_stride = plan.reduced_stride[red_last];
+        // runs of the innermost reduced dimension per output item
+        const size_t runs = plan.reduce_items / inner;
+        size_t in_offset = 0, out_offset = 0, run_offset = 0, unused = 0;
+
+        switch (path)
+        {
+        // per output item: pairwise kernel over every run, runs merged in order
+        case Reduce_path::INNER:
+            for (size_t o = start; o < end; ++o)
+            {
+                reduce_offsets(o, plan.kept_shape, plan.kept_count, plan.kept_stride, in_offset,
+                               &plan.out_stride, out_offset);
+                const T * base = task.src + in_offset;
+                if (task.arg)
+                {
+                    task.dst[out_offset] = (R)argreduce_items<T>(base, inner, task.op);
+                    continue;
+                }
+                T acc = T();
+                for (size_t r = 0; r < runs; ++r)
+                {
+                    reduce_offsets(r, plan.reduced_shape, red_last, plan.reduced_stride, run_offset,
+                                   nullptr, unused);
+                    const T value = reduce_items<T>(base + run_offset, inner, task.op);
+                    if (r == 0)
+                        acc = value;
+                    else
+                        reduce_merge<T>(acc, value, task.op);
+                }
+                task.dst[out_offset] = (R)reduce_finish<T>(acc, task.finish, plan.reduce_items);
+            }
+            break;
+
+        // per column task: whole rows of the tile, other reduced runs accumulated in order
+        case Reduce_path::OUTER:
+        {
+            const size_t columns = plan.kept_shape[kept_last];
+            for (size_t t = start; t < end; ++t)
+            {
+                const size_t outer = t / task.column_tasks;
+                const size_t c0 = (t % task.column_tasks) * REDUCE_COLUMN_TASK;
+                const size_t width = (columns - c0 < REDUCE_COLUMN_TASK) ? columns - c0 : REDUCE_COLUMN_TASK;
+                reduce_offsets(outer, plan.kept_shape, kept_last, plan.kept_stride, in_offset,
+                               &plan.out_stride, out_offset);
+                const T * base = task.src + in_offset + c0;
+                R * out = task.dst + out_offset + c0;
+                // arg: running best of the tile (single reduced dimension)
+                if (task.arg)
+                {
+                    T best[REDUCE_COLUMN_TASK];
+                    const bool greater = (task.op == Reduce_op::MAX);
+                    for (size_t j = 0; j < width; ++j)
+                    {
+                        best[j] = base[j];
+                        out[j] = 0;
+                    }
+                    for (size_t i = 1; i < inner; ++i)
+                    {
+                        const T * row = base + i * inner_stride;
+                        for (size_t j = 0; j < width; ++j)
+                            if (greater ? (row[j] > best[j]) : (row[j] < best[j]))
+                            {
+                                best[j] = row[j];
+                                out[j] = (R)i;
+                            }
+                    }
+                    continue;
+                }
+                for (size_t r = 0; r < runs; ++r)
+                {
+                    reduce_offsets(r, plan.reduced_shape, red_last, plan.reduced_stride, run_offset,
+                                   nullptr, unused);
+                    reduce_rows<T>((T *)out, base + run_offset, inner, width, inner_stride, task.op, r > 0);
+                }
+                if (task.finish != Reduce_finish::NONE)
+                    for (size_t j = 0; j < width; ++j)
+                        out[j] = (R)reduce_finish<T>((T)out[j], task.finish, plan.reduce_items);
+            }
+            break;
+        }
+
+        // per chunk of the single run: partial result
+        case Reduce_path::CHUNKED:
+            for (size_t c = start; c < end; ++c)
+            {
+                const size_t first = c * TENSOR_REDUCE_CHUNK;
+                const size_t count = (inner - first < TENSOR_REDUCE_CHUNK) ? inner - first : TENSOR_REDUCE_CHUNK;
+                if (task.arg)
+                    task.partial_indexes[c] = first + argreduce_items<T>(task.src + first, count, task.op);
+                else
+                    task.partials[c] = reduce_items<T>(task.src + first, count, task.op);
+            }
+            break;
+
+        // per output item: every reduced item in order
+        case Reduce_path::GENERIC:
+            for (size_t o = start; o < end; ++o)
+            {
+                reduce_offsets(o, plan.kept_shape, plan.kept_count, plan.kept_stride, in_offset,
+                               &plan.out_stride, out_offset);
+                const T * base = task.src + in_offset;
+                T acc = T();
+                size_t best = 0;
+                for (size_t r = 0; r < plan.reduce_items; ++r)
+                {
+                    reduce_offsets(r, plan.reduced_shape, plan.reduced_count, plan.reduced_stride, run_offset,
+                                   nullptr, unused);
+                    const T value = base[run_offset];
+                    if (task.arg)
+                    {
+                        if (r == 0 || ((task.op == Reduce_op::MAX) ? (value > acc) : (value < acc)))
+                        {
+                            acc = value;
+                            best = r;
+                        }
+                    }
+                    else if (r == 0 && (task.op == Reduce_op::MAX || task.op == Reduce_op::MIN))
+                        acc = value;
+                    else
+                        reduce_item<T>(acc, value, task.op);
+                }
+                task.dst[out_offset] = task.arg ? (R)best : (R)reduce_finish<T>(acc, task.finish, plan.reduce_items);
+            }
+            break;
+        }
+        // return
+        return;
+    }
+
+    /**
+     * @brief Minimum number of tasks of a part (BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD)
+     * @param task_items Source items read by one task
+     * @param item_size Size of an item (in bytes)
+     * @param task_count Number of tasks (single part without threading)
+     */
+    inline size_t reduce_min_part(size_t task_items, size_t item_size, size_t task_count)
+    {
+#ifdef BUFFER_THREADED_OPERATIONS
+        (void)task_count;
+        const size_t bytes = task_items * item_size;
+        return bytes ? (BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD + bytes - 1) / bytes : 1;
+#else
+        (void)task_items;
+        (void)item_size;
+        return task_count;
+#endif
+    }
+
+    /**
+     * @brief Reduction of a tensor along axes (driver)
+     * @param out The output tensor (allocated, contiguous)
+     * @param a The source tensor
+     * @param axes The axes to reduce (nullptr / 0 count: every axis)
+     * @param axes_count Number of axes
+     * @param keep_dims True to keep reduced axes (as size 1)
+     * @param op The reduction
+     * @param finish Last step applied to every output item
+     * @param arg True for arg-max / arg-min (op is MAX / MIN, one axis,
+     *        out holds indexes along it)
+     * @return True if successful, false if an axis is invalid (out of range
+     *         or repeated), a is empty, or allocation failed
+     * @note Without kept axes (and keep_dims false) out has shape (1).
+     */
+    template <typename T, typename R>
+    inline bool reduce_tensor(ty::Tensor<R> & out, const ty::Tensor<T> & a, const size_t * axes,
+                              size_t axes_count, bool keep_dims, Reduce_op op, Reduce_finish finish,
+                              bool arg)
+    {
+        const TENSOR_UTILITIES::Shape & shape = a.get_shape();
+        const size_t dims = shape.get_dim_count();
+        if (dims == 0 || shape.get_item_count() == 0)
+            return false;
+        // output is the source -> reduce aside, then copy
+        if ((const void *)&out == (const void *)&a)
+        {
+            ty::Tensor<R> result { };
+            if (!reduce_tensor<T, R>(result, a, axes, axes_count, keep_dims, op, finish, arg))
+                return false;
+            return result.copy_to(out);
+        }
+
+        // reduced axes
+        TENSOR_UTILITIES::DimArray reduced { };
+        TENSOR_UTILITIES::DimArray out_shape { };
+        if (!reduced.allocate(dims) || !out_shape.allocate(dims))
+            return false;
+        for (size_t d = 0; d < dims; ++d)
+            reduced[d] = (axes_count == 0) ? 1 : 0;
+        for (size_t i = 0; i < axes_count; ++i)
+        {
+            if (axes[i] >= dims || reduced[axes[i]])
+                return false;
+            reduced[axes[i]] = 1;
+        }
+        // output shape
+        size_t out_dims = 0;
+        for (size_t d = 0; d < dims; ++d)
+        {
+            if (!reduced[d])
+                out_shape[out_dims++] = shape.get_shape(d);
+            else if (keep_dims)
+                out_shape[out_dims++] = 1;
+        }
+        if (out_dims == 0)
+            out_shape[out_dims++] = 1;
+
+        // plan
+        Reduce_plan plan { };
+        if (!make_reduce_plan(plan, shape, reduced.data()))
+            return false;
+        if (!out.allocate(out_shape.data(), out_dims))
+            return false;
+
+        Reduce_task<T, R> task { };
+        task.plan = &plan;
+        task.src = a.raw_data();
+        task.dst = out.raw_data();
+        task.op = op;
+        task.finish = finish;
+        task.arg = arg;
+
+        // pick the path
+        const size_t kept_last = plan.kept_count - 1;
+        const size_t red_last = plan.reduced_count - 1;
+        const size_t inner = plan.reduced_shape[red_last];
+        Reduce_path path = Reduce_path::GENERIC;
+        size_t tasks = plan.out_items;
+        size_t task_items = plan.reduce_items;
+        if (plan.reduced_stride[red_last] == 1 && inner > 1)
+        {
+            path = Reduce_path::INNER;
+            // one long run -> fixed chunks
+            if (plan.out_items == 1 && plan.reduced_count == 1 && inner > TENSOR_REDUCE_CHUNK)
+            {
+                path = Reduce_path::CHUNKED;
+                tasks = (inner + TENSOR_REDUCE_CHUNK - 1) / TENSOR_REDUCE_CHUNK;
+                task_items = TENSOR_REDUCE_CHUNK;
+            }
+        }
+        else if (plan.kept_stride[kept_last] == 1 && plan.out_stride[kept_last] == 1 &&
+                 plan.kept_shape[kept_last] > 1)
+        {
+            path = Reduce_path::OUTER;
+            task.column_tasks = (plan.kept_shape[kept_last] + REDUCE_COLUMN_TASK - 1) / REDUCE_COLUMN_TASK;
+            tasks = (plan.out_items / plan.kept_shape[kept_last]) * task.column_tasks;
+            task_items = plan.reduce_items * REDUCE_COLUMN_TASK;
+        }
+
+        // partial results of the chunks
+        if (path == Reduce_path::CHUNKED)
+        {
+            task.partials = (T *)malloc(tasks * sizeof(T));
+            task.partial_indexes = (size_t *)malloc(tasks * sizeof(size_t));
+            if (!task.partials || !task.partial_indexes)
+            {
+                free(task.partials);
+                free(task.partial_indexes);
+                return false;
+            }
+        }
+
+        // arguments of the parts
+        struct Part_args
+        {
+            const Reduce_task<T, R> * task;
+            Reduce_path path;
+        } args { &task, path };
+        // run the parts (on the process-wide pool)
+        TENSOR_UTILITIES::parallel_for(0, tasks, reduce_min_part(task_items, sizeof(T), tasks),
+            [](size_t start, size_t end, void * args_ptr)
+            {
+                const Part_args & part = *(const Part_args *)args_ptr;
+                reduce_part<T, R>(*part.task, part.path, start, end);
+            },
+            &args);
+
+        // merge the chunks (pairwise for sums, first index for arg)
+        if (path == Reduce_path::CHUNKED)
+        {
+            if (arg)
+            {
+                size_t best = task.partial_indexes[0];
+                for (size_t c = 1; c < tasks; ++c)
+                {
+                    const size_t index = task.partial_indexes[c];
+                    if ((op == Reduce_op::MAX) ? (task.src[index] > task.src[best])
+                                               : (task.src[index] < task.src[best]))
+                        best = index;
+                }
+                task.dst[0] = (R)best;
+            }
+            else
+            {
+                const Reduce_op merge_op = (op == Reduce_op::SUM_SQUARES) ? Reduce_op::SUM : op;
+                const T value = reduce_items<T>(task.partials, tasks, merge_op);
+                task.dst[0] = (R)reduce_finish<T>(value, finish, plan.reduce_items);
+            }
+            free(task.partials);
+            free(task.partial_indexes);
+        }
+        // return
+        return true;
+    }
+}
+
+namespace ty
+{
+
+    /**
+     * @brief Sum along axes: out = sum of a over the axes
+     * @param out The output tensor (allocated, contiguous)
+     * @param a The source tensor
+     * @param axes The axes to reduce (nullptr: every axis)
+     * @param axes_count Number of axes (0: every axis)
+     * @param keep_dims True to keep the reduced axes as size 1
+     * @return True if successful, false if an axis is invalid (out of range
+     *         or repeated), a is empty, or allocation failed
+     * @note Pairwise summation. Every output item is computed by one thread
+     *       in a fixed order: results do not depend on the thread count
+     *       (they may differ between SIMD levels).
+     * @note Without kept axes (and keep_dims false) out has shape (1).
+     */
+    template <typename T>
+    inline bool sum (Tensor<T> & out, const Tensor<T> & a, const size_t * axes = nullptr,
+                     size_t axes_count = 0, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, T>(out, a, axes, axes_count, keep_dims,
+                                                TENSOR_MATH::Reduce_op::SUM,
+                                                TENSOR_MATH::Reduce_finish::NONE, false);
+    }
+
+    /**
+     * @brief Mean along axes (sum divided by the reduced item count)
+     * @see sum() (integer tensors use integer division)
+     */
+    template <typename T>
+    inline bool mean (Tensor<T> & out, const Tensor<T> & a, const size_t * axes = nullptr,
+                      size_t axes_count = 0, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, T>(out, a, axes, axes_count, keep_dims,
+                                                TENSOR_MATH::Reduce_op::SUM,
+                                                TENSOR_MATH::Reduce_finish::MEAN, false);
+    }
+
+    /**
+     * @brief Greatest item along axes
+     * @see sum() (undefined with NaN items)
+     */
+    template <typename T>
+    inline bool max (Tensor<T> & out, const Tensor<T> & a, const size_t * axes = nullptr,
+                     size_t axes_count = 0, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, T>(out, a, axes, axes_count, keep_dims,
+                                                TENSOR_MATH::Reduce_op::MAX,
+                                                TENSOR_MATH::Reduce_finish::NONE, false);
+    }
+
+    /**
+     * @brief Smallest item along axes
+     * @see sum() (undefined with NaN items)
+     */
+    template <typename T>
+    inline bool min (Tensor<T> & out, const Tensor<T> & a, const size_t * axes = nullptr,
+                     size_t axes_count = 0, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, T>(out, a, axes, axes_count, keep_dims,
+                                                TENSOR_MATH::Reduce_op::MIN,
+                                                TENSOR_MATH::Reduce_finish::NONE, false);
+    }
+
+    /**
+     * @brief L2 norm along axes (square root of the sum of squares)
+     * @see sum()
+     */
+    template <typename T>
+    inline bool l2_norm (Tensor<T> & out, const Tensor<T> & a, const size_t * axes = nullptr,
+                         size_t axes_count = 0, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, T>(out, a, axes, axes_count, keep_dims,
+                                                TENSOR_MATH::Reduce_op::SUM_SQUARES,
+                                                TENSOR_MATH::Reduce_finish::SQRT, false);
+    }
+
+    /**
+     * @brief Index of the first greatest item along one axis
+     * @param out The output tensor (indexes along axis)
+     * @param a The source tensor
+     * @param axis The axis to reduce
+     * @param keep_dims True to keep the axis as size 1
+     * @return True if successful, false otherwise (see sum())
+     */
+    template <typename T>
+    inline bool argmax (Tensor<size_t> & out, const Tensor<T> & a, size_t axis, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, size_t>(out, a, &axis, 1, keep_dims,
+                                                     TENSOR_MATH::Reduce_op::MAX,
+                                                     TENSOR_MATH::Reduce_finish::NONE, true);
+    }
+
+    /**
+     * @brief Index of the first smallest item along one axis
+     * @see argmax()
+     */
+    template <typename T>
+    inline bool argmin (Tensor<size_t> & out, const Tensor<T> & a, size_t axis, bool keep_dims = false)
+    {
+        return TENSOR_MATH::reduce_tensor<T, size_t>(out, a, &axis, 1, keep_dims,
+                                                     TENSOR_MATH::Reduce_op::MIN,
+                                                     TENSOR_MATH::Reduce_finish::NONE, true);
+    }
+
+} // end of namespace
+
+#endif // _MATH_REDUCTION_HPP_
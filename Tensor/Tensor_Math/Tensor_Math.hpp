@@ -0,0 +1,19 @@
+// File: Tensor_Math.hpp
+// Description: Math on tensors (included by Tensor.hpp after
+//              the Tensor class template is implemented).
+//              Raw kernels and plans live in TENSOR_MATH,
+//              the tensor level functions live in ty.
+// Date: Oct. 17, 2026
+// @ADMINGUOYU
+
+#ifndef _TENSOR_MATH_HPP_
+#define _TENSOR_MATH_HPP_
+
+namespace TENSOR_MATH { }
+
+#include "./Elementwise.hpp"
+#include "./Reduction.hpp"
+#include "./Matmul.hpp"
+#include "./Expression.hpp"
+
+#endif
@@ -0,0 +1,755 @@
+// File: Allocator.hpp
+// Description: Raw (aligned) block allocation for Buffer::Memory,
+//              with an optional size-class caching allocator.
+//              (Blocks are kept and reused instead of going back to the system)
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_ALLOCATOR_HPP_
+#define _UTILS_ALLOCATOR_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdlib>  // posix_memalign(); free()
+#include <cstring>  // memset()
+
+// minimum alignment (in Byte) of every allocated buffer
+// should be a power of 2 and a multiple of sizeof(void *)
+// 64 covers a cache line and an AVX-512 vector
+#ifndef BUFFER_MEMORY_ALIGNMENT
+    #define BUFFER_MEMORY_ALIGNMENT 64
+#endif
+// Windows does not have posix_memalign(), we use _aligned_malloc()
+#ifdef _WIN32
+    #include <malloc.h>  // _aligned_malloc(); _aligned_free()
+#endif
+
+// allocation policies (see Alloc_policy)
+// huge page size (in Byte), HUGE_PAGE blocks are aligned and rounded up to it
+#ifndef BUFFER_HUGE_PAGE_SIZE
+    #define BUFFER_HUGE_PAGE_SIZE (2 * 1024 * 1024)  // 2 MB
+#endif
+// define BUFFER_HUGE_PAGE_THRESHOLD (in Byte) to give every DEFAULT
+// block of at least this size the HUGE_PAGE policy
+// (e.g. -DBUFFER_HUGE_PAGE_THRESHOLD=4194304 for 4 MB)
+// madvise() / mlock() are POSIX only, elsewhere the policies only align
+#if defined(__unix__) || defined(__APPLE__)
+    #define BUFFER_ALLOC_POLICY_SUPPORTED
+    #include <sys/mman.h>   // madvise(); mlock(); munlock(); mmap(); munmap()
+#endif
+
+// zero-filled blocks (allocate_zeroed()) of at least this size (in Byte)
+// are anonymous mappings: fresh pages from the kernel are already zero,
+// nothing is written (pages are only touched on first use)
+// smaller ones are cleared with memset() (calloc() cannot keep
+// BUFFER_MEMORY_ALIGNMENT), POSIX only (elsewhere memset() for all)
+#ifndef BUFFER_ZEROED_MMAP_THRESHOLD
+    #define BUFFER_ZEROED_MMAP_THRESHOLD (1024 * 1024)  // 1 MB
+#endif
+
+// macro for enabling the caching allocator
+// without it, every block goes straight to the system allocator
+#ifdef BUFFER_CACHING_ALLOCATOR
+    // default cap on cached (free, not returned) bytes
+    // can be changed at runtime through CachingAllocator::set_cache_limit()
+    #ifndef BUFFER_CACHE_LIMIT
+        #define BUFFER_CACHE_LIMIT (256 * 1024 * 1024)  // 256 MB
+    #endif
+    // blocks larger than this are never cached (power of 2 rounding
+    // wastes too much on them, and the system allocator mmaps them anyway)
+    #ifndef BUFFER_CACHE_MAX_BLOCK
+        #define BUFFER_CACHE_MAX_BLOCK (64 * 1024 * 1024)  // 64 MB
+    #endif
+    // thread-local fast path: blocks kept per size class and per thread
+    #ifndef BUFFER_CACHE_LOCAL_BLOCKS
+        #define BUFFER_CACHE_LOCAL_BLOCKS 4
+    #endif
+    // thread-local fast path: largest block kept per thread
+    #ifndef BUFFER_CACHE_LOCAL_MAX_BLOCK
+        #define BUFFER_CACHE_LOCAL_MAX_BLOCK (1024 * 1024)  // 1 MB
+    #endif
+    #include <atomic>   // std::atomic
+    // the shared free lists are protected by a pthread mutex
+    // (link with -lpthread, see ../Parallel/ThreadPool.hpp)
+    #include <pthread.h>
+#endif // BUFFER_CACHING_ALLOCATOR
+
+namespace TENSOR_UTILITIES
+{
+
+    // alignment should be usable by posix_memalign()
+    static_assert((BUFFER_MEMORY_ALIGNMENT & (BUFFER_MEMORY_ALIGNMENT - 1)) == 0 &&
+                  BUFFER_MEMORY_ALIGNMENT >= sizeof(void *),
+                  "BUFFER_MEMORY_ALIGNMENT should be a power of 2 and a multiple of sizeof(void *)");
+
+    /**
+     * @brief Allocates a block aligned to BUFFER_MEMORY_ALIGNMENT from the system
+     * @param size Size of the block (in Byte)
+     * @return Pointer to the block, nullptr if failed
+     */
+    inline void * system_allocate(size_t size)
+    {
+#ifdef _WIN32
+        return _aligned_malloc(size, BUFFER_MEMORY_ALIGNMENT);
+#else
+        void * ptr = nullptr;
+        if (posix_memalign(&ptr, BUFFER_MEMORY_ALIGNMENT, size))
+            return nullptr;
+        return ptr;
+#endif
+    }
+
+    /**
+     * @brief Frees a block from system_allocate() (nullptr is okay)
+     * @param ptr Pointer to the block
+     */
+    inline void system_free(void * ptr)
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+        return;
+    }
+
+    // how a buffer block is allocated
+    enum class Alloc_policy
+    {
+        // plain aligned allocation (through the cache if enabled)
+        DEFAULT = 0,
+        // aligned to BUFFER_HUGE_PAGE_SIZE, transparent huge pages
+        // requested with madvise(MADV_HUGEPAGE) (Linux)
+        HUGE_PAGE = 1,
+        // pages locked in RAM with mlock() (never paged out)
+        // best effort: the block is still used if mlock() fails
+        // (i.e. RLIMIT_MEMLOCK too low)
+        LOCKED = 2,
+        // both of the above
+        HUGE_PAGE_LOCKED = 3
+    };
+
+    /**
+     * @brief Gets the printable name of a policy
+     */
+    inline const char * policy_name(Alloc_policy policy)
+    {
+        switch (policy)
+        {
+            case Alloc_policy::HUGE_PAGE:        return "huge-page";
+            case Alloc_policy::LOCKED:           return "locked";
+            case Alloc_policy::HUGE_PAGE_LOCKED: return "huge-page+locked";
+            default:                             return "default";
+        }
+    }
+
+    /**
+     * @brief Gets the policy a block of this size is allocated with
+     * @param policy Requested policy
+     * @param size Size of the block (in Byte)
+     * @return policy, or HUGE_PAGE for a large DEFAULT block
+     *         (if BUFFER_HUGE_PAGE_THRESHOLD is defined)
+     */
+    inline Alloc_policy resolve_policy(Alloc_policy policy, size_t size)
+    {
+#ifdef BUFFER_HUGE_PAGE_THRESHOLD
+        if (policy == Alloc_policy::DEFAULT && size >= (size_t)(BUFFER_HUGE_PAGE_THRESHOLD))
+            return Alloc_policy::HUGE_PAGE;
+#else
+        (void)size;
+#endif
+        return policy;
+    }
+
+#ifdef BUFFER_CACHING_ALLOCATOR
+    /**
+     * @brief Size-class caching allocator (process-wide)
+     *        Get it with CachingAllocator::instance().
+     *        Sizes are rounded up to a power of 2 (the size class), freed
+     *        blocks are kept in per-class free lists and handed out again
+     *        to requests of the same class.
+     * @note Each thread keeps a few blocks per class without locking
+     *       (the fast path), the rest go to shared free lists.
+     * @note Cached bytes are capped (set_cache_limit()), a block that does
+     *       not fit under the cap goes back to the system.
+     *       empty_cache() gives every cached block back.
+     */
+    class CachingAllocator
+    {
+    public:
+        // counters snapshot
+        struct Stats
+        {
+            // requests served from the cache
+            size_t hits;
+            // requests that went to the system
+            size_t misses;
+            // bytes currently kept in the cache
+            size_t cached_bytes;
+            // cap on cached bytes
+            size_t cache_limit;
+        };
+
+        /**
+         * @brief Gets the process-wide allocator
+         * @return Reference to the allocator
+         * @note The allocator is never destroyed (static tensors may
+         *       free their blocks after main() returns).
+         */
+        static CachingAllocator & instance(void)
+        {
+            // C++11 guarantees thread-safe initialisation
+            static CachingAllocator * allocator = new CachingAllocator();
+            return *allocator;
+        }
+
+        // not copyable nor movable
+        CachingAllocator(const CachingAllocator & other) = delete;
+        CachingAllocator(CachingAllocator && other) = delete;
+        CachingAllocator & operator= (const CachingAllocator & other) = delete;
+        CachingAllocator & operator= (CachingAllocator && other) = delete;
+
+    private:
+        // one class per power of 2 (index is log2 of the class size)
+        static constexpr size_t CLASS_COUNT = sizeof(size_t) * 8;
+
+        // free block (the link lives in the block itself)
+        struct Free_block
+        {
+            Free_block * next;
+        };
+
+        // per-thread blocks (fast path, no locking)
+        struct Local_cache
+        {
+            void * blocks[CLASS_COUNT][BUFFER_CACHE_LOCAL_BLOCKS];
+            size_t counts[CLASS_COUNT];
+            // empty_cache() generation this cache belongs to
+            size_t generation;
+
+            Local_cache(void) : counts(), generation(CachingAllocator::instance().generation.load()) { return; }
+            // thread exit: hand the blocks to the shared lists
+            ~Local_cache(void)
+            {
+                CachingAllocator::instance().flush_local(*this, false);
+                CachingAllocator::local_destroyed() = true;
+                return;
+            }
+        };
+
+        // protects free_lists
+        pthread_mutex_t mutex;
+        // shared free lists (one per class)
+        Free_block * free_lists[CLASS_COUNT];
+
+        // counters
+        std::atomic<size_t> hits {0};
+        std::atomic<size_t> misses {0};
+        std::atomic<size_t> cached_bytes {0};
+        std::atomic<size_t> cache_limit {BUFFER_CACHE_LIMIT};
+        // bumped by empty_cache(), local caches of an older
+        // generation are given back on their next use
+        std::atomic<size_t> generation {0};
+
+    private:
+        // private constructor (only accessible by instance())
+        CachingAllocator(void) : free_lists()
+        {
+            pthread_mutex_init(&this->mutex, nullptr);
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] flag of the calling thread's cache being destroyed
+         *        (blocks freed at exit, after the thread-local cache is gone)
+         */
+        static bool & local_destroyed(void)
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+        /**
+         * @brief [INTERNAL] the calling thread's cache
+         * @return Pointer to the cache, nullptr if already destroyed
+         */
+        static Local_cache * local(void)
+        {
+            if (CachingAllocator::local_destroyed())
+                return nullptr;
+            static thread_local Local_cache cache;
+            return &cache;
+        }
+
+        /**
+         * @brief [INTERNAL] gets the class index of a size
+         * @return log2 of the class size
+         */
+        static size_t class_of(size_t size)
+        {
+            size_t cls = 0;
+            size_t class_size = 1;
+            while (class_size < size || class_size < BUFFER_MEMORY_ALIGNMENT)
+            {
+                class_size <<= 1;
+                ++cls;
+            }
+            return cls;
+        }
+
+        /**
+         * @brief [INTERNAL] tries to count a block as cached (under the cap)
+         * @return True if the block may be kept
+         */
+        bool reserve(size_t class_size)
+        {
+            size_t before = this->cached_bytes.fetch_add(class_size);
+            if (before + class_size <= this->cache_limit.load())
+                return true;
+            this->cached_bytes.fetch_sub(class_size);
+            return false;
+        }
+
+        /**
+         * @brief [INTERNAL] empties a local cache
+         * @param cache The cache to empty
+         * @param to_system True to give the blocks to the system,
+         *        false to move them to the shared lists
+         */
+        void flush_local(Local_cache & cache, bool to_system)
+        {
+            if (!to_system)
+                pthread_mutex_lock(&this->mutex);
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+            {
+                for (size_t i = 0; i < cache.counts[cls]; ++i)
+                {
+                    if (to_system)
+                    {
+                        this->cached_bytes.fetch_sub((size_t)1 << cls);
+                        system_free(cache.blocks[cls][i]);
+                    }
+                    else
+                    {
+                        Free_block * block = (Free_block *)cache.blocks[cls][i];
+                        block->next = this->free_lists[cls];
+                        this->free_lists[cls] = block;
+                    }
+                }
+                cache.counts[cls] = 0;
+            }
+            if (!to_system)
+                pthread_mutex_unlock(&this->mutex);
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] gives an outdated local cache back (after empty_cache())
+         */
+        void sync_local(Local_cache & cache)
+        {
+            size_t current = this->generation.load(std::memory_order_relaxed);
+            if (cache.generation == current)
+                return;
+            this->flush_local(cache, true);
+            cache.generation = current;
+            return;
+        }
+
+    public:
+        /**
+         * @brief Gets the size (in Byte) actually reserved for a request
+         * @param size Requested size (in Byte)
+         * @return The class size (size itself if it is never cached)
+         */
+        static size_t block_size(size_t size)
+        {
+            if (size > BUFFER_CACHE_MAX_BLOCK)
+                return size;
+            return (size_t)1 << CachingAllocator::class_of(size);
+        }
+
+        /**
+         * @brief Allocates a block
+         * @param size Size of the block (in Byte)
+         * @return Pointer to the block (aligned to BUFFER_MEMORY_ALIGNMENT),
+         *         nullptr if failed
+         * @note The block must be released with the same size.
+         */
+        void * allocate(size_t size)
+        {
+            // too large, not cached
+            if (size > BUFFER_CACHE_MAX_BLOCK)
+            {
+                this->misses.fetch_add(1, std::memory_order_relaxed);
+                return system_allocate(size);
+            }
+            size_t cls = CachingAllocator::class_of(size);
+
+            // fast path (this thread's blocks)
+            Local_cache * cache = CachingAllocator::local();
+            if (cache)
+            {
+                this->sync_local(*cache);
+                if (cache->counts[cls])
+                {
+                    this->hits.fetch_add(1, std::memory_order_relaxed);
+                    this->cached_bytes.fetch_sub((size_t)1 << cls);
+                    return cache->blocks[cls][--cache->counts[cls]];
+                }
+            }
+
+            // shared lists
+            pthread_mutex_lock(&this->mutex);
+            Free_block * block = this->free_lists[cls];
+            if (block)
+                this->free_lists[cls] = block->next;
+            pthread_mutex_unlock(&this->mutex);
+            if (block)
+            {
+                this->hits.fetch_add(1, std::memory_order_relaxed);
+                this->cached_bytes.fetch_sub((size_t)1 << cls);
+                return block;
+            }
+
+            // system
+            this->misses.fetch_add(1, std::memory_order_relaxed);
+            return system_allocate((size_t)1 << cls);
+        }
+
+        /**
+         * @brief Releases a block from allocate() (nullptr is okay)
+         * @param ptr Pointer to the block
+         * @param size Size given to allocate()
+         */
+        void release(void * ptr, size_t size)
+        {
+            if (!ptr)
+                return;
+            // too large, back to the system
+            if (size > BUFFER_CACHE_MAX_BLOCK)
+            {
+                system_free(ptr);
+                return;
+            }
+            size_t cls = CachingAllocator::class_of(size);
+            // over the cap, back to the system
+            if (!this->reserve((size_t)1 << cls))
+            {
+                system_free(ptr);
+                return;
+            }
+
+            // fast path (this thread's blocks)
+            Local_cache * cache = CachingAllocator::local();
+            if (cache)
+            {
+                this->sync_local(*cache);
+                if (((size_t)1 << cls) <= BUFFER_CACHE_LOCAL_MAX_BLOCK &&
+                    cache->counts[cls] < BUFFER_CACHE_LOCAL_BLOCKS)
+                {
+                    cache->blocks[cls][cache->counts[cls]++] = ptr;
+                    return;
+                }
+            }
+
+            // shared lists
+            Free_block * block = (Free_block *)ptr;
+            pthread_mutex_lock(&this->mutex);
+            block->next = this->free_lists[cls];
+            this->free_lists[cls] = block;
+            pthread_mutex_unlock(&this->mutex);
+            return;
+        }
+
+        /**
+         * @brief Gives every cached block back to the system
+         * @note Blocks kept by other threads are given back
+         *       on their next allocation / release.
+         */
+        void empty_cache(void)
+        {
+            // outdate all local caches, this thread's first
+            this->generation.fetch_add(1);
+            Local_cache * cache = CachingAllocator::local();
+            if (cache)
+                this->sync_local(*cache);
+            // shared lists
+            pthread_mutex_lock(&this->mutex);
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+            {
+                Free_block * block = this->free_lists[cls];
+                while (block)
+                {
+                    Free_block * next = block->next;
+                    this->cached_bytes.fetch_sub((size_t)1 << cls);
+                    system_free(block);
+                    block = next;
+                }
+                this->free_lists[cls] = nullptr;
+            }
+            pthread_mutex_unlock(&this->mutex);
+            return;
+        }
+
+        /**
+         * @brief Sets the cap on cached bytes
+         * @param limit Cap (in Byte), 0 disables caching
+         * @note If the cache is already above the new cap, it is emptied.
+         */
+        void set_cache_limit(size_t limit)
+        {
+            this->cache_limit.store(limit);
+            if (this->cached_bytes.load() > limit)
+                this->empty_cache();
+            return;
+        }
+        /**
+         * @brief Gets the cap on cached bytes
+         */
+        size_t get_cache_limit(void) const
+        {
+            return this->cache_limit.load();
+        }
+
+        /**
+         * @brief Gets the hit / miss counters and the cache usage
+         */
+        Stats get_stats(void) const
+        {
+            return Stats { this->hits.load(), this->misses.load(),
+                           this->cached_bytes.load(), this->cache_limit.load() };
+        }
+        /**
+         * @brief Resets the hit / miss counters
+         */
+        void reset_stats(void)
+        {
+            this->hits.store(0);
+            this->misses.store(0);
+            return;
+        }
+    };
+#endif // BUFFER_CACHING_ALLOCATOR
+
+    /**
+     * @brief Allocates a buffer block (through the cache if enabled)
+     * @param size Size of the block (in Byte)
+     * @return Pointer to the block (aligned to BUFFER_MEMORY_ALIGNMENT),
+     *         nullptr if failed
+     */
+    inline void * block_allocate(size_t size)
+    {
+#ifdef BUFFER_CACHING_ALLOCATOR
+        return CachingAllocator::instance().allocate(size);
+#else
+        return system_allocate(size);
+#endif
+    }
+
+    /**
+     * @brief Releases a block from block_allocate() (nullptr is okay)
+     * @param ptr Pointer to the block
+     * @param size Size given to block_allocate()
+     */
+    inline void block_release(void * ptr, size_t size)
+    {
+#ifdef BUFFER_CACHING_ALLOCATOR
+        CachingAllocator::instance().release(ptr, size);
+#else
+        (void)size;
+        system_free(ptr);
+#endif
+        return;
+    }
+
+    /**
+     * @brief [INTERNAL] checks if a policy uses huge pages
+     */
+    inline bool policy_huge_page(Alloc_policy policy)
+    {
+        return policy == Alloc_policy::HUGE_PAGE || policy == Alloc_policy::HUGE_PAGE_LOCKED;
+    }
+    /**
+     * @brief [INTERNAL] checks if a policy locks pages
+     */
+    inline bool policy_locked(Alloc_policy policy)
+    {
+        return policy == Alloc_policy::LOCKED || policy == Alloc_policy::HUGE_PAGE_LOCKED;
+    }
+    /**
+     * @brief [INTERNAL] gets the length of a policy block (huge pages are whole)
+     */
+    inline size_t policy_length(size_t size, Alloc_policy policy)
+    {
+        if (!policy_huge_page(policy))
+            return size;
+        return (size + BUFFER_HUGE_PAGE_SIZE - 1) / BUFFER_HUGE_PAGE_SIZE * BUFFER_HUGE_PAGE_SIZE;
+    }
+
+    /**
+     * @brief Allocates a buffer block with a policy
+     * @param size Size of the block (in Byte)
+     * @param policy Allocation policy (use resolve_policy() first)
+     * @return Pointer to the block (aligned to BUFFER_MEMORY_ALIGNMENT at least),
+     *         nullptr if failed
+     * @note DEFAULT blocks go through block_allocate() (cache),
+     *       the others straight to the system.
+     */
+    inline void * policy_allocate(size_t size, Alloc_policy policy)
+    {
+        if (policy == Alloc_policy::DEFAULT)
+            return block_allocate(size);
+        const size_t length = policy_length(size, policy);
+        void * ptr = nullptr;
+#if defined(BUFFER_ALLOC_POLICY_SUPPORTED)
+        // huge pages need huge page alignment
+        if (policy_huge_page(policy))
+        {
+            if (posix_memalign(&ptr, BUFFER_HUGE_PAGE_SIZE, length))
+                return nullptr;
+    #ifdef MADV_HUGEPAGE
+            madvise(ptr, length, MADV_HUGEPAGE);
+    #endif
+        }
+        else
+            ptr = system_allocate(length);
+        if (ptr && policy_locked(policy))
+            mlock(ptr, length);
+#else
+        ptr = system_allocate(length);
+#endif
+        return ptr;
+    }
+
+    /**
+     * @brief Releases a block from policy_allocate() (nullptr is okay)
+     * @param ptr Pointer to the block
+     * @param size Size given to policy_allocate()
+     * @param policy Policy given to policy_allocate()
+     */
+    inline void policy_release(void * ptr, size_t size, Alloc_policy policy)
+    {
+        if (policy == Alloc_policy::DEFAULT)
+        {
+            block_release(ptr, size);
+            return;
+        }
+        if (!ptr)
+            return;
+#if defined(BUFFER_ALLOC_POLICY_SUPPORTED)
+        if (policy_locked(policy))
+            munlock(ptr, policy_length(size, policy));
+        // posix_memalign() blocks are freed with free()
+        free(ptr);
+#else
+        system_free(ptr);
+#endif
+        return;
+    }
+
+    /**
+     * @brief Allocates a zero-filled buffer block with a policy
+     * @param size Size of the block (in Byte)
+     * @param policy Allocation policy (use resolve_policy() first)
+     * @param anonymous Set to true if the block is an anonymous mapping
+     *        (release it with anonymous_release()), false if it comes from
+     *        policy_allocate() (release it with policy_release())
+     * @return Pointer to the block (aligned to BUFFER_MEMORY_ALIGNMENT at least),
+     *         nullptr if failed
+     * @note Blocks of at least BUFFER_ZEROED_MMAP_THRESHOLD are mapped
+     *       (never cached), huge page blocks are trimmed to BUFFER_HUGE_PAGE_SIZE.
+     */
+    inline void * policy_allocate_zeroed(size_t size, Alloc_policy policy, bool & anonymous)
+    {
+        anonymous = false;
+#if defined(BUFFER_ALLOC_POLICY_SUPPORTED) && defined(MAP_ANONYMOUS)
+        if (size >= (size_t)(BUFFER_ZEROED_MMAP_THRESHOLD))
+        {
+            const size_t length = policy_length(size, policy);
+            // huge pages: map one more huge page and trim to its boundary
+            const size_t slack = policy_huge_page(policy) ? BUFFER_HUGE_PAGE_SIZE : 0;
+            void * raw = mmap(nullptr, length + slack, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+                return nullptr;
+            unsigned char * ptr = (unsigned char *)raw;
+            if (slack)
+            {
+                const size_t head = (BUFFER_HUGE_PAGE_SIZE - ((size_t)ptr & (BUFFER_HUGE_PAGE_SIZE - 1))) &
+                                    (BUFFER_HUGE_PAGE_SIZE - 1);
+                if (head)
+                    munmap(ptr, head);
+                if (slack - head)
+                    munmap(ptr + head + length, slack - head);
+                ptr += head;
+    #ifdef MADV_HUGEPAGE
+                madvise(ptr, length, MADV_HUGEPAGE);
+    #endif
+            }
+            if (policy_locked(policy))
+                mlock(ptr, length);
+            anonymous = true;
+            return ptr;
+        }
+#endif
+        // small block, clear it
+        void * ptr = policy_allocate(size, policy);
+        if (ptr)
+            memset(ptr, 0, size);
+        return ptr;
+    }
+
+    /**
+     * @brief Releases an anonymous block from policy_allocate_zeroed() (nullptr is okay)
+     * @param ptr Pointer to the block
+     * @param size Size given to policy_allocate_zeroed()
+     * @param policy Policy given to policy_allocate_zeroed()
+     */
+    inline void anonymous_release(void * ptr, size_t size, Alloc_policy policy)
+    {
+        if (!ptr)
+            return;
+#if defined(BUFFER_ALLOC_POLICY_SUPPORTED) && defined(MAP_ANONYMOUS)
+        const size_t length = policy_length(size, policy);
+        if (policy_locked(policy))
+            munlock(ptr, length);
+        munmap(ptr, length);
+#else
+        // never mapped here (see policy_allocate_zeroed())
+        policy_release(ptr, size, policy);
+#endif
+        return;
+    }
+
+    /**
+     * @brief Checks if a block of old_size can hold new_size in place
+     * @return True if both sizes share the same reserved block
+     *         (always false without the caching allocator)
+     */
+    inline bool block_fits(size_t old_size, size_t new_size)
+    {
+#ifdef BUFFER_CACHING_ALLOCATOR
+        return old_size <= BUFFER_CACHE_MAX_BLOCK && new_size <= BUFFER_CACHE_MAX_BLOCK &&
+               CachingAllocator::block_size(old_size) == CachingAllocator::block_size(new_size);
+#else
+        (void)old_size;
+        (void)new_size;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Checks if a policy block of old_size can hold new_size in place
+     * @return True if both sizes share the same block
+     *         (same size class, or same huge page count)
+     */
+    inline bool policy_fits(size_t old_size, size_t new_size, Alloc_policy policy)
+    {
+        if (policy == Alloc_policy::DEFAULT)
+            return block_fits(old_size, new_size);
+        if (!policy_huge_page(policy))
+            return false;
+        return policy_length(old_size, policy) == policy_length(new_size, policy);
+    }
+}
+
+#endif // _UTILS_ALLOCATOR_HPP_
@@ -0,0 +1,139 @@
+// File: Conversion.hpp
+// Description: Bulk item conversion between arithmetic types
+//              (truncating / rounding / saturating), used by
+//              cross-type copy_assign() and Tensor::copy_to().
+//              float / double / int / int8 pairs go to the SIMD
+//              library when BUFFER_ENABLE_SIMD is defined.
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_CONVERSION_HPP_
+#define _UTILS_CONVERSION_HPP_
+
+#include <cstddef>      // defines: size_t
+#include <cmath>        // std::nearbyint()
+#include <limits>       // std::numeric_limits
+#include <type_traits>  // std::is_integral; std::is_floating_point; std::is_signed
+#include <typeinfo>     // typeid()
+
+// SIMD conversion kernels (precompiled SIMD library)
+#ifdef BUFFER_ENABLE_SIMD
+    #include "../../SIMD/simd.h"
+#endif // BUFFER_ENABLE_SIMD
+
+namespace TENSOR_UTILITIES
+{
+
+    // how floating point values become integers
+    // (same values as simd_convert_mode, ROUND and SATURATE are flags)
+    enum class Convert_mode
+    {
+        // toward zero (C cast), out of range values are undefined
+        TRUNCATE = 0,
+        // to nearest, ties to even
+        ROUND = 1,
+        // toward zero, clamped to the destination range (NaN gives 0)
+        SATURATE = 2,
+        // to nearest, clamped to the destination range (NaN gives 0)
+        ROUND_SATURATE = 3
+    };
+
+    /**
+     * @brief Converts one item (scalar reference of the bulk kernels)
+     * @param value The source item
+     * @param mode Rounding / saturation (integer destinations only)
+     * @return The converted item
+     * @note Integer to integer saturation clamps to the destination range,
+     *       floating point destinations are plain casts.
+     */
+    template <typename X, typename Y>
+    inline X convert_item(Y value, Convert_mode mode)
+    {
+        // floating point or non-arithmetic destination -> plain cast
+        if (!std::is_integral<X>::value || mode == Convert_mode::TRUNCATE)
+            return static_cast<X>(value);
+        const bool round = ((int)mode & (int)Convert_mode::ROUND) != 0;
+        const bool saturate = ((int)mode & (int)Convert_mode::SATURATE) != 0;
+        // floating point source
+        if (std::is_floating_point<Y>::value)
+        {
+            long double wide = (long double)value;
+            if (round)
+                wide = std::nearbyint(wide);
+            if (saturate)
+            {
+                if (wide != wide)
+                    return X(0);
+                if (wide >= (long double)std::numeric_limits<X>::max())
+                    return std::numeric_limits<X>::max();
+                if (wide <= (long double)std::numeric_limits<X>::min())
+                    return std::numeric_limits<X>::min();
+            }
+            return static_cast<X>(wide);
+        }
+        // integer source (rounding does nothing)
+        if (saturate)
+        {
+            if (std::is_signed<Y>::value && value < Y(0))
+            {
+                if (!std::is_signed<X>::value)
+                    return X(0);
+                if ((long long)value < (long long)std::numeric_limits<X>::min())
+                    return std::numeric_limits<X>::min();
+            }
+            else if ((unsigned long long)value > (unsigned long long)std::numeric_limits<X>::max())
+                return std::numeric_limits<X>::max();
+        }
+        return static_cast<X>(value);
+    }
+
+    /**
+     * @brief Converts a run of items
+     * @param dst Pointer to the destination items
+     * @param src Pointer to the source items
+     * @param count Number of items
+     * @param mode Rounding / saturation (integer destinations only)
+     * @note The ranges should not overlap.
+     * @note With BUFFER_ENABLE_SIMD, int <-> float, float <-> double,
+     *       int <-> double and int8 <-> float use the vectorized kernels,
+     *       every other pair is a scalar loop.
+     */
+    template <typename X, typename Y>
+    inline void convert_items(X * dst, const Y * src, size_t count,
+                              Convert_mode mode = Convert_mode::TRUNCATE)
+    {
+// [SIMD] vectorized kernels for the common pairs
+#ifdef BUFFER_ENABLE_SIMD
+        // this syntax causes runtime overhead
+        // (constexpr if-else is available in C++17)
+        const simd_convert_mode simd_mode = (simd_convert_mode)mode;
+        if (typeid(X) == typeid(float) && typeid(Y) == typeid(int))
+            { simd_convert_int_float((float *)dst, (const int *)src, count); return; }
+        if (typeid(X) == typeid(int) && typeid(Y) == typeid(float))
+            { simd_convert_float_int((int *)dst, (const float *)src, count, simd_mode); return; }
+        if (typeid(X) == typeid(double) && typeid(Y) == typeid(float))
+            { simd_convert_float_double((double *)dst, (const float *)src, count); return; }
+        if (typeid(X) == typeid(float) && typeid(Y) == typeid(double))
+            { simd_convert_double_float((float *)dst, (const double *)src, count); return; }
+        if (typeid(X) == typeid(double) && typeid(Y) == typeid(int))
+            { simd_convert_int_double((double *)dst, (const int *)src, count); return; }
+        if (typeid(X) == typeid(int) && typeid(Y) == typeid(double))
+            { simd_convert_double_int((int *)dst, (const double *)src, count, simd_mode); return; }
+        if (typeid(X) == typeid(float) && typeid(Y) == typeid(signed char))
+            { simd_convert_int8_float((float *)dst, (const signed char *)src, count); return; }
+        if (typeid(X) == typeid(signed char) && typeid(Y) == typeid(float))
+            { simd_convert_float_int8((signed char *)dst, (const float *)src, count, simd_mode); return; }
+#endif
+// [NORMAL] scalar loop
+        if (mode == Convert_mode::TRUNCATE)
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = static_cast<X>(src[i]);
+        else
+            for (size_t i = 0; i < count; ++i)
+                dst[i] = convert_item<X, Y>(src[i], mode);
+        // return
+        return;
+    }
+}
+
+#endif // _UTILS_CONVERSION_HPP_
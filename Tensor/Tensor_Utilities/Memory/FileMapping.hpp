@@ -0,0 +1,177 @@
+// File: FileMapping.hpp
+// Description: File-backed (memory mapped) blocks for Buffer::Memory.
+//              Pages are loaded on demand by the OS, nothing is copied.
+//              (POSIX only, mapping calls fail on other systems)
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_FILE_MAPPING_HPP_
+#define _UTILS_FILE_MAPPING_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <atomic>   // std::atomic
+
+// file mapping needs mmap() (POSIX)
+#if defined(__unix__) || defined(__APPLE__)
+    #define BUFFER_FILE_MAPPING_SUPPORTED
+    #include <sys/mman.h>   // mmap(); munmap(); madvise()
+    #include <sys/stat.h>   // fstat()
+    #include <fcntl.h>      // open()
+    #include <unistd.h>     // close(); sysconf()
+#endif
+
+namespace TENSOR_UTILITIES
+{
+
+    // how a file is mapped
+    enum class Map_mode
+    {
+        // pages are shared with the file, writing is not allowed
+        // (the first mutable access copies the data to the heap)
+        READ_ONLY = 0,
+        // copy-on-write pages (MAP_PRIVATE), writes stay in this process
+        // and never reach the file
+        PRIVATE = 1
+    };
+
+    // access pattern hints (madvise())
+    enum class Map_advice
+    {
+        NORMAL = 0,
+        SEQUENTIAL = 1,
+        RANDOM = 2,
+        // start reading the pages in now
+        WILLNEED = 3,
+        // drop the pages (re-read from the file on next access)
+        // NOTE: with Map_mode::PRIVATE, written pages are lost
+        DONTNEED = 4
+    };
+
+    // a mapped file region (shared by all the Memory using it)
+    struct File_mapping
+    {
+        // owners of this mapping
+        std::atomic<size_t> refs;
+        // start and length of the mapped region (page aligned)
+        void * base;
+        size_t length;
+        // mapping mode
+        Map_mode mode;
+    };
+
+    /**
+     * @brief Maps a region of a file
+     * @param path Path to the file
+     * @param offset Offset of the region in the file (in Byte)
+     * @param length Length of the region (in Byte), 0 maps up to the end of file.
+     *        Set to the mapped length on return.
+     * @param mode Mapping mode
+     * @param data Set to the first byte of the region on return
+     * @return The mapping (one reference), nullptr if failed
+     *         (or if file mapping is not supported)
+     */
+    inline File_mapping * file_map(const char * path, size_t offset, size_t & length,
+                                   Map_mode mode, void *& data)
+    {
+#ifdef BUFFER_FILE_MAPPING_SUPPORTED
+        if (!path)
+            return nullptr;
+        int fd = open(path, O_RDONLY);
+        if (fd < 0)
+            return nullptr;
+        // get the region length
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) || (size_t)file_stat.st_size <= offset)
+        {
+            close(fd);
+            return nullptr;
+        }
+        if (length == 0)
+            length = (size_t)file_stat.st_size - offset;
+        if (length > (size_t)file_stat.st_size - offset)
+        {
+            close(fd);
+            return nullptr;
+        }
+        // mmap() wants a page aligned offset
+        const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        const size_t page_offset = offset - (offset % page);
+        const size_t map_length = length + (offset - page_offset);
+        void * base = (mode == Map_mode::READ_ONLY) ?
+            mmap(nullptr, map_length, PROT_READ, MAP_SHARED, fd, (off_t)page_offset) :
+            mmap(nullptr, map_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, (off_t)page_offset);
+        // the mapping keeps the file alive
+        close(fd);
+        if (base == MAP_FAILED)
+            return nullptr;
+        // create the mapping record
+        File_mapping * mapping = new File_mapping { {1}, base, map_length, mode };
+        data = (unsigned char *)base + (offset - page_offset);
+        return mapping;
+#else
+        (void)path; (void)offset; (void)length; (void)mode; (void)data;
+        return nullptr;
+#endif
+    }
+
+    /**
+     * @brief Adds an owner to a mapping
+     */
+    inline void file_map_acquire(File_mapping * mapping)
+    {
+        mapping->refs.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    /**
+     * @brief Removes an owner from a mapping (the last one unmaps it)
+     */
+    inline void file_map_release(File_mapping * mapping)
+    {
+        if (mapping->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+#ifdef BUFFER_FILE_MAPPING_SUPPORTED
+        munmap(mapping->base, mapping->length);
+#endif
+        delete mapping;
+        return;
+    }
+
+    /**
+     * @brief Gives an access pattern hint for a part of a mapping
+     * @param mapping The mapping
+     * @param addr Start of the part (rounded down to a page)
+     * @param length Length of the part (in Byte)
+     * @param advice The hint
+     * @return True if successful
+     */
+    inline bool file_map_advise(const File_mapping * mapping, const void * addr, size_t length, Map_advice advice)
+    {
+#ifdef BUFFER_FILE_MAPPING_SUPPORTED
+        // madvise() wants a page aligned address
+        const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        const size_t misalign = (size_t)addr % page;
+        unsigned char * start = (unsigned char *)addr - misalign;
+        length += misalign;
+        // stay inside the mapping
+        unsigned char * map_end = (unsigned char *)mapping->base + mapping->length;
+        if (start < (unsigned char *)mapping->base || start + length > map_end)
+            return false;
+        int flag = MADV_NORMAL;
+        switch (advice)
+        {
+            case Map_advice::SEQUENTIAL: flag = MADV_SEQUENTIAL; break;
+            case Map_advice::RANDOM:     flag = MADV_RANDOM;     break;
+            case Map_advice::WILLNEED:   flag = MADV_WILLNEED;   break;
+            case Map_advice::DONTNEED:   flag = MADV_DONTNEED;   break;
+            default:                     flag = MADV_NORMAL;     break;
+        }
+        return madvise(start, length, flag) == 0;
+#else
+        (void)mapping; (void)addr; (void)length; (void)advice;
+        return false;
+#endif
+    }
+}
+
+#endif // _UTILS_FILE_MAPPING_HPP_
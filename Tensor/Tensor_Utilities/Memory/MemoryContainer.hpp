@@ -13,6 +13,7 @@
 #include <cstdlib>  // malloc(); free()
 #include <utility>  // std::move()
 #include <typeinfo> // typeid()
+#include <type_traits>  // std::is_arithmetic; std::is_pointer
 
 // if not defined (overriden), define these
 #ifndef BUFFER_EXPANSION_RATIO
@@ -21,26 +22,46 @@
 #ifndef BUFFER_SHRINK_THRESHOLD
     #define BUFFER_SHRINK_THRESHOLD 2
 #endif
+// copies of at least this size (in Byte) write straight through,
+// smaller ones compare first and only copy the diverging suffix
+// (use Buffer::Memory::byte_sync() / sync_assign() to always compare)
+#ifndef BUFFER_WRITE_THROUGH_THRESHOLD
+    #define BUFFER_WRITE_THROUGH_THRESHOLD (64 * 1024)  // 64 KB
+#endif
+// raw block allocation (alignment: BUFFER_MEMORY_ALIGNMENT)
+// and the optional caching allocator (BUFFER_CACHING_ALLOCATOR)
+#include "Allocator.hpp"
+// allocation accounting (BUFFER_ALLOCATION_TELEMETRY) and tag scopes
+#include "Telemetry.hpp"
+
+// macro for copy-on-write storage
+// same-type copies share the memory block (reference counted),
+// the first mutable access (non-const get(), set(), init_all() ...)
+// gives the writer its own copy
+// NOTE: a pointer taken from non-const get() BEFORE a copy is made
+//       still points to the shared block, do not write through it
+//       (get it again after the copy)
+#ifdef BUFFER_COPY_ON_WRITE
+    #include <atomic>   // std::atomic
+    #include <new>      // placement new
+#endif // BUFFER_COPY_ON_WRITE
+
+// file-backed (memory mapped) buffers, see map_file()
+#include "FileMapping.hpp"
+
+// bulk item conversion (cross-type copy_assign())
+#include "Conversion.hpp"
 
 // macro for for allowing threaded operations
 // only affects the MemoryContainer's internal operations
+// work is submitted to the process-wide pool (see ../Parallel/ThreadPool.hpp)
 #ifdef BUFFER_THREADED_OPERATIONS
-    // define maximum number of threads to use
-    #ifndef BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT
-        #define BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT 4
-    #endif
     // define minimum size per thread (in Byte)
     #ifndef BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
         #define BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD (1024 * 1024)  // 1 MB
     #endif
-    // include pthread library (C library)
-    // NOTE: Windows users, you might need to install:
-    //       winpthread (MinGW-w64)
-    //       pthreads-win32 (vcpkg)
-    // You also have to link with pthread library
-    // (add -lpthread to your linker flags)
-    #include <pthread.h>
 #endif // BUFFER_THREADED_OPERATIONS
+#include "../Parallel/ThreadPool.hpp"
 
 // macro for buffer printing, define BUFFER_PRINT_ITEM
 // if you want to print the items in the buffer (for debugging)
@@ -87,6 +108,8 @@ namespace TENSOR_UTILITIES
         virtual void init_all(void) = 0;
         // re-generate buffer
         virtual bool allocate(size_t size) = 0;
+        // re-generate buffer, all bytes zero (already default-initialized)
+        virtual bool allocate_zeroed(size_t size) = 0;
         // adjust size of buffer (if failed, the memory remains untouched)
         virtual bool re_allocate(size_t size) = 0;
         // erase buffer (clears and de-allocates memory)
@@ -113,6 +136,10 @@ namespace TENSOR_UTILITIES
         virtual size_t get_buffer_item_count(void) const = 0;
         // gets buffer effective item-count (effective upper bound, not inclusive)
         virtual size_t get_effective_item_count(void) const = 0;
+        // checks if the buffer is backed by a mapped file
+        virtual bool is_mapped(void) const = 0;
+        // checks if the buffer is known to hold zeros only (init_all() is a no-op)
+        virtual bool is_zeroed(void) const = 0;
         // print function
         virtual void print(void) const = 0;
 
@@ -127,6 +154,21 @@ namespace TENSOR_UTILITIES
             size_t mem_size{0};
             // effective size
             size_t eff_size{0};
+            // mapped file (nullptr for heap memory)
+            File_mapping *mapping{nullptr};
+            // allocation policy (kept for every new block)
+            Alloc_policy policy{Alloc_policy::DEFAULT};
+            // policy the current block was allocated with
+            // (policy resolved with the block size)
+            Alloc_policy block_policy{Alloc_policy::DEFAULT};
+            // the current block is an anonymous mapping (allocate_zeroed()),
+            // released with munmap() instead of going back to the allocator
+            bool anonymous{false};
+            // the current block holds zeros only and was never handed out
+            // for writing (cleared by every mutable access)
+            bool zeroed{false};
+            // telemetry tag the current block is attributed to
+            unsigned int tag{0};
 
         public:
             // constructor
@@ -134,6 +176,160 @@ namespace TENSOR_UTILITIES
             // destructor
             ~Memory(void) = default;
 
+            // memory blocks (reference counted with BUFFER_COPY_ON_WRITE)
+        private:
+#ifdef BUFFER_COPY_ON_WRITE
+            // reference count type (lives in front of the block)
+            typedef std::atomic<size_t> Ref_count;
+            // header size (keeps the data aligned to BUFFER_MEMORY_ALIGNMENT)
+            static constexpr size_t HEADER_SIZE =
+                (sizeof(Ref_count) + BUFFER_MEMORY_ALIGNMENT - 1) / BUFFER_MEMORY_ALIGNMENT * BUFFER_MEMORY_ALIGNMENT;
+            // gets the reference count of a block
+            static Ref_count * ref_count(void * ptr)
+            {
+                return (Ref_count *)((unsigned char *)ptr - HEADER_SIZE);
+            }
+#endif
+            // allocates a block (reference count is 1)
+            static void * new_block(size_t size, Alloc_policy policy)
+            {
+#ifdef BUFFER_COPY_ON_WRITE
+                unsigned char * raw = (unsigned char *)policy_allocate(size + HEADER_SIZE, policy);
+                if (!raw)
+                    return nullptr;
+                new (raw) Ref_count(1);
+                return raw + HEADER_SIZE;
+#else
+                return policy_allocate(size, policy);
+#endif
+            }
+            // allocates a zero-filled block (reference count is 1)
+            static void * new_zeroed_block(size_t size, Alloc_policy policy, bool &anonymous)
+            {
+#ifdef BUFFER_COPY_ON_WRITE
+                unsigned char * raw = (unsigned char *)policy_allocate_zeroed(size + HEADER_SIZE, policy, anonymous);
+                if (!raw)
+                    return nullptr;
+                new (raw) Ref_count(1);
+                return raw + HEADER_SIZE;
+#else
+                return policy_allocate_zeroed(size, policy, anonymous);
+#endif
+            }
+            // drops a reference to a block (freed by the last owner)
+            static void drop_block(void * ptr, size_t size, Alloc_policy policy, bool anonymous, unsigned int tag)
+            {
+                if (!ptr)
+                    return;
+#ifdef BUFFER_COPY_ON_WRITE
+                Ref_count * count = Memory::ref_count(ptr);
+                if (count->fetch_sub(1, std::memory_order_acq_rel) != 1)
+                    return;
+                telemetry_release(size, tag);
+                count->~Ref_count();
+                if (anonymous)
+                    anonymous_release(count, size + HEADER_SIZE, policy);
+                else
+                    policy_release(count, size + HEADER_SIZE, policy);
+#else
+                telemetry_release(size, tag);
+                if (anonymous)
+                    anonymous_release(ptr, size, policy);
+                else
+                    policy_release(ptr, size, policy);
+#endif
+                return;
+            }
+            // releases the block of a memory (heap block or mapped file)
+            static void release_block(Memory &memory)
+            {
+                if (memory.mapping)
+                    file_map_release(memory.mapping);
+                else
+                    Memory::drop_block(memory.ptr, memory.mem_size, memory.block_policy, memory.anonymous, memory.tag);
+                memory.mapping = nullptr;
+                memory.anonymous = false;
+                memory.zeroed = false;
+                return;
+            }
+            // checks if the current block can hold new_size in place
+            static bool block_fits_in_place(const Memory &memory, size_t new_size)
+            {
+                // mappings are released with their exact size
+                if (memory.anonymous)
+                    return false;
+                // the policy should not change with the new size
+                if (resolve_policy(memory.policy, new_size) != memory.block_policy)
+                    return false;
+#ifdef BUFFER_COPY_ON_WRITE
+                return policy_fits(memory.mem_size + HEADER_SIZE, new_size + HEADER_SIZE, memory.block_policy);
+#else
+                return policy_fits(memory.mem_size, new_size, memory.block_policy);
+#endif
+            }
+
+            // sharing (copy-on-write)
+        public:
+            // checks if the block is shared with other Memory
+            // (always false for heap blocks without BUFFER_COPY_ON_WRITE)
+            static bool is_shared(const Memory &memory)
+            {
+                if (memory.mapping)
+                    return memory.mapping->refs.load(std::memory_order_acquire) > 1;
+#ifdef BUFFER_COPY_ON_WRITE
+                if (!memory.ptr)
+                    return false;
+                return Memory::ref_count(memory.ptr)->load(std::memory_order_acquire) > 1;
+#else
+                (void)memory;
+                return false;
+#endif
+            }
+            // shares a block (O(1), no copy)
+            // without BUFFER_COPY_ON_WRITE this is clone() (except mapped files)
+            static Memory share(const Memory &memory)
+            {
+                if (memory.mapping)
+                {
+                    file_map_acquire(memory.mapping);
+                    return memory;
+                }
+#ifdef BUFFER_COPY_ON_WRITE
+                if (memory.ptr)
+                    Memory::ref_count(memory.ptr)->fetch_add(1, std::memory_order_relaxed);
+                return memory;
+#else
+                return Memory::clone(memory);
+#endif
+            }
+            // gives the memory its own writable block
+            // (if shared or mapped read-only, the data is copied to the heap)
+            // set keep_content to false if all content is going to be overwritten
+            // returns false if the allocation failed (memory is untouched)
+            static bool detach(Memory &memory, bool keep_content = true)
+            {
+                // about to be written
+                memory.zeroed = false;
+                if (!Memory::is_shared(memory) &&
+                    !(memory.mapping && memory.mapping->mode == Map_mode::READ_ONLY))
+                    return true;
+                // own block
+                const Alloc_policy own_policy = resolve_policy(memory.policy, memory.mem_size);
+                void * own_ptr = Memory::new_block(memory.mem_size, own_policy);
+                if (!own_ptr)
+                    return false;
+                if (keep_content)
+                    Memory::byte_copy(0, memory.eff_size, own_ptr, memory.ptr);
+                const unsigned int own_tag = telemetry_allocate(memory.mem_size);
+                // drop the shared one
+                Memory::release_block(memory);
+                memory.ptr = own_ptr;
+                memory.block_policy = own_policy;
+                memory.tag = own_tag;
+                // return
+                return true;
+            }
+
             // allocation & de-allocation
         public:
             // static function for allocation (size in Byte)
@@ -141,11 +337,38 @@ namespace TENSOR_UTILITIES
             {
                 // de-allocate first
                 Memory::de_allocate(memory);
-                // allocate memory
-                memory.ptr = malloc(size);
+                // allocate memory (aligned to BUFFER_MEMORY_ALIGNMENT)
+                // with the memory's allocation policy
+                const Alloc_policy policy = resolve_policy(memory.policy, size);
+                memory.ptr = Memory::new_block(size, policy);
                 // error checking
                 if (!memory.ptr)
                     return false;
+                memory.block_policy = policy;
+                memory.tag = telemetry_allocate(size);
+                // update other attributes
+                memory.mem_size = size;
+                memory.eff_size = 0;
+                // return
+                return true;
+            }
+            // static function for zero-filled allocation (size in Byte)
+            // large blocks are fresh pages (see policy_allocate_zeroed())
+            static bool allocate_zeroed(size_t size, Memory &memory)
+            {
+                // de-allocate first
+                Memory::de_allocate(memory);
+                // allocate zero-filled memory with the memory's allocation policy
+                const Alloc_policy policy = resolve_policy(memory.policy, size);
+                bool anonymous = false;
+                memory.ptr = Memory::new_zeroed_block(size, policy, anonymous);
+                // error checking
+                if (!memory.ptr)
+                    return false;
+                memory.block_policy = policy;
+                memory.anonymous = anonymous;
+                memory.zeroed = true;
+                memory.tag = telemetry_allocate(size);
                 // update other attributes
                 memory.mem_size = size;
                 memory.eff_size = 0;
@@ -155,8 +378,9 @@ namespace TENSOR_UTILITIES
             // static function for de-allocation
             static void de_allocate(Memory &memory)
             {
-                // delete memory
-                free(memory.ptr);
+                // delete memory (hands it to the cache if enabled)
+                // a shared block is only freed by its last owner
+                Memory::release_block(memory);
                 // clear ptr
                 memory.ptr = nullptr;
                 // update other attributes
@@ -165,23 +389,55 @@ namespace TENSOR_UTILITIES
                 // return
                 return;
             }
-            // static function to reallocate (should be faster)
+            // static function to reallocate
             static bool re_allocate(size_t size, Memory &memory)
             {
                 /*
                 NOTE:
+                realloc() does not keep the alignment, so we allocate
+                a new aligned block, move the content and free the old one.
                 If there is not enough memory, the old memory block
-                is not freed and null pointer is returned.
-                If ptr is NULL, the behavior is the same as calling malloc(new_size)
+                is not freed and false is returned.
+                If ptr is NULL, the behavior is the same as allocate()
+                With the caching allocator, a size in the same size class
+                is served in place (the block is already large enough).
+                A shared block (copy-on-write) or a mapped file is never
+                resized in place.
+                The allocation policy of the memory is kept.
                 */
 
-                // try reallocate buffer
-                void * realloc_ptr = realloc(memory.ptr, size);
+                // same reserved block, nothing to move
+                if (memory.ptr && !memory.mapping && !Memory::is_shared(memory) &&
+                    Memory::block_fits_in_place(memory, size))
+                {
+                    // bytes past the old size are not cleared
+                    memory.zeroed = false;
+                    telemetry_resize(memory.mem_size, size, memory.tag);
+                    memory.mem_size = size;
+                    if (memory.eff_size > size)
+                        memory.eff_size = size;
+                    return true;
+                }
+
+                // try allocate new buffer
+                const Alloc_policy policy = resolve_policy(memory.policy, size);
+                void * realloc_ptr = Memory::new_block(size, policy);
                 // error checking
                 if (!realloc_ptr)
                     return false;
+                const unsigned int tag = telemetry_allocate(size);
+                // move the content (as much as fits) and free the old block
+                if (memory.ptr)
+                {
+                    size_t to_keep = (memory.mem_size < size) ? memory.mem_size : size;
+                    Memory::byte_copy(0, to_keep, realloc_ptr, memory.ptr);
+                    telemetry_realloc_copy(to_keep);
+                    Memory::release_block(memory);
+                }
                 // update memory pointer
                 memory.ptr = realloc_ptr;
+                memory.block_policy = policy;
+                memory.tag = tag;
                 // update other attributes
                 memory.mem_size = size;
                 if (memory.eff_size > size)
@@ -191,6 +447,35 @@ namespace TENSOR_UTILITIES
                 return true;
             }
 
+            // file mapping
+        public:
+            // static function to map a file region (size in Byte, 0 maps up to the end of file)
+            // the old memory is released only if successful
+            static bool map_file(const char *path, size_t offset, size_t size, Map_mode mode, Memory &memory)
+            {
+                // map first (memory untouched if failed)
+                void *data = nullptr;
+                File_mapping *mapping = file_map(path, offset, size, mode, data);
+                if (!mapping)
+                    return false;
+                // replace the old memory
+                Memory::de_allocate(memory);
+                memory.ptr = data;
+                memory.mapping = mapping;
+                memory.mem_size = size;
+                memory.eff_size = size;
+                // return
+                return true;
+            }
+            // static function to give an access pattern hint for range [start, end) (in Byte)
+            // only mapped files accept hints
+            static bool advise(const Memory &memory, size_t start, size_t end, Map_advice advice)
+            {
+                if (!memory.mapping || start >= end || end > memory.mem_size)
+                    return false;
+                return file_map_advise(memory.mapping, (const unsigned char *)memory.ptr + start, end - start, advice);
+            }
+
             // utilities
         public:
             // comparison result
@@ -281,10 +566,21 @@ namespace TENSOR_UTILITIES
                     return Cmp_result{Cmp_result::Cmp::NOT_EQUAL, 0};
             }
 
+            // whether a range is large enough for non-temporal stores
+            // (decided on the whole range, threaded parts are smaller)
+            static bool streamed(size_t start, size_t end)
+            {
+#ifdef BUFFER_ENABLE_SIMD
+                return (end > start) && ((end - start) >= SIMD_STREAM_THRESHOLD);
+#else
+                (void)start; (void)end;
+                return false;
+#endif
+            }
             // byte copier (will NOT check if the indexes are in range)
-            // copy range [start, end)
+            // copy range [start, end), stream: bypass the cache (SIMD only)
             // [INTERNAL VERSION] - WILL NOT DO SAFETY CHECK (i.e. start < end)
-            static void _byte_copy(size_t start, size_t end, void * dst, const void * src)
+            static void _byte_copy(size_t start, size_t end, void * dst, const void * src, bool stream)
             {
                 // calculate size to copy
                 size_t bytes_to_copy = end - start;
@@ -295,6 +591,7 @@ namespace TENSOR_UTILITIES
 
 // [NORMAL] using size_t to perform batch copying
 #ifndef BUFFER_ENABLE_SIMD
+                (void)stream;
                 // align pointer to offset of (size_t)
                 // since dst and src should all be Memory::ptr allocated by malloc
                 // they should be aligned by default, adding the same 'start', meaning
@@ -355,8 +652,16 @@ namespace TENSOR_UTILITIES
 
 // [SIMD] uses precompiled external C library
 #else
+                // large copy, non-temporal stores
+                if (stream)
+                    simd_copy_stream(dst_bytes, src_bytes, bytes_to_copy);
+                // both pointers on a vector boundary (i.e. copying from the
+                // start of two buffers), skip the alignment bookkeeping
+                else if (!(((size_t)dst_bytes | (size_t)src_bytes) & (simd_get_vecsize() - 1)))
+                    simd_copy_aligned(dst_bytes, src_bytes, bytes_to_copy);
                 // use SIMD function
-                simd_copy_any(dst_bytes, src_bytes, bytes_to_copy);
+                else
+                    simd_copy_any(dst_bytes, src_bytes, bytes_to_copy);
 
                 // return
                 return;
@@ -368,91 +673,34 @@ namespace TENSOR_UTILITIES
 // [NORMAL] single threaded copy
 #ifndef BUFFER_THREADED_OPERATIONS
                 // directly call our _byte_copy internal function
-                _byte_copy(start, end, dst, src);
+                _byte_copy(start, end, dst, src, Memory::streamed(start, end));
                 // DONE
                 return;
-// [THREADED] threaded copy
+// [THREADED] threaded copy (on the process-wide pool)
 #else
                 // if nothing, we return
                 if (start >= end) return;
-                // calculate total size to copy
-                size_t total_size = end - start;
-                // calculate thread to use
-                // (also make sure we have large enough chunk for each thread)
-                size_t thread_count = total_size / BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD;
-                // make sure we don't exceed maximum thread count
-                if (thread_count > BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT)
-                    thread_count = BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT;
-                // if thread count is now 0, fall back to single-threaded copy
-                if (thread_count <= 1)
+                // arguments for the parts
+                struct copier_arg
                 {
-                    _byte_copy(start, end, dst, src);
-                    return;
-                }
-                // calculate size per thread
-                size_t size_per_thread = total_size / thread_count;
-                // calculate remaining size (for the last thread)
-                size_t remaining_size = total_size % thread_count;
-
-                // define thread data structure
-                struct copier_thread
-                {
-                    size_t start;
-                    size_t end;
                     void *dst;
                     const void *src;
+                    bool stream;
                 };
-                // create thread data array
-                copier_thread * thread_data = (copier_thread *)malloc(thread_count * sizeof(copier_thread));
-                // create thread array
-                pthread_t * threads = (pthread_t *)malloc(thread_count * sizeof(pthread_t));
-                // error checking for malloc
-                if (!thread_data || !threads)
-                {
-                    // if malloc failed, we terminate
-                    free(thread_data);
-                    free(threads);
-                    return;
-                }
-
-                // thread function (worker)
+                copier_arg arg { dst, src, Memory::streamed(start, end) };
+                // each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+                // (small copies stay on this thread)
+                // pool accepts a function with type void (*)(size_t, size_t, void*)
                 // we use a C++11 lambda function for simplicity
-                // pthread accepts a function with type void * (*)(void*)
-                void * (*thread_func)(void *) = [](void *arg) -> void *
-                {
-                    // convert argument to copier_thread pointer
-                    copier_thread *data = (copier_thread *)arg;
-                    // call the internal byte copy function for this thread's range
-                    Memory::_byte_copy(data->start, data->end, data->dst, data->src);
-                    // return (nothing to return)
-                    return nullptr;
-                };
-
-                // assign thread data
-                for (size_t i = 0; i < thread_count; ++i)
-                {
-                    thread_data[i].start = start + i * size_per_thread;
-                    thread_data[i].end = (start + (i + 1) * size_per_thread);
-                    // add remaining size to the last thread
-                    if (i == thread_count - 1)
-                        thread_data[i].end += remaining_size;
-                    thread_data[i].dst = dst;
-                    thread_data[i].src = src;
-                }
-
-                // create threads
-                for (size_t i = 0; i < thread_count; ++i)
-                    pthread_create(&threads[i], nullptr, thread_func, &thread_data[i]);
-
-                // wait for threads to finish
-                for (size_t i = 0; i < thread_count; ++i)
-                    pthread_join(threads[i], nullptr);
-
-                // free thread data
-                free(thread_data);
-                // free thread array
-                free(threads);
-
+                parallel_for(start, end, BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD,
+                    [](size_t part_start, size_t part_end, void *part_arg)
+                    {
+                        // convert argument to copier_arg pointer
+                        copier_arg *data = (copier_arg *)part_arg;
+                        // call the internal byte copy function for this part's range
+                        Memory::_byte_copy(part_start, part_end, data->dst, data->src, data->stream);
+                    },
+                    &arg);
                 // return
                 return;
 #endif
@@ -461,7 +709,9 @@ namespace TENSOR_UTILITIES
             static Memory clone(const Memory &memory)
             {
                 // create a Memory struct to return
+                // (same allocation policy)
                 Memory to_return{};
+                to_return.policy = memory.policy;
                 // allocate memory
                 if (!Memory::allocate(memory.mem_size, to_return))
                     return to_return;
@@ -473,16 +723,57 @@ namespace TENSOR_UTILITIES
                 return to_return;
             }
             // copy from one to another
-            // copier will minimize items to copy
+            // large copies (BUFFER_WRITE_THROUGH_THRESHOLD) and stale
+            // destinations are written through, small ones are synced
+            // (see byte_sync())
             static Memory &byte_copier(Memory &dst, const Memory &src)
+            {
+                // same buffer / block, nothing to copy
+                if (&dst == &src)
+                    return dst;
+                if (dst.ptr && dst.ptr == src.ptr)
+                {
+                    dst.eff_size = src.eff_size;
+                    return dst;
+                }
+                // comparing only pays off when dst may already hold
+                // most of src, and reading both buffers is cheap
+                const bool stale = (!dst.ptr || !dst.eff_size ||
+                                    dst.mem_size < src.eff_size ||
+                                    Memory::is_shared(dst) ||
+                                    (dst.mapping && dst.mapping->mode == Map_mode::READ_ONLY));
+                if (!stale && src.eff_size < BUFFER_WRITE_THROUGH_THRESHOLD)
+                    return Memory::byte_sync(dst, src);
+                // write through (no read pass over dst)
+                return Memory::copy_from(dst, src, 0);
+            }
+            // incremental sync from one to another
+            // compares first and copies only the diverging suffix
+            // (use it when dst is known to be mostly up to date)
+            static Memory &byte_sync(Memory &dst, const Memory &src)
             {
                 // first, compare before copy
                 const Cmp_result &ret = Memory::byte_cmp(dst, src);
                 // if equal, do nothing and return
                 if (ret.flag == Cmp_result::Cmp::EQUAL)
                     return dst;
-
-                // now, actions have to be taken
+                // copy from the first difference
+                return Memory::copy_from(dst, src, ret.num_identical);
+            }
+        private:
+            // copies src into dst, the first 'identical' bytes are
+            // already the same (skipped)
+            static Memory &copy_from(Memory &dst, const Memory &src, size_t identical)
+            {
+                // about to be written
+                dst.zeroed = false;
+                // we cannot write into a shared or read-only block, drop it
+                if (Memory::is_shared(dst) ||
+                    (dst.mapping && dst.mapping->mode == Map_mode::READ_ONLY))
+                {
+                    Memory::de_allocate(dst);
+                    identical = 0;
+                }
                 // check if other is empty
                 if (src.eff_size == 0)
                 {
@@ -500,8 +791,6 @@ namespace TENSOR_UTILITIES
                     if (!Memory::allocate(src.mem_size, dst))
                         return dst;
 
-                // get number of identical items (items to skip copying)
-                size_t identical = ret.num_identical;
                 /*
                     Does NOT need copy:
                     identical >= other.effective_size
@@ -565,7 +854,8 @@ namespace TENSOR_UTILITIES
         MemoryContainer(const MemoryContainer &other) : MemoryContainer()
         {
             // copy memory buffer (Byte-by-Byte)
-            this->buffer = Buffer::Memory::clone(other.buffer);
+            // or share it (BUFFER_COPY_ON_WRITE)
+            this->buffer = Buffer::Memory::share(other.buffer);
             // return
             return;
         }
@@ -578,6 +868,9 @@ namespace TENSOR_UTILITIES
             other.buffer.ptr = nullptr;
             other.buffer.mem_size = 0;
             other.buffer.eff_size = 0;
+            other.buffer.mapping = nullptr;
+            other.buffer.anonymous = false;
+            other.buffer.zeroed = false;
             // return
             return;
         }
@@ -588,24 +881,23 @@ namespace TENSOR_UTILITIES
                 Buffer::Memory::de_allocate(this->buffer);
             return;
         }
-
-        // interface (operations) override
-    public:
-        // initialize all allocated memory blocks
-        void init_all(void) override
+        // checks if T{} is all zero bytes (arithmetic types and pointers)
+        static constexpr bool zero_is_default(void)
         {
-            // if no element, return
-            if (!this->buffer.ptr)
-                return;
-            // get pointer
-            T *ptr = (T *)this->buffer.ptr;
+            return std::is_arithmetic<T>::value || std::is_pointer<T>::value;
+        }
 
-// [NORMAL] using size_t to perform batch copying
+        // internal helpers
+    private:
+        // initialize items in range [start, end), stream: bypass the cache (SIMD only)
+        // [INTERNAL VERSION] - WILL NOT DO SAFETY CHECK (i.e. start < end)
+        static void _init_range(T *ptr, size_t start, size_t end, bool stream)
+        {
+// [NORMAL] loop and init
 #ifndef BUFFER_ENABLE_SIMD
 
-            // loop and init
-            const size_t count = this->buffer.mem_size / this->dtype_size;
-            for (size_t i = 0; i < count; ++i)
+            (void)stream;
+            for (size_t i = start; i < end; ++i)
                 ptr[i] = T{};
             // return
             return;
@@ -615,13 +907,65 @@ namespace TENSOR_UTILITIES
 
             // create a single default init value
             T default_value = T{ };
-            // Use SIMD function
-            simd_fill_any(ptr, &default_value, this->buffer.mem_size, sizeof(T));
+            // large fill, non-temporal stores
+            if (stream)
+                simd_fill_stream(ptr + start, &default_value, (end - start) * sizeof(T), sizeof(T));
+            // Use SIMD function (aligned version if we start on a vector boundary)
+            else if (!((size_t)(ptr + start) & (simd_get_vecsize() - 1)))
+                simd_fill_aligned(ptr + start, &default_value, (end - start) * sizeof(T), sizeof(T));
+            else
+                simd_fill_any(ptr + start, &default_value, (end - start) * sizeof(T), sizeof(T));
             // return
             return;
 
 #endif
         }
+
+        // interface (operations) override
+    public:
+        // initialize all allocated memory blocks
+        // (nothing to do on a zeroed block, T{} is all zero bytes)
+        void init_all(void) override
+        {
+            // if no element, return
+            if (!this->buffer.ptr)
+                return;
+            // still zero (allocate_zeroed(), never handed out for writing)
+            if (MemoryContainer<T>::zero_is_default() && this->buffer.zeroed)
+                return;
+            // own block (old content is overwritten anyway)
+            if (!Buffer::Memory::detach(this->buffer, false))
+                return;
+            // item count to initialise
+            const size_t count = this->buffer.mem_size / this->dtype_size;
+            // large buffers are written around the cache
+            const bool stream = Buffer::Memory::streamed(0, this->buffer.mem_size);
+
+// [THREADED] split the items over the process-wide pool
+#ifdef BUFFER_THREADED_OPERATIONS
+            // arguments for the parts
+            struct init_arg
+            {
+                T *ptr;
+                bool stream;
+            };
+            init_arg arg { (T *)this->buffer.ptr, stream };
+            // each part is at least BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD
+            size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / this->dtype_size;
+            parallel_for(0, count, min_items,
+                [](size_t start, size_t end, void *part_arg)
+                {
+                    init_arg *data = (init_arg *)part_arg;
+                    MemoryContainer<T>::_init_range(data->ptr, start, end, data->stream);
+                },
+                &arg);
+// [NORMAL] single threaded
+#else
+            MemoryContainer<T>::_init_range((T *)this->buffer.ptr, 0, count, stream);
+#endif
+            // return
+            return;
+        }
         // re-generate buffer
         bool allocate(size_t num_of_item) override
         {
@@ -635,6 +979,20 @@ namespace TENSOR_UTILITIES
             else
                 return false;
         }
+        // re-generate buffer, all bytes zero
+        // (large buffers are fresh pages, nothing is written)
+        bool allocate_zeroed(size_t num_of_item) override
+        {
+            if (num_of_item <= 0)
+                return false;
+            // allocate (Memory will help us de-allocate)
+            Buffer::Memory::allocate_zeroed(num_of_item * this->dtype_size, this->buffer);
+            // error checking
+            if (this->buffer.ptr)
+                return true;
+            else
+                return false;
+        }
         // adjust size of buffer (if failed, the memory remains untouched)
         bool re_allocate(size_t num_of_item) override
         {
@@ -657,11 +1015,13 @@ namespace TENSOR_UTILITIES
         // append to buffer
         bool append(const void * item_ptr, bool expand_buffer = true, size_t expansion_ratio = BUFFER_EXPANSION_RATIO) override
         {
+            // about to be written
+            this->buffer.zeroed = false;
             // get references of memory attributes
             size_t eff_sz = this->buffer.eff_size / this->dtype_size;
             size_t mem_sz = this->buffer.mem_size / this->dtype_size;
-            // we have enough space
-            if (eff_sz < mem_sz)
+            // we have enough space (and own the block)
+            if (eff_sz < mem_sz && Buffer::Memory::detach(this->buffer))
             {
                 ((T *)this->buffer.ptr)[eff_sz] = (*(const T *)item_ptr);
                 this->buffer.eff_size += this->dtype_size;
@@ -704,10 +1064,13 @@ namespace TENSOR_UTILITIES
             return;
         }
         // get item from buffer
+        // (non-const access: gives this container its own block if shared)
         void *get(size_t idx) override
         {
             if (!this->idx_in_range(idx))
                 return nullptr;
+            if (!Buffer::Memory::detach(this->buffer))
+                return nullptr;
             T *ptr = ((T *)this->buffer.ptr) + idx;
             return ((void *)(ptr));
         }
@@ -759,12 +1122,21 @@ namespace TENSOR_UTILITIES
         size_t get_buffer_item_count(void) const override { return (this->buffer.mem_size / this->dtype_size); }
         // gets buffer effective item-count (effective upper bound, not inclusive)
         size_t get_effective_item_count(void) const override { return (this->buffer.eff_size / this->dtype_size); }
+        // checks if the buffer is backed by a mapped file
+        bool is_mapped(void) const override { return (this->buffer.mapping != nullptr); }
+        // checks if the buffer is known to hold zeros only (init_all() is a no-op)
+        bool is_zeroed(void) const override { return (this->buffer.ptr != nullptr) && this->buffer.zeroed; }
         // print function
         void print(void) const override
         {
             const size_t mem_sz = this->buffer.mem_size / this->dtype_size;
             const size_t eff_sz = this->buffer.eff_size / this->dtype_size;
             printf("Buffer info:\n\t[PTR ADDR] %p\n\t[BUF SIZE] %zu byte(s)\n\t[EFF SIZE] %zu byte(s)\n", this->buffer.ptr, this->buffer.mem_size, this->buffer.eff_size);
+            if (this->buffer.mapping)
+                printf("\t[MAPPED]   %s\n", (this->buffer.mapping->mode == Map_mode::READ_ONLY) ? "read-only" : "private");
+            else
+                printf("\t[POLICY]   %s (block: %s)\n", policy_name(this->buffer.policy),
+                       this->buffer.ptr ? policy_name(this->buffer.block_policy) : "none");
             printf("Container info:\n\t[BUF ITEM] %zu\n\t[EFF ITEM] %zu\n", mem_sz, eff_sz);
 // print items if needed
 #ifdef BUFFER_PRINT_ITEM
@@ -791,25 +1163,134 @@ namespace TENSOR_UTILITIES
             return;
         }
 
+        // allocation policy
+    public:
+        /**
+         * @brief Sets the allocation policy of this container
+         * @param policy DEFAULT / HUGE_PAGE / LOCKED / HUGE_PAGE_LOCKED
+         * @return True if successful, false otherwise (policy untouched)
+         * @note The policy is kept for every later allocation (allocate(),
+         *       re_allocate(), append(), shrink()). The current block is moved
+         *       to a block of the new policy right away (mapped files are not).
+         */
+        bool set_alloc_policy(Alloc_policy policy)
+        {
+            const Alloc_policy old_policy = this->buffer.policy;
+            this->buffer.policy = policy;
+            // move the current block if needed
+            if (this->buffer.ptr && !this->buffer.mapping &&
+                resolve_policy(policy, this->buffer.mem_size) != this->buffer.block_policy)
+            {
+                if (!Buffer::Memory::re_allocate(this->buffer.mem_size, this->buffer))
+                {
+                    this->buffer.policy = old_policy;
+                    return false;
+                }
+            }
+            // return
+            return true;
+        }
+        // gets the allocation policy of this container
+        Alloc_policy get_alloc_policy(void) const { return this->buffer.policy; }
+
+        // file mapping
+    public:
+        /**
+         * @brief Maps a file as the buffer (no copy, pages load on demand)
+         * @param path Path to the file
+         * @param offset Offset of the first item in the file (in Byte),
+         *        should be a multiple of alignof(T)
+         * @param num_of_item Number of items to map, 0 maps up to the end of file
+         * @param mode Map_mode::READ_ONLY (first mutable access copies the
+         *        data to the heap) or Map_mode::PRIVATE (pages are copied
+         *        by the OS on write, the file is never changed)
+         * @return True if successful, false otherwise (buffer untouched)
+         * @note All items are effective. Copies share the mapping.
+         */
+        bool map_file(const char * path, size_t offset = 0, size_t num_of_item = 0, Map_mode mode = Map_mode::READ_ONLY)
+        {
+            if (offset % alignof(T))
+                return false;
+            // map into a temporary first (buffer untouched if failed)
+            Buffer::Memory mapped { };
+            if (!Buffer::Memory::map_file(path, offset, num_of_item * this->dtype_size, mode, mapped))
+                return false;
+            // whole items only
+            mapped.mem_size -= mapped.mem_size % this->dtype_size;
+            mapped.eff_size = mapped.mem_size;
+            if (mapped.mem_size == 0)
+            {
+                Buffer::Memory::de_allocate(mapped);
+                return false;
+            }
+            // replace the buffer (keep the allocation policy)
+            Buffer::Memory::de_allocate(this->buffer);
+            mapped.policy = this->buffer.policy;
+            this->buffer = mapped;
+            // return
+            return true;
+        }
+        /**
+         * @brief Gives an access pattern hint for the mapped items
+         * @param advice The hint (see Map_advice)
+         * @param start First item of the range
+         * @param num_of_item Number of items, 0 means up to the end
+         * @return True if successful, false otherwise
+         *         (or if the buffer is not a mapped file)
+         */
+        bool advise(Map_advice advice, size_t start = 0, size_t num_of_item = 0) const
+        {
+            const size_t mem_sz = this->buffer.mem_size / this->dtype_size;
+            if (start >= mem_sz)
+                return false;
+            if (num_of_item == 0 || num_of_item > mem_sz - start)
+                num_of_item = mem_sz - start;
+            return Buffer::Memory::advise(this->buffer, start * this->dtype_size,
+                                          (start + num_of_item) * this->dtype_size, advice);
+        }
+
         // casting (friend function declaration)
     public:
         // friend function: copy assignment
+        // (mode only matters for cross-type copies, see Convert_mode)
         template <typename X, typename Y>
-        friend void copy_assign(MemoryContainer<X> &dst, const MemoryContainer<Y> &src);
+        friend void copy_assign(MemoryContainer<X> &dst, const MemoryContainer<Y> &src, Convert_mode mode);
         // friend function: move assignment (ONLY applicable to same type)
         template <typename X>
         friend void move_assign(MemoryContainer<X> &dst, MemoryContainer<X> &&src);
+        // friend function: incremental sync (ONLY applicable to same type)
+        template <typename X>
+        friend void sync_assign(MemoryContainer<X> &dst, const MemoryContainer<X> &src);
     };
 
     /* friend function definition */
     // friend function: copy assignment
     template <typename X, typename Y>
-    void copy_assign(MemoryContainer<X> &dst, const MemoryContainer<Y> &src)
+    void copy_assign(MemoryContainer<X> &dst, const MemoryContainer<Y> &src, Convert_mode mode)
     {
         if (typeid(dst) == typeid(src))
         {
             // same type copying
-            Buffer::Memory::byte_copier(dst.buffer, src.buffer);
+#ifndef BUFFER_COPY_ON_WRITE
+            // heap blocks are copied
+            if (!src.buffer.mapping)
+            {
+                Buffer::Memory::byte_copier(dst.buffer, src.buffer);
+                return;
+            }
+#endif
+            // share the block (O(1)), copied on the first write
+            // (always for mapped files)
+            if (dst.buffer.ptr != src.buffer.ptr)
+            {
+                Buffer::Memory shared = Buffer::Memory::share(src.buffer);
+                Buffer::Memory::de_allocate(dst.buffer);
+                // the destination keeps its allocation policy
+                shared.policy = dst.buffer.policy;
+                dst.buffer = shared;
+            }
+            else
+                dst.buffer.eff_size = src.buffer.eff_size;
             // return
             return;
         }
@@ -823,18 +1304,57 @@ namespace TENSOR_UTILITIES
                 if (!dst.allocate(src_effective_item_count))
                     return;
             }
-            // get the pointers
-            X *dst_ptr = (X *)dst.buffer.ptr;
-            const Y *src_ptr = (const Y *)src.buffer.ptr;
-            // copy using operator= (assume it is usable)
-            for (size_t i = 0; i < src_effective_item_count; ++i)
-                dst_ptr[i] = src_ptr[i];
+            // own block (if shared, content is overwritten)
+            else if (!Buffer::Memory::detach(dst.buffer, false))
+                return;
+            // arguments for the parts
+            struct convert_arg
+            {
+                X *dst;
+                const Y *src;
+                Convert_mode mode;
+            };
+            convert_arg arg { (X *)dst.buffer.ptr, (const Y *)src.buffer.ptr, mode };
+            // each part converts a slice (vectorized for the common pairs)
+#ifdef BUFFER_THREADED_OPERATIONS
+            size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(X);
+#else
+            size_t min_items = src_effective_item_count;
+#endif
+            parallel_for(0, src_effective_item_count, min_items,
+                [](size_t part_start, size_t part_end, void *part_arg)
+                {
+                    convert_arg *data = (convert_arg *)part_arg;
+                    convert_items(data->dst + part_start, data->src + part_start,
+                                  part_end - part_start, data->mode);
+                },
+                &arg);
             // set effective size
             dst.buffer.eff_size = src_effective_item_count * dst.dtype_size;
             // return
             return;
         }
     }
+    // copy assignment (cross-type items are truncated, i.e. plain casts)
+    template <typename X, typename Y>
+    void copy_assign(MemoryContainer<X> &dst, const MemoryContainer<Y> &src)
+    {
+        copy_assign(dst, src, Convert_mode::TRUNCATE);
+        return;
+    }
+    // friend function: incremental sync (ONLY applicable to same type)
+    // compares first and copies only the diverging suffix, use it when dst
+    // is known to be mostly up to date (i.e. a mirror that gets appended to),
+    // copy_assign() writes large buffers straight through instead
+    // (the block is never shared, even with BUFFER_COPY_ON_WRITE)
+    template <typename X>
+    void sync_assign(MemoryContainer<X> &dst, const MemoryContainer<X> &src)
+    {
+        if (&dst == &src)
+            return;
+        Buffer::Memory::byte_sync(dst.buffer, src.buffer);
+        return;
+    }
     // friend function: move assignment (ONLY applicable to same type)
     template <typename X>
     void move_assign(MemoryContainer<X> &dst, MemoryContainer<X> &&src)
@@ -844,11 +1364,17 @@ namespace TENSOR_UTILITIES
             Buffer::Memory::de_allocate(dst.buffer);
 
         // copy assign memory attributes
+        // (the destination keeps its allocation policy)
+        const Alloc_policy dst_policy = dst.buffer.policy;
         dst.buffer = src.buffer;
+        dst.buffer.policy = dst_policy;
         // detach source
         src.buffer.ptr = nullptr;
         src.buffer.mem_size = 0;
         src.buffer.eff_size = 0;
+        src.buffer.mapping = nullptr;
+        src.buffer.anonymous = false;
+        src.buffer.zeroed = false;
         // return
         return;
     }
@@ -0,0 +1,486 @@
+// File: SegmentedContainer.hpp
+// Description: Buffer made of fixed-size segments (chunked growth).
+//              append() never moves the stored items, get() goes
+//              through a segment table, flatten() packs everything
+//              into one contiguous MemoryContainer.
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_SEGMENTED_CONTAINER_HPP_
+#define _UTILS_SEGMENTED_CONTAINER_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdio>
+#include <cstdlib>  // malloc(); free()
+#include <new>      // placement new
+#include <utility>  // std::move()
+
+#include "MemoryContainer.hpp"
+
+// default segment size (in Byte), rounded down to a power of 2 items
+// (one item at least), can be set per container in the constructor
+#ifndef BUFFER_SEGMENT_SIZE
+    #define BUFFER_SEGMENT_SIZE (256 * 1024)  // 256 KB
+#endif
+
+namespace TENSOR_UTILITIES
+{
+
+    /**
+     * @brief Buffer growing by fixed-size segments (no relocation)
+     * @note Streaming many items with MemoryContainer::append() copies the
+     *       whole payload on every expansion (and needs the old and the new
+     *       block at the same time). Here every segment is allocated once,
+     *       so appending only ever allocates one segment.
+     * @note Segments are Buffer::Memory blocks (allocation policy, caching
+     *       allocator, copy-on-write and telemetry apply to each of them).
+     * @note get() is O(1): segment index by shift, offset by mask.
+     *       Use flatten() to get a contiguous MemoryContainer (for a tensor).
+     */
+    template <typename T>
+    class SegmentedContainer : public Buffer
+    {
+    private:
+        // segment table (segment_count used, table_capacity allocated)
+        Buffer::Memory * segments{nullptr};
+        size_t segment_count{0};
+        size_t table_capacity{0};
+        // items per segment is 1 << segment_shift
+        size_t segment_shift{0};
+        // effective item count
+        size_t item_count{0};
+        // allocation policy of new segments
+        Alloc_policy policy{Alloc_policy::DEFAULT};
+        // records size of data-type
+        const size_t dtype_size{};
+
+        // constructor and destructor
+    public:
+        /**
+         * @brief Constructor
+         * @param segment_items Items per segment (rounded up to a power of 2),
+         *        0 uses BUFFER_SEGMENT_SIZE
+         */
+        explicit SegmentedContainer(size_t segment_items = 0) : Buffer(), dtype_size(sizeof(T))
+        {
+            // default: largest power of 2 items fitting in BUFFER_SEGMENT_SIZE
+            if (!segment_items)
+            {
+                const size_t fit = BUFFER_SEGMENT_SIZE / sizeof(T);
+                while (((size_t)2 << this->segment_shift) <= fit)
+                    ++this->segment_shift;
+                return;
+            }
+            while (((size_t)1 << this->segment_shift) < segment_items)
+                ++this->segment_shift;
+            return;
+        }
+        // copy constructor (segments are shared with BUFFER_COPY_ON_WRITE)
+        SegmentedContainer(const SegmentedContainer &other) : SegmentedContainer()
+        {
+            this->segment_shift = other.segment_shift;
+            this->policy = other.policy;
+            if (!this->reserve_table(other.segment_count))
+                return;
+            for (size_t i = 0; i < other.segment_count; ++i)
+            {
+                this->segments[i] = Buffer::Memory::share(other.segments[i]);
+                // error checking (clone failed)
+                if (!this->segments[i].ptr)
+                {
+                    this->erase();
+                    return;
+                }
+                ++this->segment_count;
+            }
+            this->item_count = other.item_count;
+            // return
+            return;
+        }
+        // move constructor
+        SegmentedContainer(SegmentedContainer &&other) : SegmentedContainer()
+        {
+            // take the table
+            this->segments = other.segments;
+            this->segment_count = other.segment_count;
+            this->table_capacity = other.table_capacity;
+            this->segment_shift = other.segment_shift;
+            this->item_count = other.item_count;
+            this->policy = other.policy;
+            // reset other
+            other.segments = nullptr;
+            other.segment_count = 0;
+            other.table_capacity = 0;
+            other.item_count = 0;
+            // return
+            return;
+        }
+        // destructor
+        ~SegmentedContainer(void) override
+        {
+            this->erase();
+            return;
+        }
+
+        // no assignment (use the copy / move constructors)
+        SegmentedContainer & operator= (const SegmentedContainer &other) = delete;
+        SegmentedContainer & operator= (SegmentedContainer &&other) = delete;
+
+        // internal helpers
+    private:
+        // bytes per segment
+        size_t segment_bytes(void) const { return ((size_t)1 << this->segment_shift) * this->dtype_size; }
+        // makes room for count entries in the segment table
+        bool reserve_table(size_t count)
+        {
+            if (count <= this->table_capacity)
+                return true;
+            size_t capacity = this->table_capacity ? this->table_capacity : 1;
+            while (capacity < count)
+                capacity *= 2;
+            Buffer::Memory * table = (Buffer::Memory *)malloc(capacity * sizeof(Buffer::Memory));
+            if (!table)
+                return false;
+            // the table holds descriptors only, the segments do not move
+            for (size_t i = 0; i < capacity; ++i)
+                new (table + i) Buffer::Memory();
+            for (size_t i = 0; i < this->segment_count; ++i)
+                table[i] = this->segments[i];
+            free(this->segments);
+            this->segments = table;
+            this->table_capacity = capacity;
+            return true;
+        }
+        // allocates segments until count segments exist
+        bool add_segments(size_t count, bool zeroed = false)
+        {
+            if (!this->reserve_table(count))
+                return false;
+            while (this->segment_count < count)
+            {
+                Buffer::Memory &segment = this->segments[this->segment_count];
+                segment = Buffer::Memory();
+                segment.policy = this->policy;
+                const bool allocated = zeroed ? Buffer::Memory::allocate_zeroed(this->segment_bytes(), segment)
+                                              : Buffer::Memory::allocate(this->segment_bytes(), segment);
+                if (!allocated)
+                    return false;
+                // items are tracked by the container
+                segment.eff_size = segment.mem_size;
+                ++this->segment_count;
+            }
+            return true;
+        }
+        // releases segments until count segments are left
+        void drop_segments(size_t count)
+        {
+            while (this->segment_count > count)
+                Buffer::Memory::de_allocate(this->segments[--this->segment_count]);
+            return;
+        }
+        // pointer to an item (no range check, no detach)
+        T * item_ptr(size_t idx) const
+        {
+            const size_t mask = ((size_t)1 << this->segment_shift) - 1;
+            return ((T *)this->segments[idx >> this->segment_shift].ptr) + (idx & mask);
+        }
+
+        // interface (operations) override
+    public:
+        // initialize all allocated segments (segments still zero from
+        // allocate_zeroed() are skipped)
+        void init_all(void) override
+        {
+            const size_t per_segment = (size_t)1 << this->segment_shift;
+            for (size_t s = 0; s < this->segment_count; ++s)
+            {
+                Buffer::Memory &segment = this->segments[s];
+                if (MemoryContainer<T>::zero_is_default() && segment.zeroed)
+                    continue;
+                if (!Buffer::Memory::detach(segment, false))
+                    return;
+                T * ptr = (T *)segment.ptr;
+                for (size_t i = 0; i < per_segment; ++i)
+                    ptr[i] = T{};
+            }
+            return;
+        }
+        // re-generate buffer (num_of_item rounded up to whole segments)
+        bool allocate(size_t num_of_item) override
+        {
+            if (num_of_item <= 0)
+                return false;
+            this->erase();
+            const size_t count = ((num_of_item - 1) >> this->segment_shift) + 1;
+            if (this->add_segments(count))
+                return true;
+            this->erase();
+            return false;
+        }
+        // re-generate buffer, all bytes zero
+        bool allocate_zeroed(size_t num_of_item) override
+        {
+            if (num_of_item <= 0)
+                return false;
+            this->erase();
+            const size_t count = ((num_of_item - 1) >> this->segment_shift) + 1;
+            if (this->add_segments(count, true))
+                return true;
+            this->erase();
+            return false;
+        }
+        // adjust size of buffer (segments are added / dropped at the end,
+        // the items kept never move)
+        bool re_allocate(size_t num_of_item) override
+        {
+            const size_t count = num_of_item ? ((num_of_item - 1) >> this->segment_shift) + 1 : 0;
+            if (count > this->segment_count)
+            {
+                const size_t old_count = this->segment_count;
+                if (!this->add_segments(count))
+                {
+                    this->drop_segments(old_count);
+                    return false;
+                }
+            }
+            else
+                this->drop_segments(count);
+            // effective range follows
+            const size_t capacity = this->segment_count << this->segment_shift;
+            if (this->item_count > capacity)
+                this->item_count = capacity;
+            return true;
+        }
+        // erase buffer (clears and de-allocates memory)
+        void erase(void) override
+        {
+            this->drop_segments(0);
+            free(this->segments);
+            this->segments = nullptr;
+            this->table_capacity = 0;
+            this->item_count = 0;
+            return;
+        }
+        // append to buffer (expansion_ratio is ignored, one segment is added)
+        bool append(const void * item_ptr, bool expand_buffer = true, size_t expansion_ratio = BUFFER_EXPANSION_RATIO) override
+        {
+            (void)expansion_ratio;
+            // no room in the last segment
+            if (this->item_count >= (this->segment_count << this->segment_shift))
+            {
+                if (!expand_buffer || !this->add_segments(this->segment_count + 1))
+                    return false;
+            }
+            T * ptr = (T *)this->get(this->item_count);
+            if (!ptr)
+                return false;
+            *ptr = *(const T *)item_ptr;
+            ++this->item_count;
+            return true;
+        }
+        /**
+         * @brief Appends a run of items
+         * @param items Pointer to the items
+         * @param count Number of items
+         * @return True if successful, false otherwise (the items that fit
+         *         in the segments allocated so far are kept)
+         * @note Segments are allocated first, then filled run by run.
+         */
+        bool append_items(const T * items, size_t count)
+        {
+            const size_t per_segment = (size_t)1 << this->segment_shift;
+            // allocate all segments first
+            const size_t needed = this->item_count + count;
+            if (needed && !this->add_segments(((needed - 1) >> this->segment_shift) + 1))
+                return false;
+            while (count)
+            {
+                const size_t offset = this->item_count & (per_segment - 1);
+                size_t run = per_segment - offset;
+                if (run > count)
+                    run = count;
+                Buffer::Memory &segment = this->segments[this->item_count >> this->segment_shift];
+                if (!Buffer::Memory::detach(segment))
+                    return false;
+                T * dst = (T *)segment.ptr + offset;
+                for (size_t i = 0; i < run; ++i)
+                    dst[i] = items[i];
+                this->item_count += run;
+                items += run;
+                count -= run;
+            }
+            return true;
+        }
+        // shrink (drops the segments past the effective range, arguments are ignored)
+        void shrink(size_t shrink_threshold = BUFFER_SHRINK_THRESHOLD, size_t expansion_ratio = BUFFER_EXPANSION_RATIO) override
+        {
+            (void)shrink_threshold;
+            (void)expansion_ratio;
+            if (!this->item_count)
+            {
+                this->erase();
+                return;
+            }
+            this->drop_segments(((this->item_count - 1) >> this->segment_shift) + 1);
+            return;
+        }
+        // get item from buffer
+        // (non-const access: gives the segment its own block if shared)
+        void *get(size_t idx) override
+        {
+            if (!this->idx_in_range(idx))
+                return nullptr;
+            if (!Buffer::Memory::detach(this->segments[idx >> this->segment_shift]))
+                return nullptr;
+            return (void *)this->item_ptr(idx);
+        }
+        const void *get(size_t idx) const override
+        {
+            if (!this->idx_in_range(idx))
+                return nullptr;
+            return (const void *)this->item_ptr(idx);
+        }
+        // set item
+        bool set(size_t idx, const void * item_ptr) override
+        {
+            T *ptr = (T *)this->get(idx);
+            if (!ptr)
+                return false;
+            *ptr = (*((const T *)item_ptr));
+            return true;
+        }
+        // sets effective range (in count of items)
+        bool set_effective_size(size_t item_count) override
+        {
+            if (item_count > (this->segment_count << this->segment_shift))
+                return false;
+            this->item_count = item_count;
+            return true;
+        }
+
+        // checks if the given index is in range (buffer size)
+        bool idx_in_range(size_t idx) const override { return idx < (this->segment_count << this->segment_shift); }
+        // gets buffer size (in bytes)
+        size_t get_buffer_size(void) const override { return this->segment_count * this->segment_bytes(); }
+        // gets effective buffer size (in bytes)
+        size_t get_effective_size(void) const override { return this->item_count * this->dtype_size; }
+        // gets buffer maximum item-count (indexable upper bound, not inclusive)
+        size_t get_buffer_item_count(void) const override { return this->segment_count << this->segment_shift; }
+        // gets buffer effective item-count (effective upper bound, not inclusive)
+        size_t get_effective_item_count(void) const override { return this->item_count; }
+        // segments are heap blocks
+        bool is_mapped(void) const override { return false; }
+        // checks if every segment is known to hold zeros only
+        bool is_zeroed(void) const override
+        {
+            if (!this->segment_count)
+                return false;
+            for (size_t s = 0; s < this->segment_count; ++s)
+                if (!this->segments[s].zeroed)
+                    return false;
+            return true;
+        }
+        // print function
+        void print(void) const override
+        {
+            printf("Segmented buffer info:\n\t[SEGMENTS] %zu x %zu byte(s)\n\t[BUF SIZE] %zu byte(s)\n\t[EFF SIZE] %zu byte(s)\n",
+                   this->segment_count, this->segment_bytes(), this->get_buffer_size(), this->get_effective_size());
+            printf("\t[POLICY]   %s\n", policy_name(this->policy));
+            printf("Container info:\n\t[BUF ITEM] %zu\n\t[EFF ITEM] %zu\n",
+                   this->get_buffer_item_count(), this->item_count);
+            return;
+        }
+
+        // segments
+    public:
+        // gets items per segment
+        size_t get_segment_item_count(void) const { return (size_t)1 << this->segment_shift; }
+        // gets the number of allocated segments
+        size_t get_segment_count(void) const { return this->segment_count; }
+
+        /**
+         * @brief Sets the allocation policy of the segments
+         * @param policy DEFAULT / HUGE_PAGE / LOCKED / HUGE_PAGE_LOCKED
+         * @return True if successful, false otherwise
+         * @note Kept for every later segment. The current segments are moved
+         *       to blocks of the new policy right away (one at a time).
+         */
+        bool set_alloc_policy(Alloc_policy policy)
+        {
+            this->policy = policy;
+            for (size_t s = 0; s < this->segment_count; ++s)
+            {
+                Buffer::Memory &segment = this->segments[s];
+                segment.policy = policy;
+                if (resolve_policy(policy, segment.mem_size) != segment.block_policy &&
+                    !Buffer::Memory::re_allocate(segment.mem_size, segment))
+                    return false;
+            }
+            return true;
+        }
+        // gets the allocation policy of the segments
+        Alloc_policy get_alloc_policy(void) const { return this->policy; }
+
+        /**
+         * @brief Packs the effective items into one contiguous container
+         * @param dst Destination (re-allocated to the effective item count,
+         *        keeps its allocation policy)
+         * @return True if successful, false otherwise (dst untouched)
+         * @note One copy pass, split over the thread pool
+         *       (BUFFER_THREADED_OPERATIONS), parts cross segment borders.
+         */
+        bool flatten(MemoryContainer<T> &dst) const
+        {
+            if (!this->item_count)
+                return false;
+            // allocate into a temporary first (dst untouched if failed)
+            MemoryContainer<T> packed { };
+            packed.set_alloc_policy(dst.get_alloc_policy());
+            if (!packed.allocate(this->item_count) || !packed.set_effective_size(this->item_count))
+                return false;
+            // arguments for the parts
+            struct flatten_arg
+            {
+                T *dst;
+                const Buffer::Memory *segments;
+                size_t shift;
+                bool stream;
+            };
+            flatten_arg arg { (T *)packed.get(0), this->segments, this->segment_shift,
+                              Buffer::Memory::streamed(0, this->item_count * this->dtype_size) };
+#ifdef BUFFER_THREADED_OPERATIONS
+            size_t min_items = BUFFER_THREADED_OPERATIONS_MIN_SIZE_PER_THREAD / sizeof(T);
+#else
+            size_t min_items = this->item_count;
+#endif
+            parallel_for(0, this->item_count, min_items,
+                [](size_t part_start, size_t part_end, void *part_arg)
+                {
+                    flatten_arg *data = (flatten_arg *)part_arg;
+                    const size_t per_segment = (size_t)1 << data->shift;
+                    // copy run by run (a run ends at a segment border)
+                    while (part_start < part_end)
+                    {
+                        const size_t offset = part_start & (per_segment - 1);
+                        size_t run = per_segment - offset;
+                        if (run > part_end - part_start)
+                            run = part_end - part_start;
+                        // same byte range in the segment and in the
+                        // matching slice of dst (same alignment)
+                        Buffer::Memory::_byte_copy(offset * sizeof(T), (offset + run) * sizeof(T),
+                                                   data->dst + (part_start - offset),
+                                                   data->segments[part_start >> data->shift].ptr,
+                                                   data->stream);
+                        part_start += run;
+                    }
+                },
+                &arg);
+            // hand the packed block to dst
+            move_assign(dst, std::move(packed));
+            // return
+            return true;
+        }
+    };
+}
+
+#endif // _UTILS_SEGMENTED_CONTAINER_HPP_
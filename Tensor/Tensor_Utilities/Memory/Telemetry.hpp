@@ -0,0 +1,533 @@
+// File: Telemetry.hpp
+// Description: Allocation accounting for Buffer::Memory blocks
+//              (current / peak bytes, counts, size histogram,
+//              attribution to tags pushed by the calling thread)
+//              with snapshots and a JSON dump.
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_TELEMETRY_HPP_
+#define _UTILS_TELEMETRY_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdio>   // FILE; fprintf()
+
+// macro for enabling allocation telemetry
+// without it, every hook below is an empty inline function
+// (counters are relaxed atomics, no lock is ever taken)
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+    // number of distinct tags (tag 0 is "untagged", later tags share it)
+    #ifndef BUFFER_TELEMETRY_MAX_TAGS
+        #define BUFFER_TELEMETRY_MAX_TAGS 32
+    #endif
+    // depth of the per-thread tag stack (deeper scopes keep the last tag)
+    #ifndef BUFFER_TELEMETRY_TAG_DEPTH
+        #define BUFFER_TELEMETRY_TAG_DEPTH 16
+    #endif
+    #include <atomic>   // std::atomic
+    #include <cstring>  // strcmp()
+#endif // BUFFER_ALLOCATION_TELEMETRY
+
+namespace TENSOR_UTILITIES
+{
+
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+    /**
+     * @brief Allocation counters (process-wide)
+     *        Every buffer block allocated / released by Buffer::Memory is
+     *        counted here, with the tag on top of the calling thread's tag
+     *        stack (see Alloc_tag_scope).
+     * @note Sizes are the requested block sizes (no cache rounding, no
+     *       huge page rounding, no copy-on-write header). Mapped files are
+     *       not counted, a block shared by copy-on-write is counted once.
+     * @note Counters are updated independently, a snapshot taken while
+     *       other threads allocate is not an atomic cut (each value is).
+     */
+    class AllocTelemetry
+    {
+    public:
+        // one histogram bucket per power of 2 (index is log2 of the
+        // smallest power of 2 holding the size)
+        static constexpr size_t CLASS_COUNT = sizeof(size_t) * 8;
+        // tag of allocations made outside any scope
+        static constexpr unsigned int UNTAGGED = 0;
+
+        // counters of one tag
+        struct Tag_stats
+        {
+            // tag name
+            const char * name;
+            // bytes currently allocated under this tag
+            size_t current_bytes;
+            // highest current_bytes seen (since the last reset_stats())
+            size_t peak_bytes;
+            // number of allocations
+            size_t allocations;
+            // total bytes allocated
+            size_t allocated_bytes;
+        };
+
+        // counters snapshot
+        struct Snapshot
+        {
+            // bytes currently allocated
+            size_t current_bytes;
+            // highest current_bytes seen (since the last reset_stats())
+            size_t peak_bytes;
+            // number of allocations / releases
+            size_t allocations;
+            size_t deallocations;
+            // total bytes allocated
+            size_t allocated_bytes;
+            // re-allocations that moved the content, and the bytes moved
+            size_t realloc_copies;
+            size_t realloc_copy_bytes;
+            // allocations per size class
+            size_t histogram[CLASS_COUNT];
+            // counters per tag (tag_count first entries are used)
+            size_t tag_count;
+            Tag_stats tags[BUFFER_TELEMETRY_MAX_TAGS];
+
+            /**
+             * @brief Writes the snapshot as a JSON object
+             * @param out Output stream
+             * @return True if successful, false otherwise
+             * @note Only the non-empty histogram classes are written
+             *       ("bytes" is the class upper bound).
+             */
+            bool write_json(FILE * out = stdout) const
+            {
+                if (!out)
+                    return false;
+                fprintf(out, "{\n");
+                fprintf(out, "  \"current_bytes\": %zu,\n", this->current_bytes);
+                fprintf(out, "  \"peak_bytes\": %zu,\n", this->peak_bytes);
+                fprintf(out, "  \"allocations\": %zu,\n", this->allocations);
+                fprintf(out, "  \"deallocations\": %zu,\n", this->deallocations);
+                fprintf(out, "  \"allocated_bytes\": %zu,\n", this->allocated_bytes);
+                fprintf(out, "  \"realloc_copies\": %zu,\n", this->realloc_copies);
+                fprintf(out, "  \"realloc_copy_bytes\": %zu,\n", this->realloc_copy_bytes);
+                // histogram
+                fprintf(out, "  \"histogram\": [");
+                bool first = true;
+                for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+                {
+                    if (!this->histogram[cls])
+                        continue;
+                    fprintf(out, "%s\n    { \"bytes\": %zu, \"count\": %zu }",
+                            first ? "" : ",", (size_t)1 << cls, this->histogram[cls]);
+                    first = false;
+                }
+                fprintf(out, "%s],\n", first ? "" : "\n  ");
+                // tags
+                fprintf(out, "  \"tags\": [");
+                for (size_t i = 0; i < this->tag_count; ++i)
+                {
+                    const Tag_stats & tag = this->tags[i];
+                    fprintf(out, "%s\n    { \"name\": \"", i ? "," : "");
+                    // names are escaped (quotes, backslashes, control characters)
+                    for (const char * c = tag.name; *c; ++c)
+                    {
+                        if (*c == '"' || *c == '\\')
+                            fprintf(out, "\\%c", *c);
+                        else if ((unsigned char)*c < 0x20)
+                            fprintf(out, "\\u%04x", (unsigned int)(unsigned char)*c);
+                        else
+                            fputc(*c, out);
+                    }
+                    fprintf(out, "\", \"current_bytes\": %zu, \"peak_bytes\": %zu, "
+                                 "\"allocations\": %zu, \"allocated_bytes\": %zu }",
+                            tag.current_bytes, tag.peak_bytes, tag.allocations, tag.allocated_bytes);
+                }
+                fprintf(out, "%s]\n", this->tag_count ? "\n  " : "");
+                fprintf(out, "}\n");
+                return !ferror(out);
+            }
+        };
+
+        /**
+         * @brief Gets the process-wide counters
+         * @return Reference to the counters
+         * @note Never destroyed (static tensors may free their
+         *       blocks after main() returns).
+         */
+        static AllocTelemetry & instance(void)
+        {
+            // C++11 guarantees thread-safe initialisation
+            static AllocTelemetry * telemetry = new AllocTelemetry();
+            return *telemetry;
+        }
+
+        // not copyable nor movable
+        AllocTelemetry(const AllocTelemetry & other) = delete;
+        AllocTelemetry(AllocTelemetry && other) = delete;
+        AllocTelemetry & operator= (const AllocTelemetry & other) = delete;
+        AllocTelemetry & operator= (AllocTelemetry && other) = delete;
+
+    private:
+        // counters of one tag
+        struct Tag_counters
+        {
+            std::atomic<const char *> name;
+            std::atomic<size_t> current_bytes;
+            std::atomic<size_t> peak_bytes;
+            std::atomic<size_t> allocations;
+            std::atomic<size_t> allocated_bytes;
+        };
+
+        // per-thread tag stack
+        struct Tag_stack
+        {
+            unsigned int tags[BUFFER_TELEMETRY_TAG_DEPTH];
+            size_t depth;
+        };
+
+        // global counters
+        std::atomic<size_t> current_bytes {0};
+        std::atomic<size_t> peak_bytes {0};
+        std::atomic<size_t> allocations {0};
+        std::atomic<size_t> deallocations {0};
+        std::atomic<size_t> allocated_bytes {0};
+        std::atomic<size_t> realloc_copies {0};
+        std::atomic<size_t> realloc_copy_bytes {0};
+        std::atomic<size_t> histogram[CLASS_COUNT];
+        // tags (a slot is claimed once, by its name)
+        Tag_counters tags[BUFFER_TELEMETRY_MAX_TAGS];
+
+    private:
+        // private constructor (only accessible by instance())
+        AllocTelemetry(void)
+        {
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+                this->histogram[cls].store(0);
+            for (size_t i = 0; i < BUFFER_TELEMETRY_MAX_TAGS; ++i)
+            {
+                this->tags[i].name.store(nullptr);
+                this->tags[i].current_bytes.store(0);
+                this->tags[i].peak_bytes.store(0);
+                this->tags[i].allocations.store(0);
+                this->tags[i].allocated_bytes.store(0);
+            }
+            this->tags[UNTAGGED].name.store("untagged");
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] the calling thread's tag stack
+         */
+        static Tag_stack & local(void)
+        {
+            static thread_local Tag_stack stack { {}, 0 };
+            return stack;
+        }
+
+        /**
+         * @brief [INTERNAL] gets the histogram class of a size
+         */
+        static size_t class_of(size_t size)
+        {
+            size_t cls = 0;
+            while (cls + 1 < CLASS_COUNT && ((size_t)1 << cls) < size)
+                ++cls;
+            return cls;
+        }
+
+        /**
+         * @brief [INTERNAL] raises a peak to value (lock-free)
+         */
+        static void raise_peak(std::atomic<size_t> & peak, size_t value)
+        {
+            size_t seen = peak.load(std::memory_order_relaxed);
+            while (seen < value &&
+                   !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+                ;
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] adds bytes to the current counters (and peaks)
+         */
+        void add_bytes(size_t size, unsigned int tag)
+        {
+            const size_t now = this->current_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            AllocTelemetry::raise_peak(this->peak_bytes, now);
+            Tag_counters & counters = this->tags[tag];
+            const size_t tag_now = counters.current_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            AllocTelemetry::raise_peak(counters.peak_bytes, tag_now);
+            return;
+        }
+        /**
+         * @brief [INTERNAL] removes bytes from the current counters
+         */
+        void sub_bytes(size_t size, unsigned int tag)
+        {
+            this->current_bytes.fetch_sub(size, std::memory_order_relaxed);
+            this->tags[tag].current_bytes.fetch_sub(size, std::memory_order_relaxed);
+            return;
+        }
+
+    public:
+        /**
+         * @brief Gets (or registers) the tag of a name
+         * @param name Tag name, should live as long as the process
+         *        (string literals are fine, names are compared by value)
+         * @return Tag index, UNTAGGED if all tags are taken
+         */
+        unsigned int register_tag(const char * name)
+        {
+            if (!name)
+                return UNTAGGED;
+            for (unsigned int i = 0; i < BUFFER_TELEMETRY_MAX_TAGS; ++i)
+            {
+                const char * slot = this->tags[i].name.load(std::memory_order_acquire);
+                // free slot, try to claim it
+                if (!slot)
+                {
+                    if (this->tags[i].name.compare_exchange_strong(slot, name, std::memory_order_acq_rel))
+                        return i;
+                    // claimed by another thread meanwhile, slot holds its name
+                }
+                if (slot == name || strcmp(slot, name) == 0)
+                    return i;
+            }
+            return UNTAGGED;
+        }
+
+        /**
+         * @brief Pushes a tag on the calling thread's tag stack
+         * @param tag Tag index (register_tag())
+         */
+        static void push_tag(unsigned int tag)
+        {
+            Tag_stack & stack = AllocTelemetry::local();
+            if (stack.depth < BUFFER_TELEMETRY_TAG_DEPTH)
+                stack.tags[stack.depth] = (tag < BUFFER_TELEMETRY_MAX_TAGS) ? tag : UNTAGGED;
+            ++stack.depth;
+            return;
+        }
+        /**
+         * @brief Pops the tag on top of the calling thread's tag stack
+         */
+        static void pop_tag(void)
+        {
+            Tag_stack & stack = AllocTelemetry::local();
+            if (stack.depth)
+                --stack.depth;
+            return;
+        }
+        /**
+         * @brief Gets the tag on top of the calling thread's tag stack
+         * @return Tag index, UNTAGGED outside any scope
+         */
+        static unsigned int current_tag(void)
+        {
+            const Tag_stack & stack = AllocTelemetry::local();
+            if (!stack.depth)
+                return UNTAGGED;
+            const size_t top = (stack.depth < BUFFER_TELEMETRY_TAG_DEPTH) ? stack.depth : BUFFER_TELEMETRY_TAG_DEPTH;
+            return stack.tags[top - 1];
+        }
+
+        /**
+         * @brief Counts an allocation
+         * @param size Size of the block (in Byte)
+         * @return Tag the block is attributed to (give it back on release)
+         */
+        unsigned int record_allocate(size_t size)
+        {
+            const unsigned int tag = AllocTelemetry::current_tag();
+            this->allocations.fetch_add(1, std::memory_order_relaxed);
+            this->allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+            this->histogram[AllocTelemetry::class_of(size)].fetch_add(1, std::memory_order_relaxed);
+            this->tags[tag].allocations.fetch_add(1, std::memory_order_relaxed);
+            this->tags[tag].allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+            this->add_bytes(size, tag);
+            return tag;
+        }
+        /**
+         * @brief Counts a release
+         * @param size Size given to record_allocate() (or record_resize())
+         * @param tag Tag returned by record_allocate()
+         */
+        void record_release(size_t size, unsigned int tag)
+        {
+            this->deallocations.fetch_add(1, std::memory_order_relaxed);
+            this->sub_bytes(size, tag);
+            return;
+        }
+        /**
+         * @brief Counts a block resized in place (no new allocation)
+         * @param old_size Size counted so far
+         * @param new_size New size of the block
+         * @param tag Tag of the block
+         */
+        void record_resize(size_t old_size, size_t new_size, unsigned int tag)
+        {
+            if (new_size > old_size)
+                this->add_bytes(new_size - old_size, tag);
+            else
+                this->sub_bytes(old_size - new_size, tag);
+            return;
+        }
+        /**
+         * @brief Counts the content moved by a re-allocation
+         * @param bytes Bytes copied to the new block
+         */
+        void record_realloc_copy(size_t bytes)
+        {
+            this->realloc_copies.fetch_add(1, std::memory_order_relaxed);
+            this->realloc_copy_bytes.fetch_add(bytes, std::memory_order_relaxed);
+            return;
+        }
+
+        /**
+         * @brief Gets a copy of all counters
+         */
+        Snapshot snapshot(void) const
+        {
+            Snapshot snap;
+            snap.current_bytes = this->current_bytes.load(std::memory_order_relaxed);
+            snap.peak_bytes = this->peak_bytes.load(std::memory_order_relaxed);
+            snap.allocations = this->allocations.load(std::memory_order_relaxed);
+            snap.deallocations = this->deallocations.load(std::memory_order_relaxed);
+            snap.allocated_bytes = this->allocated_bytes.load(std::memory_order_relaxed);
+            snap.realloc_copies = this->realloc_copies.load(std::memory_order_relaxed);
+            snap.realloc_copy_bytes = this->realloc_copy_bytes.load(std::memory_order_relaxed);
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+                snap.histogram[cls] = this->histogram[cls].load(std::memory_order_relaxed);
+            // registered tags only (slots are claimed in order)
+            snap.tag_count = 0;
+            for (size_t i = 0; i < BUFFER_TELEMETRY_MAX_TAGS; ++i)
+            {
+                const char * name = this->tags[i].name.load(std::memory_order_acquire);
+                if (!name)
+                    break;
+                Tag_stats & tag = snap.tags[snap.tag_count++];
+                tag.name = name;
+                tag.current_bytes = this->tags[i].current_bytes.load(std::memory_order_relaxed);
+                tag.peak_bytes = this->tags[i].peak_bytes.load(std::memory_order_relaxed);
+                tag.allocations = this->tags[i].allocations.load(std::memory_order_relaxed);
+                tag.allocated_bytes = this->tags[i].allocated_bytes.load(std::memory_order_relaxed);
+            }
+            return snap;
+        }
+        /**
+         * @brief Writes a snapshot as JSON (see Snapshot::write_json())
+         */
+        bool write_json(FILE * out = stdout) const
+        {
+            return this->snapshot().write_json(out);
+        }
+
+        /**
+         * @brief Resets the peaks to the current usage
+         *        (and clears the counts, the histogram and the copy counters)
+         * @note current_bytes is kept, live blocks are still released later.
+         */
+        void reset_stats(void)
+        {
+            this->peak_bytes.store(this->current_bytes.load());
+            this->allocations.store(0);
+            this->deallocations.store(0);
+            this->allocated_bytes.store(0);
+            this->realloc_copies.store(0);
+            this->realloc_copy_bytes.store(0);
+            for (size_t cls = 0; cls < CLASS_COUNT; ++cls)
+                this->histogram[cls].store(0);
+            for (size_t i = 0; i < BUFFER_TELEMETRY_MAX_TAGS; ++i)
+            {
+                this->tags[i].peak_bytes.store(this->tags[i].current_bytes.load());
+                this->tags[i].allocations.store(0);
+                this->tags[i].allocated_bytes.store(0);
+            }
+            return;
+        }
+    };
+#endif // BUFFER_ALLOCATION_TELEMETRY
+
+    /**
+     * @brief Attributes the allocations of the calling thread to a tag
+     *        while the object lives (tags nest, the innermost wins)
+     * @note e.g. { Alloc_tag_scope scope("attention"); ... }
+     * @note A weak scope only applies outside any other scope (used by
+     *       the library itself, e.g. "contiguous", "copy_to", so user
+     *       scopes are never hidden by internal ones).
+     * @note Does nothing without BUFFER_ALLOCATION_TELEMETRY.
+     */
+    class Alloc_tag_scope
+    {
+    public:
+        // name should live as long as the process (see AllocTelemetry::register_tag())
+        explicit Alloc_tag_scope(const char * name, bool weak = false)
+        {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+            const unsigned int outer = AllocTelemetry::current_tag();
+            if (weak && outer != AllocTelemetry::UNTAGGED)
+                AllocTelemetry::push_tag(outer);
+            else
+                AllocTelemetry::push_tag(AllocTelemetry::instance().register_tag(name));
+#else
+            (void)name;
+            (void)weak;
+#endif
+            return;
+        }
+        ~Alloc_tag_scope(void)
+        {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+            AllocTelemetry::pop_tag();
+#endif
+            return;
+        }
+
+        // not copyable nor movable (strictly nested)
+        Alloc_tag_scope(const Alloc_tag_scope & other) = delete;
+        Alloc_tag_scope & operator= (const Alloc_tag_scope & other) = delete;
+    };
+
+    /**
+     * @brief [INTERNAL] hooks used by Buffer::Memory
+     *        (empty without BUFFER_ALLOCATION_TELEMETRY)
+     */
+    inline unsigned int telemetry_allocate(size_t size)
+    {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+        return AllocTelemetry::instance().record_allocate(size);
+#else
+        (void)size;
+        return 0;
+#endif
+    }
+    inline void telemetry_release(size_t size, unsigned int tag)
+    {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+        AllocTelemetry::instance().record_release(size, tag);
+#else
+        (void)size;
+        (void)tag;
+#endif
+        return;
+    }
+    inline void telemetry_resize(size_t old_size, size_t new_size, unsigned int tag)
+    {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+        AllocTelemetry::instance().record_resize(old_size, new_size, tag);
+#else
+        (void)old_size;
+        (void)new_size;
+        (void)tag;
+#endif
+        return;
+    }
+    inline void telemetry_realloc_copy(size_t bytes)
+    {
+#ifdef BUFFER_ALLOCATION_TELEMETRY
+        AllocTelemetry::instance().record_realloc_copy(bytes);
+#else
+        (void)bytes;
+#endif
+        return;
+    }
+}
+
+#endif // _UTILS_TELEMETRY_HPP_
@@ -0,0 +1,352 @@
+// File: ThreadPool.hpp
+// Description: Process-wide persistent worker pool with
+//              a parallel-for primitive.
+//              (Workers are started lazily and reused)
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_THREAD_POOL_HPP_
+#define _UTILS_THREAD_POOL_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdlib>  // malloc(); free()
+#include <atomic>   // std::atomic
+
+// macro for for allowing threaded operations
+// without it, parallel_for() simply runs the task on the calling thread
+#ifdef BUFFER_THREADED_OPERATIONS
+    // define default number of threads to use (including the caller)
+    // can be changed at runtime through ThreadPool::set_thread_count()
+    #ifndef BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT
+        #define BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT 4
+    #endif
+    // include pthread library (C library)
+    // NOTE: Windows users, you might need to install:
+    //       winpthread (MinGW-w64)
+    //       pthreads-win32 (vcpkg)
+    // You also have to link with pthread library
+    // (add -lpthread to your linker flags)
+    #include <pthread.h>
+#endif // BUFFER_THREADED_OPERATIONS
+
+namespace TENSOR_UTILITIES
+{
+
+    // task signature for parallel_for()
+    // works on the range [start, end), arg is passed through as is
+    typedef void (*Parallel_task)(size_t start, size_t end, void * arg);
+
+    /**
+     * @brief Persistent worker pool (process-wide)
+     *        Get it with ThreadPool::instance(), workers are started
+     *        on the first parallel_for() that needs them.
+     * @note The calling thread also takes part in the work, so a pool
+     *       with thread count N starts (N - 1) workers.
+     * @note parallel_for() called from inside a task, or while another
+     *       thread is using the pool, runs on the calling thread.
+     *       (no deadlock, no over-subscription)
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * @brief Gets the process-wide pool
+         * @return Reference to the pool
+         * @note The pool is never destroyed (avoids destruction order
+         *       problems with static tensors), the OS reclaims it at exit.
+         */
+        static ThreadPool & instance(void)
+        {
+            // C++11 guarantees thread-safe initialisation
+            static ThreadPool * pool = new ThreadPool();
+            return *pool;
+        }
+
+        // not copyable nor movable
+        ThreadPool(const ThreadPool & other) = delete;
+        ThreadPool(ThreadPool && other) = delete;
+        ThreadPool & operator= (const ThreadPool & other) = delete;
+        ThreadPool & operator= (ThreadPool && other) = delete;
+
+    private:
+#ifdef BUFFER_THREADED_OPERATIONS
+        // protects everything below (job and worker states)
+        pthread_mutex_t mutex;
+        // serialises parallel_for() callers
+        pthread_mutex_t submit_mutex;
+        // signalled when a job is posted or when stopping
+        pthread_cond_t work_cv;
+        // signalled when the last part of a job is done
+        pthread_cond_t done_cv;
+
+        // workers
+        pthread_t * workers {nullptr};
+        size_t worker_count {0};
+        bool workers_started {false};
+        bool stop {false};
+        // total threads to use (including the caller)
+        // (written under submit_mutex, read by any caller without it)
+        std::atomic<size_t> thread_count {BUFFER_THREADED_OPERATIONS_MAX_THREAD_COUNT};
+
+        // current job (task == nullptr means no job)
+        Parallel_task task {nullptr};
+        void * arg {nullptr};
+        size_t begin {0};
+        size_t part_size {0};
+        size_t part_remainder {0};
+        size_t parts {0};
+        size_t next_part {0};
+        size_t done_parts {0};
+#else
+        // total threads to use (always 1)
+        size_t thread_count {1};
+#endif
+
+    private:
+        // private constructor (only accessible by instance())
+        ThreadPool(void)
+        {
+#ifdef BUFFER_THREADED_OPERATIONS
+            pthread_mutex_init(&this->mutex, nullptr);
+            pthread_mutex_init(&this->submit_mutex, nullptr);
+            pthread_cond_init(&this->work_cv, nullptr);
+            pthread_cond_init(&this->done_cv, nullptr);
+#endif
+            return;
+        }
+
+#ifdef BUFFER_THREADED_OPERATIONS
+        /**
+         * @brief [INTERNAL] flag of the current thread being a pool thread
+         *        (or the caller running a part of a job)
+         */
+        static bool & inside_task(void)
+        {
+            static thread_local bool flag = false;
+            return flag;
+        }
+
+        /**
+         * @brief [INTERNAL] range of a part of the current job
+         * @note mutex should be held
+         */
+        void part_range(size_t part, size_t & start, size_t & end) const
+        {
+            // the first (part_remainder) parts take one extra item
+            start = this->begin + part * this->part_size +
+                    ((part < this->part_remainder) ? part : this->part_remainder);
+            end = start + this->part_size + ((part < this->part_remainder) ? 1 : 0);
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] claims and runs parts of the current job until none left
+         * @note mutex should be held, it is released while running a part
+         */
+        void run_parts(void)
+        {
+            while (this->task && this->next_part < this->parts)
+            {
+                // claim a part
+                size_t start = 0, end = 0;
+                this->part_range(this->next_part, start, end);
+                ++this->next_part;
+                Parallel_task job_task = this->task;
+                void * job_arg = this->arg;
+                // run it without holding the lock
+                pthread_mutex_unlock(&this->mutex);
+                inside_task() = true;
+                job_task(start, end, job_arg);
+                inside_task() = false;
+                pthread_mutex_lock(&this->mutex);
+                // report
+                if (++this->done_parts == this->parts)
+                    pthread_cond_signal(&this->done_cv);
+            }
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] worker thread main loop
+         */
+        static void * worker_main(void * pool_ptr)
+        {
+            ThreadPool * pool = (ThreadPool *)pool_ptr;
+            pthread_mutex_lock(&pool->mutex);
+            while (true)
+            {
+                // wait for work (or stop)
+                while (!pool->stop && !(pool->task && pool->next_part < pool->parts))
+                    pthread_cond_wait(&pool->work_cv, &pool->mutex);
+                if (pool->stop)
+                    break;
+                pool->run_parts();
+            }
+            pthread_mutex_unlock(&pool->mutex);
+            return nullptr;
+        }
+
+        /**
+         * @brief [INTERNAL] starts (thread_count - 1) workers
+         * @note mutex should NOT be held
+         */
+        void start_workers(void)
+        {
+            if (this->workers_started)
+                return;
+            this->workers_started = true;
+            const size_t thread_count = this->thread_count.load();
+            if (thread_count <= 1)
+                return;
+            this->workers = (pthread_t *)malloc((thread_count - 1) * sizeof(pthread_t));
+            if (!this->workers)
+                return;
+            for (size_t i = 0; i < thread_count - 1; ++i)
+            {
+                if (pthread_create(&this->workers[this->worker_count], nullptr, &ThreadPool::worker_main, this))
+                    break;
+                ++this->worker_count;
+            }
+            return;
+        }
+
+        /**
+         * @brief [INTERNAL] stops and joins all workers
+         * @note mutex should NOT be held
+         */
+        void stop_workers(void)
+        {
+            pthread_mutex_lock(&this->mutex);
+            this->stop = true;
+            pthread_cond_broadcast(&this->work_cv);
+            pthread_mutex_unlock(&this->mutex);
+            for (size_t i = 0; i < this->worker_count; ++i)
+                pthread_join(this->workers[i], nullptr);
+            free(this->workers);
+            this->workers = nullptr;
+            this->worker_count = 0;
+            this->workers_started = false;
+            this->stop = false;
+            return;
+        }
+#endif
+
+    public:
+        /**
+         * @brief Sets the number of threads to use (including the caller)
+         * @param count Number of threads, 0 is treated as 1
+         * @return True if successful, false if threaded operations
+         *         are not enabled (BUFFER_THREADED_OPERATIONS)
+         * @note Running workers are joined, new ones start lazily.
+         *       Do not call this from inside a task.
+         */
+        bool set_thread_count(size_t count)
+        {
+#ifdef BUFFER_THREADED_OPERATIONS
+            if (count == 0)
+                count = 1;
+            // wait for any running job to finish
+            pthread_mutex_lock(&this->submit_mutex);
+            this->stop_workers();
+            this->thread_count.store(count);
+            pthread_mutex_unlock(&this->submit_mutex);
+            return true;
+#else
+            (void)count;
+            return false;
+#endif
+        }
+        /**
+         * @brief Gets the number of threads to use (including the caller)
+         * @return The thread count (1 if threaded operations are disabled)
+         */
+        size_t get_thread_count(void) const
+        {
+#ifdef BUFFER_THREADED_OPERATIONS
+            return this->thread_count.load();
+#else
+            return this->thread_count;
+#endif
+        }
+
+        /**
+         * @brief Parallel-for: splits [begin, end) into balanced parts and runs
+         *        task(start, end, arg) for each part on the pool
+         * @param begin Start of the range
+         * @param end End of the range (not inclusive)
+         * @param min_part Minimum length of a part (0 is treated as 1),
+         *        use this to keep tiny ranges on one thread
+         * @param task Function to run on each part
+         * @param arg Argument passed to the task as is
+         * @note Returns when all parts are done. Parts may run on any thread
+         *       (including the caller) in any order.
+         */
+        void parallel_for(size_t begin, size_t end, size_t min_part, Parallel_task task, void * arg)
+        {
+            // nothing to do
+            if (begin >= end || !task)
+                return;
+            if (min_part == 0)
+                min_part = 1;
+
+#ifdef BUFFER_THREADED_OPERATIONS
+            // calculate parts to use
+            const size_t range = end - begin;
+            const size_t thread_count = this->thread_count.load();
+            size_t parts = range / min_part;
+            if (parts > thread_count)
+                parts = thread_count;
+            // small job, nested call or pool busy -> run on this thread
+            if (parts <= 1 || inside_task() ||
+                pthread_mutex_trylock(&this->submit_mutex))
+            {
+                task(begin, end, arg);
+                return;
+            }
+            // start workers if needed (under submit_mutex)
+            this->start_workers();
+
+            // post the job
+            pthread_mutex_lock(&this->mutex);
+            this->task = task;
+            this->arg = arg;
+            this->begin = begin;
+            this->parts = parts;
+            this->part_size = range / parts;
+            this->part_remainder = range % parts;
+            this->next_part = 0;
+            this->done_parts = 0;
+            pthread_cond_broadcast(&this->work_cv);
+            // take part in the work
+            this->run_parts();
+            // wait for the other parts
+            while (this->done_parts < this->parts)
+                pthread_cond_wait(&this->done_cv, &this->mutex);
+            // clear the job
+            this->task = nullptr;
+            this->arg = nullptr;
+            this->parts = 0;
+            pthread_mutex_unlock(&this->mutex);
+            pthread_mutex_unlock(&this->submit_mutex);
+            return;
+#else
+            // single threaded
+            (void)min_part;
+            task(begin, end, arg);
+            return;
+#endif
+        }
+    };
+
+    /**
+     * @brief Parallel-for on the process-wide pool
+     * @see ThreadPool::parallel_for()
+     */
+    inline void parallel_for(size_t begin, size_t end, size_t min_part, Parallel_task task, void * arg)
+    {
+        ThreadPool::instance().parallel_for(begin, end, min_part, task, arg);
+        return;
+    }
+}
+
+#endif // _UTILS_THREAD_POOL_HPP_
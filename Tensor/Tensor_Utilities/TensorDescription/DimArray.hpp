@@ -0,0 +1,180 @@
+// File: DimArray.hpp
+// Description: Small array of dimension metadata (shape / stride)
+//              stored inline up to a fixed rank, on the heap beyond.
+//              (Light replacement of MemoryContainer<size_t> for Shape)
+// Date: Oct. 16, 2026
+// @ADMINGUOYU
+
+#ifndef _UTILS_DIM_ARRAY_HPP_
+#define _UTILS_DIM_ARRAY_HPP_
+
+#include <cstddef>  // defines: size_t
+#include <cstdlib>  // malloc(); free()
+#include <utility>  // std::move()
+
+// number of dimensions stored inline (no allocation)
+// shapes (and indexers) with more dimensions go to the heap
+#ifndef SHAPE_INLINE_RANK
+    #define SHAPE_INLINE_RANK 8
+#endif
+
+namespace TENSOR_UTILITIES
+{
+
+    /**
+     * @brief Array of size_t with inline storage for up to SHAPE_INLINE_RANK items
+     * @note Same access pattern as MemoryContainer<size_t> (allocate(), get(),
+     *       set(), set_effective_size() ...) but nothing is virtual and no
+     *       allocation happens for normal ranks. Use data() for plain access.
+     */
+    class DimArray
+    {
+    private:
+        // effective item count
+        size_t m_count {0};
+        // allocated item count (0 means nothing allocated)
+        size_t m_capacity {0};
+        // heap storage (nullptr when stored inline)
+        size_t * m_heap {nullptr};
+        // inline storage
+        size_t m_inline[SHAPE_INLINE_RANK];
+
+    public:
+        // constructors and destructor
+        DimArray (void) = default;
+        DimArray (const DimArray & other) : DimArray()
+        {
+            (*this) = other;
+            return;
+        }
+        DimArray (DimArray && other) : DimArray()
+        {
+            (*this) = std::move(other);
+            return;
+        }
+        ~DimArray (void)
+        {
+            free(this->m_heap);
+            return;
+        }
+
+        // copy and move assignment
+        DimArray & operator= (const DimArray & other)
+        {
+            if (this == &other)
+                return (*this);
+            // drop if empty
+            if (!other.m_capacity)
+            {
+                this->erase();
+                return (*this);
+            }
+            // copy the effective items only (capacity follows them)
+            if (!this->allocate(other.m_count ? other.m_count : other.m_capacity))
+                return (*this);
+            const size_t * src = other.data();
+            size_t * dst = this->data();
+            for (size_t i = 0; i < other.m_count; ++i)
+                dst[i] = src[i];
+            this->m_count = other.m_count;
+            return (*this);
+        }
+        DimArray & operator= (DimArray && other)
+        {
+            if (this == &other)
+                return (*this);
+            // heap storage is taken, inline storage is copied
+            if (other.m_heap)
+            {
+                free(this->m_heap);
+                this->m_heap = other.m_heap;
+                other.m_heap = nullptr;
+            }
+            else
+            {
+                (*this) = (const DimArray &)other;
+            }
+            this->m_count = other.m_count;
+            this->m_capacity = other.m_capacity;
+            // reset other
+            other.m_count = 0;
+            other.m_capacity = 0;
+            return (*this);
+        }
+
+    public:
+        /**
+         * @brief Allocates room for count items (content is dropped)
+         * @param count Number of items, 0 is not allowed
+         * @return True if successful, false otherwise (untouched)
+         * @note No allocation when count <= SHAPE_INLINE_RANK
+         */
+        bool allocate (size_t count)
+        {
+            if (count == 0)
+                return false;
+            if (count <= SHAPE_INLINE_RANK)
+            {
+                free(this->m_heap);
+                this->m_heap = nullptr;
+            }
+            else if (count > this->m_capacity || !this->m_heap)
+            {
+                size_t * heap = (size_t *)malloc(count * sizeof(size_t));
+                if (!heap)
+                    return false;
+                free(this->m_heap);
+                this->m_heap = heap;
+            }
+            this->m_capacity = (count <= SHAPE_INLINE_RANK) ? SHAPE_INLINE_RANK : count;
+            this->m_count = 0;
+            return true;
+        }
+        /**
+         * @brief Drops the content (and heap storage)
+         */
+        void erase (void)
+        {
+            free(this->m_heap);
+            this->m_heap = nullptr;
+            this->m_count = 0;
+            this->m_capacity = 0;
+            return;
+        }
+
+        // plain access (no checks)
+        size_t * data (void) { return this->m_heap ? this->m_heap : this->m_inline; }
+        const size_t * data (void) const { return this->m_heap ? this->m_heap : this->m_inline; }
+        size_t & operator[] (size_t idx) { return this->data()[idx]; }
+        const size_t & operator[] (size_t idx) const { return this->data()[idx]; }
+
+        // checked access (nullptr / false if out of the allocated range)
+        size_t * get (size_t idx) { return (idx < this->m_capacity) ? (this->data() + idx) : nullptr; }
+        const size_t * get (size_t idx) const { return (idx < this->m_capacity) ? (this->data() + idx) : nullptr; }
+        bool set (size_t idx, const size_t * item_ptr)
+        {
+            size_t * ptr = this->get(idx);
+            if (!ptr)
+                return false;
+            *ptr = *item_ptr;
+            return true;
+        }
+        // sets effective range (in count of items)
+        bool set_effective_size (size_t count)
+        {
+            if (count > this->m_capacity)
+                return false;
+            this->m_count = count;
+            return true;
+        }
+
+        // gets effective item count
+        size_t get_effective_item_count (void) const { return this->m_count; }
+        // gets allocated item count
+        size_t get_buffer_item_count (void) const { return this->m_capacity; }
+        // gets allocated size (in bytes)
+        size_t get_buffer_size (void) const { return this->m_capacity * sizeof(size_t); }
+    };
+}
+
+#endif // _UTILS_DIM_ARRAY_HPP_
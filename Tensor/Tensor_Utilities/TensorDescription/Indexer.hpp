@@ -10,6 +10,7 @@
 #include <cstdio>
 #include <cstddef>  // defines: size_t
 #include <cstdlib>  // malloc(); free()
+#include "DimArray.hpp"  // SHAPE_INLINE_RANK
 
 namespace TENSOR_UTILITIES
 {
@@ -32,6 +33,15 @@ namespace TENSOR_UTILITIES
      * @note The the initial state is step 0, the maximum possible step
      *       is (max_step - 1). You may want to use do-while loop
      *       to not missing the initial state.
+     *
+     * @note When generated with offset tracking, the Indexer also keeps a
+     *       copy of the memory strides and updates the flattened (memory)
+     *       offset on every carry, so get_offset() costs nothing.
+     *       The offset is only meaningful for the Shape that generated it
+     *       (or any Shape with the same strides).
+     *
+     * @note The internal states live in one block, stored inside the
+     *       Indexer up to SHAPE_INLINE_RANK dimensions (no allocation).
      */
     struct Indexer
     {
@@ -53,36 +63,98 @@ namespace TENSOR_UTILITIES
         /* stride */
         size_t stride {1};  // defaults to 1
 
+        /* offset tracking (nullptr if not tracking) */
+        size_t * mem_stride {nullptr};
+        size_t offset {0};
+
+        /* storage of shape, current_idx and mem_stride */
+        // heap block (nullptr if stored inline)
+        size_t * storage {nullptr};
+        // inline block (used up to SHAPE_INLINE_RANK dimensions)
+        size_t inline_storage[3 * SHAPE_INLINE_RANK];
+
     private:
         // private constructor (only accessible by friend class Shape)
         Indexer(void) = default;
 
+        /**
+         * @brief Sets up the storage for count dimensions
+         * @param count Number of dimensions (> 0)
+         * @param track_offset Whether room for mem_stride is needed
+         * @return True if successful, false otherwise
+         * @note Only called on a fresh Indexer (by Shape)
+         */
+        bool reserve(size_t count, bool track_offset)
+        {
+            const size_t items = (track_offset ? 3 : 2) * count;
+            size_t * block = this->inline_storage;
+            if (count > SHAPE_INLINE_RANK)
+            {
+                this->storage = (size_t*)malloc(items * sizeof(size_t));
+                if (!this->storage)
+                    return false;
+                block = this->storage;
+            }
+            this->shape = block;
+            this->current_idx = block + count;
+            this->mem_stride = track_offset ? (block + 2 * count) : nullptr;
+            return true;
+        }
+        /**
+         * @brief Takes the states of other (other is left empty)
+         * @note Inline states are copied, heap block is taken over
+         */
+        void take(Indexer & other)
+        {
+            this->dim_count = other.dim_count;
+            this->step = other.step;
+            this->max_step = other.max_step;
+            this->stride = other.stride;
+            this->offset = other.offset;
+            this->storage = other.storage;
+            if (other.shape && !other.storage)
+            {
+                // copy the inline block and point to our own copy
+                const size_t items = (other.mem_stride ? 3 : 2) * other.dim_count;
+                for (size_t i = 0; i < items; ++i)
+                    this->inline_storage[i] = other.inline_storage[i];
+                this->shape = this->inline_storage;
+                this->current_idx = this->inline_storage + this->dim_count;
+                this->mem_stride = other.mem_stride ? (this->inline_storage + 2 * this->dim_count) : nullptr;
+            }
+            else
+            {
+                this->shape = other.shape;
+                this->current_idx = other.current_idx;
+                this->mem_stride = other.mem_stride;
+            }
+            // reset the other object to prevent double free
+            other.dim_count = 0;
+            other.shape = nullptr;
+            other.current_idx = nullptr;
+            other.step = 0;
+            other.max_step = 0;
+            other.stride = 1;
+            other.mem_stride = nullptr;
+            other.offset = 0;
+            other.storage = nullptr;
+            return;
+        }
+
     public:
         // destructor
         ~Indexer(void)
         {
-            // de-allocate memory for shape and current_idx
-            free(this->shape);
-            free(this->current_idx);
+            // de-allocate the heap block (if any)
+            free(this->storage);
             return;
         }
         // copy is not allowed since this is a stateful generator
         Indexer(const Indexer & other) = delete;
         // move constructor
         Indexer(Indexer && other)
-            :   dim_count(other.dim_count),
-                shape(other.shape),
-                current_idx(other.current_idx),
-                step(other.step),
-                max_step(other.max_step),
-                stride(other.stride)
         {
-            // reset the other object to prevent double free
-            other.dim_count = 0;
-            other.shape = nullptr;
-            other.current_idx = nullptr;
-            other.step = 0;
-            other.max_step = 0;
+            this->take(other);
             return;
         }
 
@@ -94,22 +166,9 @@ namespace TENSOR_UTILITIES
             if (this != &other)
             {
                 // de-allocate current resources
-                free(this->shape);
-                free(this->current_idx);
+                free(this->storage);
                 // move resources from other
-                this->dim_count = other.dim_count;
-                this->shape = other.shape;
-                this->current_idx = other.current_idx;
-                this->step = other.step;
-                this->max_step = other.max_step;
-                this->stride = other.stride;
-                // reset the other object to prevent double free
-                other.dim_count = 0;
-                other.shape = nullptr;
-                other.current_idx = nullptr;
-                other.step = 0;
-                other.max_step = 0;
-                other.stride = 1;
+                this->take(other);
             }
             return *this;
         }
@@ -139,9 +198,56 @@ namespace TENSOR_UTILITIES
         {
             return this->stride;
         }
+        /**
+         * @brief Checks if the Indexer tracks the flattened (memory) offset
+         * @return True if generated with offset tracking, false otherwise.
+         */
+        bool tracks_offset(void) const
+        {
+            return (this->mem_stride != nullptr);
+        }
+        /**
+         * @brief Gets the flattened (memory) offset of the current indexing.
+         * @return The offset if tracking, 0 otherwise.
+         * @note O(1), the offset is updated in next() and reset()
+         */
+        size_t get_offset(void) const
+        {
+            return this->offset;
+        }
 
     // Setter function
     public:
+        /**
+         * @brief Jumps to an arbitrary step (random access).
+         * @param step The step to jump to (0-indexed).
+         * @return True if successful, false if step is out of range
+         *         (the state is untouched then).
+         * @note O(ndim), the tracked offset (if any) is recalculated.
+         *       Use this to start iterating in the middle, i.e. when
+         *       each worker thread walks its own slice of a shape.
+         */
+        bool set_step(size_t step)
+        {
+            // step has to be in range
+            if (step >= this->max_step)
+                return false;
+            // split step into the multi-dimensional index
+            // (last dimension changes the fastest)
+            size_t remaining = step;
+            this->offset = 0;
+            for (size_t i = this->dim_count; i > 0; --i)
+            {
+                size_t dim_idx = i - 1;
+                this->current_idx[dim_idx] = remaining % this->shape[dim_idx];
+                remaining /= this->shape[dim_idx];
+                if (this->mem_stride)
+                    this->offset += this->current_idx[dim_idx] * this->mem_stride[dim_idx];
+            }
+            // set step
+            this->step = step;
+            return true;
+        }
         /**
          * @brief Sets the stride for the indexing.
          * @param stride The stride to set.
@@ -188,15 +294,25 @@ namespace TENSOR_UTILITIES
                 // we do this since size_t is unsigned
                 {
                     size_t dim_idx = i - 1;
+                    // keep the old index for offset tracking
+                    size_t old_idx = this->current_idx[dim_idx];
                     this->current_idx[dim_idx] += to_move;
                     if (this->current_idx[dim_idx] < this->shape[dim_idx])
-                        // no carry over needed, break
+                    {
+                        // no carry over needed, update offset and break
+                        if (this->mem_stride)
+                            this->offset += to_move * this->mem_stride[dim_idx];
                         break;
+                    }
                     else
                     {
                         // carry over needed, calculate the carry and update current dimension
                         size_t carry = this->current_idx[dim_idx] / this->shape[dim_idx];
                         this->current_idx[dim_idx] = this->current_idx[dim_idx] % this->shape[dim_idx];
+                        // update offset (the index may decrease, we rely on
+                        // unsigned wrap-around, the final offset is correct)
+                        if (this->mem_stride)
+                            this->offset += (this->current_idx[dim_idx] - old_idx) * this->mem_stride[dim_idx];
                         // add the carry to the next dimension in the next iteration
                         to_move = carry;
                     }
@@ -224,15 +340,22 @@ namespace TENSOR_UTILITIES
                     if (this->current_idx[dim_idx] >= to_move)
                     // use comparison since size_t is unsigned
                     {
-                        // no borrow needed, just subtract and break
+                        // no borrow needed, just subtract, update offset and break
                         this->current_idx[dim_idx] -= to_move;
+                        if (this->mem_stride)
+                            this->offset -= to_move * this->mem_stride[dim_idx];
                         break;
                     }
                     else
                     {
+                        // keep the old index for offset tracking
+                        size_t old_idx = this->current_idx[dim_idx];
                         // borrow needed, calculate the borrow and update current dimension
                         size_t borrow = (to_move - this->current_idx[dim_idx] + this->shape[dim_idx] - 1) / this->shape[dim_idx];
                         this->current_idx[dim_idx] = (this->current_idx[dim_idx] + borrow * this->shape[dim_idx]) - to_move;
+                        // update offset (relies on unsigned wrap-around)
+                        if (this->mem_stride)
+                            this->offset += (this->current_idx[dim_idx] - old_idx) * this->mem_stride[dim_idx];
                         // add the borrow to the next dimension in the next iteration
                         to_move = borrow;
                     }
@@ -259,8 +382,9 @@ namespace TENSOR_UTILITIES
             // reset current_idx to all zeros
             for (size_t i = 0; i < this->dim_count; ++i)
                 this->current_idx[i] = 0;
-            // reset step to zero
+            // reset step and offset to zero
             this->step = 0;
+            this->offset = 0;
             return;
         }
         /**
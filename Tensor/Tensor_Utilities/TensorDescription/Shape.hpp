@@ -12,7 +12,7 @@
 #include <cstddef>  // defines: size_t
 #include <utility>  // std::move()
 #include <cstdlib>  // malloc(); free()
-#include "../Memory/MemoryContainer.hpp"
+#include "DimArray.hpp"
 #include "Indexer.hpp"
 
 namespace TENSOR_UTILITIES
@@ -20,6 +20,10 @@ namespace TENSOR_UTILITIES
     // predefine broadcast result structure
     // (for friend function return type) - prototype only
     struct Broadcast_result;
+    // predefine shape class and coalescing utility
+    // (for calls made inside the class) - prototype only
+    class Shape;
+    bool coalesce_shapes(Shape ** shapes, size_t shapes_count);
 
 
     // class shape (shape manager)
@@ -27,9 +31,20 @@ namespace TENSOR_UTILITIES
     {
     private:
         // shape info
-        MemoryContainer<size_t> m_shape { };
+        // (stored inline up to SHAPE_INLINE_RANK dimensions, see DimArray.hpp)
+        DimArray m_shape { };
         // stride info (this deals with transpose and read sequence)
-        MemoryContainer<size_t> m_stride { };
+        DimArray m_stride { };
+
+        // cached layout info (kept in sync by every mutator, see refresh())
+        // stride of each dimension in the non-permuted layout
+        DimArray m_logical_stride { };
+        // total item count
+        size_t m_item_count {0};
+        // strides match the non-permuted layout (see is_contiguous())
+        bool m_contiguous {true};
+        // items are packed in logical order (see is_flat())
+        bool m_flat {true};
 
     public:
         // constructors and destructor
@@ -37,25 +52,209 @@ namespace TENSOR_UTILITIES
         Shape (const Shape & other) = default;
         Shape (Shape && other)
             :   m_shape(std::move(other.m_shape)),
-                m_stride(std::move(other.m_stride))
-            { return; }
+                m_stride(std::move(other.m_stride)),
+                m_logical_stride(std::move(other.m_logical_stride)),
+                m_item_count(other.m_item_count),
+                m_contiguous(other.m_contiguous),
+                m_flat(other.m_flat)
+        {
+            // other is empty now
+            other.m_item_count = 0;
+            other.m_contiguous = true;
+            other.m_flat = true;
+            return;
+        }
         
         ~Shape (void) = default;
 
         // copy and move assignment
         const Shape & operator= (const Shape & other)
         {
-            copy_assign(this->m_shape, other.m_shape);
-            copy_assign(this->m_stride, other.m_stride);
+            this->m_shape = other.m_shape;
+            this->m_stride = other.m_stride;
+            this->m_logical_stride = other.m_logical_stride;
+            this->m_item_count = other.m_item_count;
+            this->m_contiguous = other.m_contiguous;
+            this->m_flat = other.m_flat;
             return (*this);
         }
         const Shape & operator= (Shape && other)
         {
-            move_assign(this->m_shape, std::move(other.m_shape));
-            move_assign(this->m_stride, std::move(other.m_stride));
+            if (this == &other)
+                return (*this);
+            this->m_shape = std::move(other.m_shape);
+            this->m_stride = std::move(other.m_stride);
+            this->m_logical_stride = std::move(other.m_logical_stride);
+            this->m_item_count = other.m_item_count;
+            this->m_contiguous = other.m_contiguous;
+            this->m_flat = other.m_flat;
+            // other is empty now
+            other.m_item_count = 0;
+            other.m_contiguous = true;
+            other.m_flat = true;
             return (*this);
         }
 
+    private:
+        /**
+         * @brief Re-calculates the cached layout info (item count,
+         *        logical strides, contiguity and flatness) in one pass
+         * @return True if successful, false otherwise.
+         * @note Every function that changes m_shape or m_stride has to
+         *       call this before returning, so the getters are O(1).
+         */
+        bool refresh (void)
+        {
+            // get the number of dimensions (count)
+            const size_t count = this->m_shape.get_effective_item_count();
+
+            // empty shape: no item, contiguous and flat
+            if (count == 0)
+            {
+                this->m_logical_stride.erase();
+                this->m_item_count = 0;
+                this->m_contiguous = true;
+                this->m_flat = true;
+                return true;
+            }
+
+            // allocate logical stride info
+            if (!this->m_logical_stride.allocate(count))
+                return false;
+            this->m_logical_stride.set_effective_size(count);
+
+            // walk from the last dimension
+            // (a missing stride record is never contiguous)
+            const bool has_stride = (this->m_stride.get_effective_item_count() == count);
+            const size_t * shape_ptr = this->m_shape.data();
+            const size_t * stride_ptr = this->m_stride.data();
+            size_t * logical_ptr = this->m_logical_stride.data();
+            bool contiguous = has_stride;
+            bool flat = has_stride;
+            size_t stride = 1;
+            for (size_t i = count; i > 0; --i)
+            {
+                logical_ptr[i - 1] = stride;
+                if (has_stride && stride_ptr[i - 1] != stride)
+                {
+                    contiguous = false;
+                    // size 1 dimension does not affect the memory layout
+                    if (shape_ptr[i - 1] != 1)
+                        flat = false;
+                }
+                stride *= shape_ptr[i - 1];
+            }
+
+            // set cache
+            this->m_item_count = stride;
+            this->m_contiguous = contiguous;
+            this->m_flat = flat;
+            return true;
+        }
+        /**
+         * @brief Calculates total item count from the shape info
+         * @note O(ndim), only used to cross-check the cache (verify_cache())
+         */
+        size_t count_items (void) const
+        {
+            // get the number of dimensions (count)
+            const size_t count = this->m_shape.get_effective_item_count();
+
+            // if it's empty, return 0
+            if (count == 0)
+                return 0;
+
+            // loop calculate the total item count
+            const size_t * shape_ptr = this->m_shape.data();
+            size_t total_count = 1;
+            for (size_t i = 0; i < count; ++i)
+                total_count *= shape_ptr[i];
+
+            // return
+            return total_count;
+        }
+        /**
+         * @brief Checks contiguity from the shape and stride info
+         * @note O(ndim), only used to cross-check the cache (verify_cache())
+         */
+        bool check_contiguous (void) const
+        {
+            // get the number of dimensions (count)
+            const size_t count = this->m_shape.get_effective_item_count();
+
+            // if it's empty, we consider it as contiguous
+            if (count == 0)
+                return true;
+
+            // check the stride of each dimension
+            const size_t * shape_ptr = this->m_shape.data();
+            const size_t * stride_ptr = this->m_stride.data();
+            size_t expected_stride = 1;
+            for (size_t i = count; i > 0; --i)
+            {
+                if (stride_ptr[i - 1] != expected_stride)
+                    return false;
+                expected_stride *= shape_ptr[i - 1];
+            }
+
+            // if all strides are correct, it's contiguous
+            return true;
+        }
+
+        /**
+         * @brief Calculates the contiguous run from the shape and stride info
+         * @note O(ndim), see get_contiguous_run()
+         */
+        size_t check_run (void) const
+        {
+            // get the number of dimensions (count)
+            const size_t count = this->m_shape.get_effective_item_count();
+
+            // walk from the last dimension while strides stay packed
+            const size_t * shape_ptr = this->m_shape.data();
+            const size_t * stride_ptr = this->m_stride.data();
+            size_t run = 1;
+            for (size_t i = count; i > 0; --i)
+            {
+                // size 1 dimension does not break the run
+                if (shape_ptr[i - 1] == 1)
+                    continue;
+                // the stride has to be exactly the items we have covered
+                if (stride_ptr[i - 1] != run)
+                    break;
+                run *= shape_ptr[i - 1];
+            }
+
+            // return
+            return run;
+        }
+
+    public:
+        /**
+         * @brief Cross-checks the cached layout info against a full
+         *        re-calculation (debug helper)
+         * @return True if the cache is consistent, false otherwise.
+         * @note O(ndim), never needed in normal use.
+         */
+        bool verify_cache (void) const
+        {
+            const size_t count = this->m_shape.get_effective_item_count();
+            if (this->m_item_count != this->count_items() ||
+                this->m_contiguous != this->check_contiguous() ||
+                this->m_flat != (!count || this->check_run() == this->m_item_count) ||
+                this->m_logical_stride.get_effective_item_count() != count)
+                return false;
+            // logical strides
+            size_t stride = 1;
+            for (size_t i = count; i > 0; --i)
+            {
+                if (this->m_logical_stride[i - 1] != stride)
+                    return false;
+                stride *= this->m_shape[i - 1];
+            }
+            return true;
+        }
+
         // public functions API
         /**
          * @brief Reset permutation to original (non-permuted) state.
@@ -76,16 +275,17 @@ namespace TENSOR_UTILITIES
             this->m_stride.set_effective_size(count);
 
             // re-calculate stride info based on the current shape info
+            const size_t * shape_ptr = this->m_shape.data();
+            size_t * stride_ptr = this->m_stride.data();
             size_t stride = 1;
             for (size_t i = count; i > 0; --i)
             {
-                this->m_stride.set(i - 1, &stride);
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i - 1);
-                stride *= *shape_ptr;
+                stride_ptr[i - 1] = stride;
+                stride *= shape_ptr[i - 1];
             }
 
-            // return
-            return true;
+            // refresh cached layout info
+            return this->refresh();
         }
         /**
          * @brief Sets the shape info (using a provided array and count)
@@ -98,13 +298,17 @@ namespace TENSOR_UTILITIES
             // set shape info
             if (!this->m_shape.allocate(count))
                 return false;
+            size_t * dst_ptr = this->m_shape.data();
             for (size_t i = 0; i < count; ++i)
             {
                 if (shape_ptr[i])
-                    this->m_shape.set(i, &shape_ptr[i]);
+                    dst_ptr[i] = shape_ptr[i];
                 else
+                {
                     // dimension = 0 is not allowed
+                    this->refresh();
                     return false;
+                }
             }
             // set effective size (in count of items)
             this->m_shape.set_effective_size(count);
@@ -132,64 +336,50 @@ namespace TENSOR_UTILITIES
          */
         size_t get_shape (size_t dim) const
         {
-            const size_t * shape_ptr = (const size_t*)this->m_shape.get(dim);
-            return shape_ptr ? *shape_ptr : 0;
+            if (dim >= this->m_shape.get_effective_item_count())
+                return 0;
+            return this->m_shape[dim];
         }
         /**
          * @brief Get stride of a specified dimension.
          * @param dim The dimension to get the stride (0-indexed).
          * @return The stride of the specified dimension if successful,
          *         0 otherwise.
-         * @note we always recalculate the stride info based on the current
-         *       shape. -> O(n) complexity
+         * @note This is the stride of the current shape in its non-permuted
+         *       layout (cached, O(1)), not the stride recorded for memory.
          *       this function is meant to assist slicing, so we have to
          *       return based on the current shape
          */
         size_t get_stride (size_t dim) const
         {
-            // get the number of dimensions (count)
-            const size_t count = this->m_shape.get_effective_item_count();
-
             // if dim is out of range, return 0
-            if (dim >= count)
+            if (dim >= this->m_logical_stride.get_effective_item_count())
                 return 0;
-
-            // loop calculate the stride
-            size_t stride = 1;
-            for (size_t i = count; i > 0; --i)
-            {
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i - 1);
-                if (i - 1 == dim)
-                    return stride;
-                stride *= *shape_ptr;
-            }
-
-            // we should never reach here, but we return 0 just in case
-            return 0;
+            return this->m_logical_stride[dim];
+        }
+        /**
+         * @brief Get memory stride of a specified dimension.
+         * @param dim The dimension to get the stride (0-indexed).
+         * @return The stored (permuted) stride of the specified dimension
+         *         if successful, 0 otherwise.
+         * @note Unlike get_stride(), this is the stride recorded for the
+         *       memory layout, i.e. how many items to jump in the buffer
+         *       when the index of this dimension increases by 1.
+         */
+        size_t get_memory_stride (size_t dim) const
+        {
+            if (dim >= this->m_stride.get_effective_item_count())
+                return 0;
+            return this->m_stride[dim];
         }
         /**
          * @brief Get total item count of the shape
          * @return The total item count (product of all dimensions)
+         * @note Cached, O(1)
          */
         size_t get_item_count (void) const
         {
-            // get the number of dimensions (count)
-            const size_t count = this->m_shape.get_effective_item_count();
-
-            // if it's empty, return 0
-            if (count == 0)
-                return 0;
-
-            // loop calculate the total item count
-            size_t total_count = 1;
-            for (size_t i = 0; i < count; ++i)
-            {
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i);
-                total_count *= *shape_ptr;
-            }
-
-            // return
-            return total_count;
+            return this->m_item_count;
         }
         /**
          * @brief Permutes the shape (updates the shape and stride info accordingly).
@@ -207,14 +397,17 @@ namespace TENSOR_UTILITIES
             const size_t count = this->m_shape.get_effective_item_count();
 
             // We create a new shape and stride instead of inplace modification
-            MemoryContainer<size_t> new_shape { };
-            MemoryContainer<size_t> new_stride { };
+            // (no allocation up to SHAPE_INLINE_RANK dimensions)
+            DimArray new_shape { };
+            DimArray new_stride { };
             // allocate memory for new shape and stride
             if (!new_shape.allocate(count) || !new_stride.allocate(count))
                 return false;
             // Get pointers
-            size_t * new_shape_ptr = (size_t*)new_shape.get(count - 1);
-            size_t * new_stride_ptr = (size_t*)new_stride.get(count - 1);
+            const size_t * old_shape = this->m_shape.data();
+            const size_t * old_stride = this->m_stride.data();
+            size_t * new_shape_ptr = new_shape.data() + (count - 1);
+            size_t * new_stride_ptr = new_stride.data() + (count - 1);
             // fill new shape and stride based on the permutation
             // fill it in reversed order to make sure the stride calculation is correct
             for (size_t i = count; i > 0; --i)
@@ -224,8 +417,8 @@ namespace TENSOR_UTILITIES
                 if (permuted_idx >= count)
                     return false;
                 // get old shape and stride based on the permuted index
-                const size_t * old_shape_ptr = (const size_t*)this->m_shape.get(permuted_idx);
-                const size_t * old_stride_ptr = (const size_t*)this->m_stride.get(permuted_idx);
+                const size_t * old_shape_ptr = old_shape + permuted_idx;
+                const size_t * old_stride_ptr = old_stride + permuted_idx;
                 // set new shape and stride
                 // if shape is 1, we update its stride to its right neighbour's stride (if it exists),
                 // otherwise 1 [just to make my design consistent]
@@ -249,11 +442,11 @@ namespace TENSOR_UTILITIES
             new_stride.set_effective_size(count);
 
             // move new shape and stride to current shape and stride
-            move_assign(this->m_shape, std::move(new_shape));
-            move_assign(this->m_stride, std::move(new_stride));
+            this->m_shape = std::move(new_shape);
+            this->m_stride = std::move(new_stride);
 
-            // return
-            return true;
+            // refresh cached layout info
+            return this->refresh();
         }
         /**
          * @brief Get the flattened index from a multi-dimensional index
@@ -271,12 +464,13 @@ namespace TENSOR_UTILITIES
             const size_t count = this->m_shape.get_effective_item_count();
 
             // calculate the flattened index
+            const size_t * shape_data = this->m_shape.data();
+            const size_t * stride_data = this->m_stride.data();
             size_t flattened_idx = 0;
             for (size_t i = 0; i < count; ++i)
             {
-                // remember, we use the const version of the getter function
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i);
-                const size_t * stride_ptr = (const size_t*)this->m_stride.get(i);
+                const size_t * shape_ptr = shape_data + i;
+                const size_t * stride_ptr = stride_data + i;
                 // check if the multi-dimensional index is in valid range
                 if (multi_idx_ptr[i] >= *shape_ptr)
                 {
@@ -303,30 +497,183 @@ namespace TENSOR_UTILITIES
          * @note A shape is contiguous if the stride of each dimension is equal to the product of the shapes of the subsequent dimensions.
          *       For example, for a shape (2, 3, 4), the strides should be (12, 4, 1) for it to be contiguous.
          *       If the shape is not contiguous, it means that the data is not stored in a contiguous block of memory in the order defined by the shape.
+         * @note Cached, O(1)
          */
         bool is_contiguous (void) const
+        {
+            return this->m_contiguous;
+        }
+        /**
+         * @brief Check if the shape is trivially flat
+         *        (items are packed back-to-back in logical order)
+         * @return True if flat, false otherwise
+         * @note Same as is_contiguous() but the strides of dimensions with
+         *       size 1 are ignored (they never affect the memory layout),
+         *       i.e. get_contiguous_run() == get_item_count().
+         *       A flat shape can reset_permutation() without moving data.
+         * @note Cached, O(1)
+         * @example shape (2, 1, 3) with stride (3, 1, 1) is flat but not contiguous
+         */
+        bool is_flat (void) const
+        {
+            return this->m_flat;
+        }
+        /**
+         * @brief Gets the length of the contiguous run
+         *        (number of trailing items that are laid out
+         *        back-to-back in memory)
+         * @return The run length in count of items, 0 for an empty shape
+         * @note The run always divides the total item count, so an Indexer
+         *       with its stride set to the run length visits the first
+         *       item of every run.
+         * @note Dimensions with size 1 are skipped, their strides do not
+         *       affect the memory layout.
+         * @example shape (2, 3, 4) with stride (4, 8, 1) -> run is 4
+         *          shape (2, 3, 4) with stride (12, 4, 1) -> run is 24
+         *          shape (4, 2) with stride (1, 4) -> run is 1
+         */
+        size_t get_contiguous_run (void) const
         {
             // get the number of dimensions (count)
             const size_t count = this->m_shape.get_effective_item_count();
 
-            // if it's empty, we consider it as contiguous
+            // if it's empty, there is no run
             if (count == 0)
-                return true;
+                return 0;
+            // flat shape is a single run
+            if (this->m_flat)
+                return this->m_item_count;
 
-            // check the stride of each dimension
-            size_t expected_stride = 1;
+            // walk the strides
+            return this->check_run();
+        }
+        /**
+         * @brief Checks if the memory layout is a batch of transposed matrices
+         *        (i.e. the last two dimensions of a contiguous shape got swapped)
+         * @param batch [OUT] number of matrices
+         * @param rows [OUT] number of rows of each matrix in memory
+         * @param cols [OUT] number of columns of each matrix in memory
+         * @return True if the layout reduces to a batched transpose, false otherwise
+         *         (outputs are only written when returning true)
+         * @note Dimensions with size 1 are ignored.
+         * @example shape (3, 4, 5) with stride (20, 1, 4) is a batch of 3 matrices
+         *          with 5 rows and 4 columns in memory, reading it in the order of
+         *          the shape transposes each of them.
+         */
+        bool get_batched_transpose (size_t & batch, size_t & rows, size_t & cols) const
+        {
+            // get the number of dimensions (count)
+            const size_t count = this->m_shape.get_effective_item_count();
+
+            // find the last two dimensions with size > 1
+            // (we store them 1 larger, so 0 means 'not found')
+            const size_t * shape_data = this->m_shape.data();
+            const size_t * stride_data = this->m_stride.data();
+            size_t inner = 0;
+            size_t outer = 0;
             for (size_t i = count; i > 0; --i)
             {
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i - 1);
-                const size_t * stride_ptr = (const size_t*)this->m_stride.get(i - 1);
+                if (shape_data[i - 1] == 1)
+                    continue;
+                if (!inner)
+                    inner = i;
+                else
+                {
+                    outer = i;
+                    break;
+                }
+            }
+            // we need two dimensions to transpose
+            if (!outer)
+                return false;
+
+            // the (outer) dimension walks along memory rows
+            // the (inner) dimension jumps across memory rows
+            const size_t outer_shape = shape_data[outer - 1];
+            const size_t inner_shape = shape_data[inner - 1];
+            if (stride_data[outer - 1] != 1 ||
+                stride_data[inner - 1] != outer_shape)
+                return false;
+
+            // every leading dimension has to be packed on top of the matrices
+            size_t expected_stride = outer_shape * inner_shape;
+            for (size_t i = outer - 1; i > 0; --i)
+            {
+                const size_t * shape_ptr = shape_data + (i - 1);
+                const size_t * stride_ptr = stride_data + (i - 1);
+                if (*shape_ptr == 1)
+                    continue;
                 if (*stride_ptr != expected_stride)
                     return false;
                 expected_stride *= *shape_ptr;
             }
 
-            // if all strides are correct, it's contiguous
+            // set outputs
+            batch = expected_stride / (outer_shape * inner_shape);
+            rows = inner_shape;
+            cols = outer_shape;
+            return true;
+        }
+        /**
+         * @brief Splits the logical index space into balanced parts
+         * @param part Index of the part to get (0-indexed)
+         * @param part_count Total number of parts
+         * @param granularity Parts start and end on multiples of this
+         *        (in count of items, should divide the item count),
+         *        i.e. the run length, so no run is split across parts
+         * @param start [OUT] first step of the part
+         * @param end [OUT] one past the last step of the part
+         * @return True if successful, false otherwise
+         *         (outputs are only written when returning true)
+         * @note Parts differ by at most one granule, a part may be empty
+         *       when there are fewer granules than parts.
+         *       Use Indexer::set_step(start) to start iterating a part.
+         */
+        bool partition (size_t part, size_t part_count, size_t granularity,
+                        size_t & start, size_t & end) const
+        {
+            // get total item count
+            const size_t item_count = this->get_item_count();
+            // check arguments
+            if (part >= part_count || granularity == 0 ||
+                item_count % granularity)
+                return false;
+            // split granules (the first parts take one extra if uneven)
+            const size_t granules = item_count / granularity;
+            const size_t per_part = granules / part_count;
+            const size_t remainder = granules % part_count;
+            const size_t first = part * per_part + ((part < remainder) ? part : remainder);
+            const size_t length = per_part + ((part < remainder) ? 1 : 0);
+            // set outputs
+            start = first * granularity;
+            end = (first + length) * granularity;
             return true;
         }
+        /**
+         * @brief Coalesced (smallest equivalent) shape
+         *        merges adjacent dimensions that are packed in memory
+         *        and drops dimensions with size 1
+         * @return The coalesced shape, an empty shape if failed (or if
+         *         this shape is empty)
+         * @note Visiting the coalesced shape in order visits exactly the
+         *       same memory offsets (in the same order) as this shape.
+         *       Use it to iterate with fewer dimensions (fewer carries
+         *       and multiplications), not for indexing with the original
+         *       multi-dimensional index.
+         * @example shape (N, 1, C, 1) with stride (C, C, 1, 1) -> (N * C) with stride (1)
+         *          shape (2, 3, 4) with stride (1, 8, 2) -> (2, 12) with stride (1, 2)
+         *          shape (2, 3, 4) with stride (4, 8, 1) -> nothing merges
+         * @see coalesce_shapes() to coalesce several operands together
+         */
+        Shape coalesced (void) const
+        {
+            // copy and coalesce in-place
+            Shape result = *this;
+            Shape * operands[] = { &result };
+            if (!coalesce_shapes(operands, 1))
+                return Shape { };
+            return result;
+        }
         /**
          * @brief Viewable check
          *        checks if we can view the current shape as a new shape
@@ -535,7 +882,12 @@ namespace TENSOR_UTILITIES
             // If we landed here we should either hit tgt_i == 0 or src_i == 0
             // if we have assigned all target dimensions (tgt_i == 0), we are successful
             if (tgt_i == 0)
+            {
+                // refresh cached layout info
+                if (!result.refresh())
+                    return Shape { };
                 return result;
+            }
             else
                 // if we have walked through all source dimensions (src_i == 0) but still
                 // have target dimensions left, we fail (actually we should never be here,
@@ -555,23 +907,24 @@ namespace TENSOR_UTILITIES
             const size_t count = this->m_shape.get_effective_item_count();
 
             // we create new shape and stride instead of inplace modification
-            MemoryContainer<size_t> new_shape { };
-            MemoryContainer<size_t> new_stride { };
+            // (no allocation up to SHAPE_INLINE_RANK dimensions)
+            DimArray new_shape { };
+            DimArray new_stride { };
             // allocate memory for new shape and stride (worst case, no dimension is squeezed)
             if (!new_shape.allocate(count) || !new_stride.allocate(count))
                 return false;
             
             // fill new shape and stride by squeezing dimensions with size 1
+            const size_t * shape_data = this->m_shape.data();
+            const size_t * stride_data = this->m_stride.data();
             size_t new_idx = 0;
             for (size_t i = 0; i < count; ++i)
             {
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i);
-                const size_t * stride_ptr = (const size_t*)this->m_stride.get(i);
-                if (*shape_ptr != 1)
+                if (shape_data[i] != 1)
                 {
                     // this dimension is not squeezed, copy it to the new shape and stride
-                    new_shape.set(new_idx, shape_ptr);
-                    new_stride.set(new_idx, stride_ptr);
+                    new_shape[new_idx] = shape_data[i];
+                    new_stride[new_idx] = stride_data[i];
                     ++new_idx;
                 }
                 // if *shape_ptr == 1, this dimension is squeezed, we skip it
@@ -582,11 +935,11 @@ namespace TENSOR_UTILITIES
             new_stride.set_effective_size(new_idx);
 
             // move new shape and stride to current shape and stride
-            move_assign(this->m_shape, std::move(new_shape));
-            move_assign(this->m_stride, std::move(new_stride));
+            this->m_shape = std::move(new_shape);
+            this->m_stride = std::move(new_stride);
 
-            // return
-            return true;
+            // refresh cached layout info
+            return this->refresh();
         }
         /**
          * @brief Squeezes the shape by removing dimensions with size 1.
@@ -606,8 +959,9 @@ namespace TENSOR_UTILITIES
                 return false;
 
             // we create new shape and stride instead of inplace modification
-            MemoryContainer<size_t> new_shape { };
-            MemoryContainer<size_t> new_stride { };
+            // (no allocation up to SHAPE_INLINE_RANK dimensions)
+            DimArray new_shape { };
+            DimArray new_stride { };
             // allocate memory for new shape and stride
             // (worst case, no dimension is squeezed)
             // still use the original count
@@ -619,8 +973,8 @@ namespace TENSOR_UTILITIES
             size_t dim_idx = 0;  // index for the dims array
             for (size_t i = 0; i < count; ++i)
             {
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(i);
-                const size_t * stride_ptr = (const size_t*)this->m_stride.get(i);
+                const size_t * shape_ptr = this->m_shape.data() + i;
+                const size_t * stride_ptr = this->m_stride.data() + i;
                 if (i == *(dims + dim_idx))
                 {
                     if (*shape_ptr != 1)
@@ -634,8 +988,8 @@ namespace TENSOR_UTILITIES
                 else
                 {
                     // this dimension is not squeezed, copy it to the new shape and stride
-                    new_shape.set(new_idx, shape_ptr);
-                    new_stride.set(new_idx, stride_ptr);
+                    new_shape[new_idx] = *shape_ptr;
+                    new_stride[new_idx] = *stride_ptr;
                     ++new_idx;
                 }
             }
@@ -650,11 +1004,11 @@ namespace TENSOR_UTILITIES
             new_stride.set_effective_size(new_idx);
 
             // move new shape and stride to current shape and stride
-            move_assign(this->m_shape, std::move(new_shape));
-            move_assign(this->m_stride, std::move(new_stride));
+            this->m_shape = std::move(new_shape);
+            this->m_stride = std::move(new_stride);
 
-            // return
-            return true;
+            // refresh cached layout info
+            return this->refresh();
         }
         /**
          * @brief Squeezes the shape by removing dimensions with size 1.
@@ -696,14 +1050,14 @@ namespace TENSOR_UTILITIES
                 return false;
 
             // we create new shape and stride instead of inplace modification
-            MemoryContainer<size_t> new_shape { };
-            MemoryContainer<size_t> new_stride { };
+            // (no allocation up to SHAPE_INLINE_RANK dimensions)
+            DimArray new_shape { };
+            DimArray new_stride { };
             // allocate memory for new shape and stride
             if (!new_shape.allocate(count + dims_count) || !new_stride.allocate(count + dims_count))
                 return false;
-            
-            // one for stride 1
-            size_t one = 1;
+            const size_t * shape_data = this->m_shape.data();
+            const size_t * stride_data = this->m_stride.data();
             // fill new shape and stride by unsqueezing the specified dimensions
             size_t new_idx = 0;
             size_t old_idx = 0;  // index for the old shape and stride
@@ -721,12 +1075,12 @@ namespace TENSOR_UTILITIES
                 {
                     // insert a new dimension with size 1 and
                     // the right neighbour's stride
-                    new_shape.set(new_idx, &one);
+                    new_shape[new_idx] = 1;
                     if (old_idx < count)  // have right neighbour
                         // Get right neighbour's stride
-                        new_stride.set(new_idx, this->m_stride.get(old_idx));
+                        new_stride[new_idx] = stride_data[old_idx];
                     else  // already the end
-                        new_stride.set(new_idx, &one);
+                        new_stride[new_idx] = 1;
                     // increment new index
                     ++new_idx;
                     // move to the next dimension in the dims array
@@ -744,10 +1098,8 @@ namespace TENSOR_UTILITIES
                     break;
 
                 // copy the current dimension from the old shape and stride
-                const size_t * shape_ptr = (const size_t*)this->m_shape.get(old_idx);
-                const size_t * stride_ptr = (const size_t*)this->m_stride.get(old_idx);
-                new_shape.set(new_idx, shape_ptr);
-                new_stride.set(new_idx, stride_ptr);
+                new_shape[new_idx] = shape_data[old_idx];
+                new_stride[new_idx] = stride_data[old_idx];
                 // update indices for the next iteration
                 ++new_idx;
                 ++old_idx;
@@ -763,11 +1115,11 @@ namespace TENSOR_UTILITIES
             new_stride.set_effective_size(new_idx);
 
             // move new shape and stride to current shape and stride
-            move_assign(this->m_shape, std::move(new_shape));
-            move_assign(this->m_stride, std::move(new_stride));
+            this->m_shape = std::move(new_shape);
+            this->m_stride = std::move(new_stride);
 
-            // return
-            return true;
+            // refresh cached layout info
+            return this->refresh();
         }
         /**
          * @brief Unsqueezes the shape by inserting a dimension with size 1 at
@@ -794,7 +1146,7 @@ namespace TENSOR_UTILITIES
         void print (void) const
         {
             // get ptr and number of items
-            const size_t * ptr = (const size_t*)this->m_shape.get(0);
+            const size_t * ptr = this->m_shape.data();
             const size_t count = this->m_shape.get_effective_item_count();
 
             // print
@@ -816,7 +1168,7 @@ namespace TENSOR_UTILITIES
         void print_stride (void) const
         {
             // get ptr and number of items
-            const size_t * ptr = (const size_t*)this->m_stride.get(0);
+            const size_t * ptr = this->m_stride.data();
             const size_t count = this->m_stride.get_effective_item_count();
 
             // print
@@ -836,9 +1188,14 @@ namespace TENSOR_UTILITIES
     public:
         /**
          * @brief Generates an Indexer object for the current shape.
+         * @param track_offset Whether the Indexer should also track the
+         *        flattened (memory) offset of this shape. (O(1) lookup in
+         *        get_flattened_index(), instead of O(ndim))
          * @return The generated Indexer object.
+         * @note An offset tracking Indexer should only be used with this
+         *       shape (or shapes with the same strides).
          */
-        Indexer generate_indexer (void) const
+        Indexer generate_indexer (bool track_offset = false) const
         {
             // get the number of dimensions (count)
             const size_t count = this->m_shape.get_effective_item_count();
@@ -847,28 +1204,27 @@ namespace TENSOR_UTILITIES
                 return Indexer { };
             // create an Indexer object
             Indexer indexer { };
-            // allocate memory for the shape and current_idx in the Indexer object
-            indexer.shape = (size_t*)malloc(count * sizeof(size_t));
-            indexer.current_idx = (size_t*)malloc(count * sizeof(size_t));
-            if (!indexer.shape || !indexer.current_idx)
-            {
-                // if memory allocation fails, free any allocated memory and return an empty Indexer
-                free(indexer.shape);
-                free(indexer.current_idx);
+            // set up the storage of the Indexer object
+            // (no allocation up to SHAPE_INLINE_RANK dimensions)
+            if (!indexer.reserve(count, track_offset))
                 return Indexer { };
-            }
-            // copy the shape info to the Indexer object
-            for (size_t i = 0; i < count; ++i)
-                indexer.shape[i] = *(const size_t*)this->m_shape.get(i);
-            // initialize current_idx to all zeros
+            // copy the shape info and initialize current_idx to all zeros
+            const size_t * shape_ptr = this->m_shape.data();
             for (size_t i = 0; i < count; ++i)
+            {
+                indexer.shape[i] = shape_ptr[i];
                 indexer.current_idx[i] = 0;
+            }
             // set the dimension count and max_step for the Indexer object
             indexer.dim_count = count;
             indexer.max_step = this->get_item_count();
-            // initialize current_idx to all zeros
-            for (size_t i = 0; i < count; ++i)
-                indexer.current_idx[i] = 0;
+            // copy the memory strides if we track the offset
+            if (track_offset)
+            {
+                const size_t * stride_ptr = this->m_stride.data();
+                for (size_t i = 0; i < count; ++i)
+                    indexer.mem_stride[i] = stride_ptr[i];
+            }
             // return the generated Indexer object
             return indexer;
         }
@@ -879,10 +1235,15 @@ namespace TENSOR_UTILITIES
          * @return The flattened index if successful, 0 otherwise.
          *         [YOU HAVE TO MAKE SURE THE INDEXER OBJECT IS VALID]
          *         [You can test whether we returned 0 but your index is not all 0]
+         * @note If the Indexer tracks its offset, the tracked offset is returned
+         *       directly (O(1)), allow_broadcasting has no effect then.
          */
         size_t get_flattened_index
         (const Indexer & indexer, bool allow_broadcasting = false) const
         {
+            // offset tracking Indexer already knows the answer
+            if (indexer.tracks_offset())
+                return indexer.get_offset();
             // we simply call the original get_flattened_index function with the current_idx from the Indexer object
             return this->get_flattened_index(indexer.current_idx, allow_broadcasting);
         }
@@ -891,6 +1252,8 @@ namespace TENSOR_UTILITIES
     public:
         // friend function for broadcasting utility
         friend Broadcast_result get_compatible_shapes(const Shape & shape1, const Shape & shape2);
+        // friend function for coalescing utility
+        friend bool coalesce_shapes(Shape ** shapes, size_t shapes_count);
     };
 
 
@@ -955,10 +1318,10 @@ namespace TENSOR_UTILITIES
             // get dimensions
             size_t current_dim_1 = (shape1_done) ? 
                                     1 : 
-                                    *(const size_t *)shape1.m_shape.get(idx1);
+                                    shape1.m_shape[idx1];
             size_t current_dim_2 = (shape2_done) ? 
                                     1 : 
-                                    *(const size_t *)shape2.m_shape.get(idx2);
+                                    shape2.m_shape[idx2];
 
             // check if the current dimensions are compatible
             if (current_dim_1 == current_dim_2 || 
@@ -967,7 +1330,7 @@ namespace TENSOR_UTILITIES
             {
                 // set the compatible dimension to the maximum of the two dimensions
                 size_t compatible_dim = (current_dim_1 > current_dim_2) ? current_dim_1 : current_dim_2;
-                result.compatible_shape.m_shape.set(i - 1, &compatible_dim);
+                result.compatible_shape.m_shape[i - 1] = compatible_dim;
 
                 // update indices and done flags for the next iteration
                 // we first decrease to 0 and process 0
@@ -1024,6 +1387,118 @@ namespace TENSOR_UTILITIES
         return result;
     }
 
+
+    // Coalescing utilities
+    /**
+     * @brief Coalesces several operands together (in-place)
+     *        so that their dimensions stay aligned
+     * @param shapes Array of pointers to the shapes to coalesce
+     * @param shapes_count Number of shapes (length of the array)
+     * @return True if successful, false otherwise
+     *         (shapes are untouched if failed)
+     * @note All shapes should have the same dimension count.
+     *       A dimension is dropped only if it has size 1 in every shape.
+     *       Dimension d is merged into its left neighbour p only if, for
+     *       every shape, the sizes agree with the first shape and
+     *       stride[p] == stride[d] * shape[d]
+     *       (so broadcasted dimensions are never merged away)
+     * @note If every dimension has size 1, we keep a single dimension
+     *       of size 1 (stride 1)
+     */
+    inline bool coalesce_shapes
+    (Shape ** shapes, size_t shapes_count)
+    {
+        // nothing to do
+        if (!shapes_count)
+            return true;
+
+        // all shapes must have the same (non-zero) dimension count
+        const size_t count = shapes[0]->get_dim_count();
+        if (count == 0)
+            return false;
+        for (size_t k = 1; k < shapes_count; ++k)
+            if (shapes[k]->get_dim_count() != count)
+                return false;
+
+        // we compact the dimensions in-place
+        // (output position never passes the input position)
+        size_t out_count = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            // check if dimension i has size 1 in every shape
+            bool all_one = true;
+            for (size_t k = 0; k < shapes_count && all_one; ++k)
+                if (shapes[k]->m_shape[i] != 1)
+                    all_one = false;
+            // drop it
+            if (all_one)
+                continue;
+
+            // check if we can merge dimension i into the last output
+            bool mergeable = (out_count > 0);
+            const size_t ref_prev_shape = mergeable ? shapes[0]->m_shape[out_count - 1] : 0;
+            const size_t ref_shape = shapes[0]->m_shape[i];
+            for (size_t k = 0; k < shapes_count && mergeable; ++k)
+            {
+                const size_t prev_shape = shapes[k]->m_shape[out_count - 1];
+                const size_t prev_stride = shapes[k]->m_stride[out_count - 1];
+                const size_t shape = shapes[k]->m_shape[i];
+                const size_t stride = shapes[k]->m_stride[i];
+                // sizes have to agree (no broadcasting inside a merge)
+                // and the pair has to be packed in memory
+                if (prev_shape != ref_prev_shape || shape != ref_shape ||
+                    prev_stride != stride * shape)
+                    mergeable = false;
+            }
+
+            // merge or keep
+            for (size_t k = 0; k < shapes_count; ++k)
+            {
+                const size_t shape = shapes[k]->m_shape[i];
+                const size_t stride = shapes[k]->m_stride[i];
+                if (mergeable)
+                {
+                    // merged size is the product, stride is the inner one
+                    size_t merged_shape = shapes[k]->m_shape[out_count - 1] * shape;
+                    shapes[k]->m_shape[out_count - 1] = merged_shape;
+                    shapes[k]->m_stride[out_count - 1] = stride;
+                }
+                else
+                {
+                    shapes[k]->m_shape[out_count] = shape;
+                    shapes[k]->m_stride[out_count] = stride;
+                }
+            }
+            if (!mergeable)
+                ++out_count;
+        }
+
+        // every dimension has size 1, keep a single one
+        if (out_count == 0)
+        {
+            const size_t one = 1;
+            for (size_t k = 0; k < shapes_count; ++k)
+            {
+                shapes[k]->m_shape[0] = one;
+                shapes[k]->m_stride[0] = one;
+            }
+            out_count = 1;
+        }
+
+        // set effective size (in count of items)
+        for (size_t k = 0; k < shapes_count; ++k)
+        {
+            shapes[k]->m_shape.set_effective_size(out_count);
+            shapes[k]->m_stride.set_effective_size(out_count);
+            // refresh cached layout info
+            if (!shapes[k]->refresh())
+                return false;
+        }
+
+        // return
+        return true;
+    }
+
 }
 
-#endif
\ No newline at end of file
+#endif
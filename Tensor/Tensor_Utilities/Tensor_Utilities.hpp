@@ -3,7 +3,13 @@
 
 namespace TENSOR_UTILITIES { }
 
+#include "./Parallel/ThreadPool.hpp"
+#include "./Memory/Allocator.hpp"
+#include "./Memory/Telemetry.hpp"
+#include "./Memory/FileMapping.hpp"
+#include "./Memory/Conversion.hpp"
 #include "./Memory/MemoryContainer.hpp"
+#include "./Memory/SegmentedContainer.hpp"
 #include "./TensorDescription/Shape.hpp"
 
 #endif
\ No newline at end of file